@@ -30,269 +30,572 @@
 
 #define  __INCLUDE_FROM_USB_DRIVER
 #define  __INCLUDE_FROM_HID_DRIVER
+#define  __INCLUDE_FROM_HIDPARSER_C
 #include "HIDParser.h"
 
 uint8_t USB_ProcessHIDReport(const uint8_t* ReportData,
                              uint16_t ReportSize,
                              HID_ReportInfo_t* const ParserData)
 {
-	HID_StateTable_t      StateTable[HID_STATETABLE_STACK_DEPTH];
-	HID_StateTable_t*     CurrStateTable          = &StateTable[0];
-	HID_CollectionPath_t* CurrCollectionPath      = NULL;
-	HID_ReportSizeInfo_t* CurrReportIDInfo        = &ParserData->ReportIDSizes[0];
-	uint16_t              UsageList[HID_USAGE_STACK_DEPTH];
-	uint8_t               UsageListSize           = 0;
-	HID_MinMax_t          UsageMinMax             = {0, 0};
+	HID_ParserState_t State;
 
-	memset(ParserData,       0x00, sizeof(HID_ReportInfo_t));
-	memset(CurrStateTable,   0x00, sizeof(HID_StateTable_t));
-	memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
+	USB_BeginHIDReportParse(&State, ParserData);
+	USB_ParseHIDReportChunk(&State, ReportData, ReportSize);
 
-	ParserData->TotalDeviceReports = 1;
+	return USB_EndHIDReportParse(&State);
+}
 
-	while (ReportSize)
-	{
-		uint8_t  HIDReportItem  = *ReportData;
-		uint32_t ReportItemData = 0;
+void USB_BeginHIDReportParse(HID_ParserState_t* const State,
+                             HID_ReportInfo_t* const ParserData)
+{
+	memset(ParserData, 0x00, sizeof(HID_ReportInfo_t));
 
-		ReportData++;
-		ReportSize--;
+	/* The fixed size arrays are parsed into through the view, which is kept in step with the legacy totals */
+	ParserData->View.ReportItems        = ParserData->ReportItems;
+	ParserData->View.MaxReportItems     = HID_MAX_REPORTITEMS;
+	ParserData->View.CollectionPaths    = ParserData->CollectionPaths;
+	ParserData->View.MaxCollectionPaths = HID_MAX_COLLECTIONS;
+	ParserData->View.ReportIDSizes      = ParserData->ReportIDSizes;
+	ParserData->View.MaxDeviceReports   = HID_MAX_REPORT_IDS;
+
+	State->ParserData = ParserData;
+	State->Output     = ParserData->View;
 
-		switch (HIDReportItem & HID_RI_DATA_SIZE_MASK)
+	HID_InitParserState(State);
+	HID_UpdateReportInfo(State);
+}
+
+uint8_t USB_ParseHIDReportChunk(HID_ParserState_t* const State,
+                                const uint8_t* ReportData,
+                                uint16_t ReportSize)
+{
+	while (ReportSize && (State->ErrorCode == HID_PARSE_Successful))
+	{
+		uint32_t ReportItemData;
+		uint8_t  HIDReportItem;
+
+		if (!(State->ItemBufferLength) && (ReportSize > HID_ITEM_DATA_SIZE(*ReportData)))
 		{
-			case HID_RI_DATA_BITS_32:
-				ReportItemData  = le32_to_cpu(*((uint32_t*)ReportData));
-				ReportSize     -= 4;
-				ReportData     += 4;
-				break;
-			case HID_RI_DATA_BITS_16:
-				ReportItemData  = le16_to_cpu(*((uint16_t*)ReportData));
-				ReportSize     -= 2;
-				ReportData     += 2;
-				break;
-			case HID_RI_DATA_BITS_8:
-				ReportItemData  = *((uint8_t*)ReportData);
-				ReportSize     -= 1;
-				ReportData     += 1;
-				break;
+			/* Complete items within the chunk are processed in place */
+			HIDReportItem = HID_FetchReportItem(&ReportData, &ReportSize, &ReportItemData);
 		}
-
-		switch (HIDReportItem & (HID_RI_TYPE_MASK | HID_RI_TAG_MASK))
+		else
 		{
-			case HID_RI_PUSH(0):
-				if (CurrStateTable == &StateTable[HID_STATETABLE_STACK_DEPTH - 1])
-				  return HID_PARSE_HIDStackOverflow;
+			/* Items split across chunks are gathered a byte at a time until complete */
+			State->ItemBuffer[State->ItemBufferLength++] = *(ReportData++);
+			ReportSize--;
 
-				memcpy((CurrStateTable + 1),
-				       CurrStateTable,
-				       sizeof(HID_ReportItem_t));
+			if (State->ItemBufferLength <= HID_ITEM_DATA_SIZE(State->ItemBuffer[0]))
+			  continue;
 
-				CurrStateTable++;
-				break;
-			case HID_RI_POP(0):
-				if (CurrStateTable == &StateTable[0])
-				  return HID_PARSE_HIDStackUnderflow;
+			HIDReportItem = HID_FetchBufferedReportItem(State, &ReportItemData);
+		}
 
-				CurrStateTable--;
-				break;
-			case HID_RI_USAGE_PAGE(0):
-				if ((HIDReportItem & HID_RI_DATA_SIZE_MASK) == HID_RI_DATA_BITS_32)
-				  CurrStateTable->Attributes.Usage.Page = (ReportItemData >> 16);
-				
-				CurrStateTable->Attributes.Usage.Page       = ReportItemData;
-				break;
-			case HID_RI_LOGICAL_MINIMUM(0):
-				CurrStateTable->Attributes.Logical.Minimum  = ReportItemData;
-				break;
-			case HID_RI_LOGICAL_MAXIMUM(0):
-				CurrStateTable->Attributes.Logical.Maximum  = ReportItemData;
-				break;
-			case HID_RI_PHYSICAL_MINIMUM(0):
-				CurrStateTable->Attributes.Physical.Minimum = ReportItemData;
-				break;
-			case HID_RI_PHYSICAL_MAXIMUM(0):
-				CurrStateTable->Attributes.Physical.Maximum = ReportItemData;
-				break;
-			case HID_RI_UNIT_EXPONENT(0):
-				CurrStateTable->Attributes.Unit.Exponent    = ReportItemData;
-				break;
-			case HID_RI_UNIT(0):
-				CurrStateTable->Attributes.Unit.Type        = ReportItemData;
-				break;
-			case HID_RI_REPORT_SIZE(0):
-				CurrStateTable->Attributes.BitSize          = ReportItemData;
-				break;
-			case HID_RI_REPORT_COUNT(0):
-				CurrStateTable->ReportCount                 = ReportItemData;
-				break;
-			case HID_RI_REPORT_ID(0):
-				CurrStateTable->ReportID                    = ReportItemData;
+		State->ErrorCode = HID_ProcessReportItem(State, HIDReportItem, ReportItemData);
+	}
 
-				if (ParserData->UsingReportIDs)
-				{
-					CurrReportIDInfo = NULL;
+	HID_UpdateReportInfo(State);
 
-					for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
-					{
-						if (ParserData->ReportIDSizes[i].ReportID == CurrStateTable->ReportID)
-						{
-							CurrReportIDInfo = &ParserData->ReportIDSizes[i];
-							break;
-						}
-					}
+	return State->ErrorCode;
+}
 
-					if (CurrReportIDInfo == NULL)
-					{
-						if (ParserData->TotalDeviceReports == HID_MAX_REPORT_IDS)
-						  return HID_PARSE_InsufficientReportIDItems;
+uint8_t USB_EndHIDReportParse(HID_ParserState_t* const State)
+{
+	/* A final item truncated by the end of the descriptor is processed with the data available, as in a single pass */
+	if (State->ItemBufferLength && (State->ErrorCode == HID_PARSE_Successful))
+	{
+		uint32_t ReportItemData;
+		uint8_t  HIDReportItem = HID_FetchBufferedReportItem(State, &ReportItemData);
 
-						CurrReportIDInfo = &ParserData->ReportIDSizes[ParserData->TotalDeviceReports++];
-						memset(CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
-					}
-				}
+		State->ErrorCode = HID_ProcessReportItem(State, HIDReportItem, ReportItemData);
+		HID_UpdateReportInfo(State);
+	}
 
-				ParserData->UsingReportIDs = true;
+	if (State->ErrorCode != HID_PARSE_Successful)
+	  return State->ErrorCode;
 
-				CurrReportIDInfo->ReportID = CurrStateTable->ReportID;
-				break;
-			case HID_RI_USAGE(0):
-				if (UsageListSize == HID_USAGE_STACK_DEPTH)
-				  return HID_PARSE_UsageListOverflow;
+	if (!(State->Output.TotalReportItems))
+	  return HID_PARSE_NoUnfilteredReportItems;
 
-				UsageList[UsageListSize++] = ReportItemData;
-				break;
-			case HID_RI_USAGE_MINIMUM(0):
-				UsageMinMax.Minimum = ReportItemData;
-				break;
-			case HID_RI_USAGE_MAXIMUM(0):
-				UsageMinMax.Maximum = ReportItemData;
-				break;
-			case HID_RI_COLLECTION(0):
-				if (CurrCollectionPath == NULL)
+	return HID_PARSE_Successful;
+}
+
+uint8_t USB_ProcessHIDReportArena(const uint8_t* ReportData,
+                                  uint16_t ReportSize,
+                                  void* Arena,
+                                  const uint16_t ArenaSize,
+                                  HID_ArenaReportInfo_t* const ParserData)
+{
+	HID_ParserCounts_t Counts;
+	HID_ParserState_t  State;
+	uint8_t            ErrorCode;
+
+	memset(ParserData, 0x00, sizeof(HID_ArenaReportInfo_t));
+
+	/* First pass, determine the number of each kind of record the descriptor requires */
+	if ((ErrorCode = HID_CountReportDescriptor(ReportData, ReportSize, &Counts)) != HID_PARSE_Successful)
+	  return ErrorCode;
+
+	uintptr_t ArenaStart     = (uintptr_t)Arena;
+	uintptr_t ArenaAligned   = HID_ARENA_ALIGN(ArenaStart);
+	uint16_t  CollectionSize = HID_ARENA_ALIGN(Counts.CollectionPaths * sizeof(HID_CollectionPath_t));
+	uint16_t  ReportIDSize   = HID_ARENA_ALIGN(Counts.DeviceReports * sizeof(HID_ReportSizeInfo_t));
+	uint32_t  RequiredSize   = ((ArenaAligned - ArenaStart) + CollectionSize + ReportIDSize +
+	                            ((uint32_t)Counts.ReportItems * sizeof(HID_ReportItem_t)));
+
+	if (RequiredSize > 0xFFFF)
+	  return HID_PARSE_InsufficientArenaSpace;
+
+	ParserData->ArenaBytesUsed = RequiredSize;
+
+	if (Arena == NULL)
+	  return HID_PARSE_Successful;
+
+	if (RequiredSize > ArenaSize)
+	  return HID_PARSE_InsufficientArenaSpace;
+
+	/* Report items are placed last, so that the space of any items rejected by the filtering callback can be reclaimed */
+	ParserData->CollectionPaths    = (HID_CollectionPath_t*)ArenaAligned;
+	ParserData->MaxCollectionPaths = Counts.CollectionPaths;
+	ParserData->ReportIDSizes      = (HID_ReportSizeInfo_t*)(ArenaAligned + CollectionSize);
+	ParserData->MaxDeviceReports   = Counts.DeviceReports;
+	ParserData->ReportItems        = (HID_ReportItem_t*)(ArenaAligned + CollectionSize + ReportIDSize);
+	ParserData->MaxReportItems     = Counts.ReportItems;
+
+	memset((void*)ArenaAligned, 0x00, (CollectionSize + ReportIDSize));
+
+	/* Second pass, fill in the exactly sized records */
+	State.Output     = *ParserData;
+	State.ParserData = NULL;
+	HID_InitParserState(&State);
+
+	ErrorCode   = HID_ParseReportDescriptor(ReportData, ReportSize, &State);
+	*ParserData = State.Output;
+
+	ParserData->ArenaBytesUsed = (((uintptr_t)ParserData->ReportItems - ArenaStart) +
+	                              (ParserData->TotalReportItems * sizeof(HID_ReportItem_t)));
+
+	return ErrorCode;
+}
+
+static uint8_t HID_ParseReportDescriptor(const uint8_t* ReportData,
+                                         uint16_t ReportSize,
+                                         HID_ParserState_t* const State)
+{
+	uint8_t ErrorCode;
+
+	while (ReportSize)
+	{
+		uint32_t ReportItemData;
+		uint8_t  HIDReportItem = HID_FetchReportItem(&ReportData, &ReportSize, &ReportItemData);
+
+		if ((ErrorCode = HID_ProcessReportItem(State, HIDReportItem, ReportItemData)) != HID_PARSE_Successful)
+		  return ErrorCode;
+	}
+
+	if (!(State->Output.TotalReportItems))
+	  return HID_PARSE_NoUnfilteredReportItems;
+
+	return HID_PARSE_Successful;
+}
+
+static void HID_InitParserState(HID_ParserState_t* const State)
+{
+	memset(&State->StateTable[0], 0x00, sizeof(HID_StateTable_t));
+
+	State->CurrStateTable     = &State->StateTable[0];
+	State->CurrCollectionPath = NULL;
+	State->CurrReportIDInfo   = &State->Output.ReportIDSizes[0];
+	State->UsageListSize      = 0;
+	State->UsageMinMax        = (HID_MinMax_t){0, 0};
+	State->ItemBufferLength   = 0;
+	State->ErrorCode          = HID_PARSE_Successful;
+
+	memset(State->CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
+
+	State->Output.TotalDeviceReports = 1;
+}
+
+static void HID_UpdateReportInfo(HID_ParserState_t* const State)
+{
+	HID_ReportInfo_t* ParserData = State->ParserData;
+
+	if (ParserData == NULL)
+	  return;
+
+	ParserData->View                  = State->Output;
+	ParserData->TotalReportItems      = State->Output.TotalReportItems;
+	ParserData->TotalDeviceReports    = State->Output.TotalDeviceReports;
+	ParserData->LargestReportSizeBits = State->Output.LargestReportSizeBits;
+	ParserData->TotalCollectionPaths  = State->Output.TotalCollectionPaths;
+	ParserData->UsingReportIDs        = State->Output.UsingReportIDs;
+}
+
+static uint8_t HID_FetchBufferedReportItem(HID_ParserState_t* const State,
+                                           uint32_t* const ReportItemData)
+{
+	const uint8_t* ItemData = State->ItemBuffer;
+	uint16_t       ItemSize = State->ItemBufferLength;
+
+	State->ItemBufferLength = 0;
+
+	return HID_FetchReportItem(&ItemData, &ItemSize, ReportItemData);
+}
+
+static uint8_t HID_ProcessReportItem(HID_ParserState_t* const State,
+                                     const uint8_t HIDReportItem,
+                                     uint32_t ReportItemData)
+{
+	HID_ArenaReportInfo_t* ParserData = &State->Output;
+	HID_CollectionPath_t*  ParentCollectionPath;
+
+	switch (HIDReportItem & (HID_RI_TYPE_MASK | HID_RI_TAG_MASK))
+	{
+		case HID_RI_PUSH(0):
+			if (State->CurrStateTable == &State->StateTable[HID_STATETABLE_STACK_DEPTH - 1])
+			  return HID_PARSE_HIDStackOverflow;
+
+			memcpy((State->CurrStateTable + 1),
+			       State->CurrStateTable,
+			       sizeof(HID_StateTable_t));
+
+			State->CurrStateTable++;
+			break;
+		case HID_RI_POP(0):
+			if (State->CurrStateTable == &State->StateTable[0])
+			  return HID_PARSE_HIDStackUnderflow;
+
+			State->CurrStateTable--;
+
+			/* REPORT ID is a global item, so the restored report ID also selects the report sizes being accumulated */
+			for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
+			{
+				if (ParserData->UsingReportIDs && (ParserData->ReportIDSizes[i].ReportID == State->CurrStateTable->ReportID))
 				{
-					CurrCollectionPath = &ParserData->CollectionPaths[0];
+					State->CurrReportIDInfo = &ParserData->ReportIDSizes[i];
+					break;
 				}
-				else
+			}
+
+			break;
+		case HID_RI_USAGE_PAGE(0):
+			if ((HIDReportItem & HID_RI_DATA_SIZE_MASK) == HID_RI_DATA_BITS_32)
+			  State->CurrStateTable->Attributes.Usage.Page = (ReportItemData >> 16);
+			
+			State->CurrStateTable->Attributes.Usage.Page       = ReportItemData;
+			break;
+		case HID_RI_LOGICAL_MINIMUM(0):
+			State->CurrStateTable->Attributes.Logical.Minimum  = HID_SignExtendItemData(HIDReportItem, ReportItemData);
+			break;
+		case HID_RI_LOGICAL_MAXIMUM(0):
+			/* Maximums are only treated as signed when the minimum is negative, as many devices encode unsigned maximums
+			 * such as 255 in the smallest item size regardless of the sign bit */
+			if ((int32_t)State->CurrStateTable->Attributes.Logical.Minimum < 0)
+			  ReportItemData = HID_SignExtendItemData(HIDReportItem, ReportItemData);
+
+			State->CurrStateTable->Attributes.Logical.Maximum  = ReportItemData;
+			break;
+		case HID_RI_PHYSICAL_MINIMUM(0):
+			State->CurrStateTable->Attributes.Physical.Minimum = HID_SignExtendItemData(HIDReportItem, ReportItemData);
+			break;
+		case HID_RI_PHYSICAL_MAXIMUM(0):
+			if ((int32_t)State->CurrStateTable->Attributes.Physical.Minimum < 0)
+			  ReportItemData = HID_SignExtendItemData(HIDReportItem, ReportItemData);
+
+			State->CurrStateTable->Attributes.Physical.Maximum = ReportItemData;
+			break;
+		case HID_RI_UNIT_EXPONENT(0):
+			State->CurrStateTable->Attributes.Unit.Exponent    = ReportItemData;
+			break;
+		case HID_RI_UNIT(0):
+			State->CurrStateTable->Attributes.Unit.Type        = ReportItemData;
+			break;
+		case HID_RI_REPORT_SIZE(0):
+			State->CurrStateTable->Attributes.BitSize          = ReportItemData;
+			break;
+		case HID_RI_REPORT_COUNT(0):
+			State->CurrStateTable->ReportCount                 = ReportItemData;
+			break;
+		case HID_RI_REPORT_ID(0):
+			State->CurrStateTable->ReportID                    = ReportItemData;
+
+			if (ParserData->UsingReportIDs)
+			{
+				State->CurrReportIDInfo = NULL;
+
+				for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
 				{
-					HID_CollectionPath_t* ParentCollectionPath = CurrCollectionPath;
-
-					CurrCollectionPath = &ParserData->CollectionPaths[1];
-
-					while (CurrCollectionPath->Parent != NULL)
+					if (ParserData->ReportIDSizes[i].ReportID == State->CurrStateTable->ReportID)
 					{
-						if (CurrCollectionPath == &ParserData->CollectionPaths[HID_MAX_COLLECTIONS - 1])
-						  return HID_PARSE_InsufficientCollectionPaths;
-
-						CurrCollectionPath++;
+						State->CurrReportIDInfo = &ParserData->ReportIDSizes[i];
+						break;
 					}
-
-					CurrCollectionPath->Parent = ParentCollectionPath;
 				}
 
-				CurrCollectionPath->Type = ReportItemData;
-				CurrCollectionPath->Usage.Page = CurrStateTable->Attributes.Usage.Page;
+				if (State->CurrReportIDInfo == NULL)
+				{
+					if (ParserData->TotalDeviceReports == ParserData->MaxDeviceReports)
+					  return HID_PARSE_InsufficientReportIDItems;
 
-				if (UsageListSize)
+					State->CurrReportIDInfo = &ParserData->ReportIDSizes[ParserData->TotalDeviceReports++];
+					memset(State->CurrReportIDInfo, 0x00, sizeof(HID_ReportSizeInfo_t));
+				}
+			}
+
+			ParserData->UsingReportIDs = true;
+
+			State->CurrReportIDInfo->ReportID = State->CurrStateTable->ReportID;
+			break;
+		case HID_RI_USAGE(0):
+			if (State->UsageListSize == HID_USAGE_STACK_DEPTH)
+			  return HID_PARSE_UsageListOverflow;
+
+			State->UsageList[State->UsageListSize++] = ReportItemData;
+			break;
+		case HID_RI_USAGE_MINIMUM(0):
+			State->UsageMinMax.Minimum = ReportItemData;
+			break;
+		case HID_RI_USAGE_MAXIMUM(0):
+			State->UsageMinMax.Maximum = ReportItemData;
+			break;
+		case HID_RI_COLLECTION(0):
+			if (ParserData->TotalCollectionPaths == ParserData->MaxCollectionPaths)
+			  return HID_PARSE_InsufficientCollectionPaths;
+
+			/* Each collection is given its own path record, so that paths referenced by earlier items are never reused */
+			ParentCollectionPath = State->CurrCollectionPath;
+			State->CurrCollectionPath   = &ParserData->CollectionPaths[ParserData->TotalCollectionPaths++];
+
+			State->CurrCollectionPath->Parent = ParentCollectionPath;
+
+			State->CurrCollectionPath->Type = ReportItemData;
+			State->CurrCollectionPath->Usage.Page = State->CurrStateTable->Attributes.Usage.Page;
+
+			if (State->UsageListSize)
+			{
+				State->CurrCollectionPath->Usage.Usage = State->UsageList[0];
+
+				for (uint8_t i = 0; i < State->UsageListSize; i++)
+				  State->UsageList[i] = State->UsageList[i + 1];
+
+				State->UsageListSize--;
+			}
+			else if (State->UsageMinMax.Minimum <= State->UsageMinMax.Maximum)
+			{
+				State->CurrCollectionPath->Usage.Usage = State->UsageMinMax.Minimum++;
+			}
+
+			break;
+		case HID_RI_END_COLLECTION(0):
+			if (State->CurrCollectionPath == NULL)
+			  return HID_PARSE_UnexpectedEndCollection;
+
+			State->CurrCollectionPath = State->CurrCollectionPath->Parent;
+			break;
+		case HID_RI_INPUT(0):
+		case HID_RI_OUTPUT(0):
+		case HID_RI_FEATURE(0):
+			for (uint8_t ReportItemNum = 0; ReportItemNum < State->CurrStateTable->ReportCount; ReportItemNum++)
+			{
+				HID_ReportItem_t NewReportItem;
+
+				memcpy(&NewReportItem.Attributes,
+				       &State->CurrStateTable->Attributes,
+				       sizeof(HID_ReportItem_Attributes_t));
+
+				NewReportItem.ItemFlags      = ReportItemData;
+				NewReportItem.CollectionPath = State->CurrCollectionPath;
+				NewReportItem.ReportID       = State->CurrStateTable->ReportID;
+
+				if (State->UsageListSize)
 				{
-					CurrCollectionPath->Usage.Usage = UsageList[0];
+					NewReportItem.Attributes.Usage.Usage = State->UsageList[0];
 
-					for (uint8_t i = 0; i < UsageListSize; i++)
-					  UsageList[i] = UsageList[i + 1];
+					for (uint8_t i = 0; i < State->UsageListSize; i++)
+					  State->UsageList[i] = State->UsageList[i + 1];
 
-					UsageListSize--;
+					State->UsageListSize--;
 				}
-				else if (UsageMinMax.Minimum <= UsageMinMax.Maximum)
+				else if (State->UsageMinMax.Minimum <= State->UsageMinMax.Maximum)
 				{
-					CurrCollectionPath->Usage.Usage = UsageMinMax.Minimum++;
+					NewReportItem.Attributes.Usage.Usage = State->UsageMinMax.Minimum++;
 				}
 
-				break;
-			case HID_RI_END_COLLECTION(0):
-				if (CurrCollectionPath == NULL)
-				  return HID_PARSE_UnexpectedEndCollection;
+				uint8_t ItemTypeTag = (HIDReportItem & (HID_RI_TYPE_MASK | HID_RI_TAG_MASK));
 
-				CurrCollectionPath = CurrCollectionPath->Parent;
-				break;
-			case HID_RI_INPUT(0):
-			case HID_RI_OUTPUT(0):
-			case HID_RI_FEATURE(0):
-				for (uint8_t ReportItemNum = 0; ReportItemNum < CurrStateTable->ReportCount; ReportItemNum++)
-				{
-					HID_ReportItem_t NewReportItem;
+				if (ItemTypeTag == HID_RI_INPUT(0))
+				  NewReportItem.ItemType = HID_REPORT_ITEM_In;
+				else if (ItemTypeTag == HID_RI_OUTPUT(0))
+				  NewReportItem.ItemType = HID_REPORT_ITEM_Out;
+				else
+				  NewReportItem.ItemType = HID_REPORT_ITEM_Feature;
 
-					memcpy(&NewReportItem.Attributes,
-					       &CurrStateTable->Attributes,
-					       sizeof(HID_ReportItem_Attributes_t));
+				NewReportItem.BitOffset = State->CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType];
 
-					NewReportItem.ItemFlags      = ReportItemData;
-					NewReportItem.CollectionPath = CurrCollectionPath;
-					NewReportItem.ReportID       = CurrStateTable->ReportID;
+				State->CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType] += State->CurrStateTable->Attributes.BitSize;
 
-					if (UsageListSize)
-					{
-						NewReportItem.Attributes.Usage.Usage = UsageList[0];
+				if (ParserData->LargestReportSizeBits < NewReportItem.BitOffset)
+				  ParserData->LargestReportSizeBits = NewReportItem.BitOffset;
 
-						for (uint8_t i = 0; i < UsageListSize; i++)
-						  UsageList[i] = UsageList[i + 1];
+				if (!(ReportItemData & HID_IOF_CONSTANT) && CALLBACK_HIDParser_FilterHIDReportItem(&NewReportItem))
+				{
+					if (ParserData->TotalReportItems == ParserData->MaxReportItems)
+					  return HID_PARSE_InsufficientReportItems;
 
-						UsageListSize--;
-					}
-					else if (UsageMinMax.Minimum <= UsageMinMax.Maximum)
-					{
-						NewReportItem.Attributes.Usage.Usage = UsageMinMax.Minimum++;
-					}
+					memcpy(&ParserData->ReportItems[ParserData->TotalReportItems],
+					       &NewReportItem, sizeof(HID_ReportItem_t));
 
-					uint8_t ItemTypeTag = (HIDReportItem & (HID_RI_TYPE_MASK | HID_RI_TAG_MASK));
+					ParserData->TotalReportItems++;
+				}
+			}
 
-					if (ItemTypeTag == HID_RI_INPUT(0))
-					  NewReportItem.ItemType = HID_REPORT_ITEM_In;
-					else if (ItemTypeTag == HID_RI_OUTPUT(0))
-					  NewReportItem.ItemType = HID_REPORT_ITEM_Out;
-					else
-					  NewReportItem.ItemType = HID_REPORT_ITEM_Feature;
+			break;
+	}
 
-					NewReportItem.BitOffset = CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType];
+	if ((HIDReportItem & HID_RI_TYPE_MASK) == HID_RI_TYPE_MAIN)
+	{
+		State->UsageMinMax.Minimum = 0;
+		State->UsageMinMax.Maximum = 0;
+		State->UsageListSize       = 0;
+	}
 
-					CurrReportIDInfo->ReportSizeBits[NewReportItem.ItemType] += CurrStateTable->Attributes.BitSize;
+	return HID_PARSE_Successful;
+}
 
-					if (ParserData->LargestReportSizeBits < NewReportItem.BitOffset)
-					  ParserData->LargestReportSizeBits = NewReportItem.BitOffset;
+static uint8_t HID_CountReportDescriptor(const uint8_t* ReportData,
+                                         uint16_t ReportSize,
+                                         HID_ParserCounts_t* const Counts)
+{
+	uint8_t  ReportCountStack[HID_STATETABLE_STACK_DEPTH];
+	uint8_t  StateDepth          = 0;
+	uint8_t  CollectionDepth     = 0;
+	uint8_t  UsageListSize       = 0;
+	uint8_t  ReportIDsSeen[256 / 8];
+	uint16_t DeviceReports       = 0;
+	uint16_t CollectionPaths     = 0;
+	uint32_t ReportItems         = 0;
+
+	memset(ReportIDsSeen, 0x00, sizeof(ReportIDsSeen));
+	ReportCountStack[0] = 0;
 
-					if (!(ReportItemData & HID_IOF_CONSTANT) && CALLBACK_HIDParser_FilterHIDReportItem(&NewReportItem))
-					{
-						if (ParserData->TotalReportItems == HID_MAX_REPORTITEMS)
-						  return HID_PARSE_InsufficientReportItems;
+	while (ReportSize)
+	{
+		uint32_t ReportItemData;
+		uint8_t  HIDReportItem = HID_FetchReportItem(&ReportData, &ReportSize, &ReportItemData);
 
-						memcpy(&ParserData->ReportItems[ParserData->TotalReportItems],
-						       &NewReportItem, sizeof(HID_ReportItem_t));
+		switch (HIDReportItem & (HID_RI_TYPE_MASK | HID_RI_TAG_MASK))
+		{
+			case HID_RI_PUSH(0):
+				if (StateDepth == (HID_STATETABLE_STACK_DEPTH - 1))
+				  return HID_PARSE_HIDStackOverflow;
 
-						ParserData->TotalReportItems++;
-					}
+				ReportCountStack[StateDepth + 1] = ReportCountStack[StateDepth];
+				StateDepth++;
+				break;
+			case HID_RI_POP(0):
+				if (!(StateDepth))
+				  return HID_PARSE_HIDStackUnderflow;
+
+				StateDepth--;
+				break;
+			case HID_RI_REPORT_COUNT(0):
+				ReportCountStack[StateDepth] = ReportItemData;
+				break;
+			case HID_RI_REPORT_ID(0):
+				if (!(ReportIDsSeen[(uint8_t)ReportItemData >> 3] & (1 << (ReportItemData & 0x07))))
+				{
+					ReportIDsSeen[(uint8_t)ReportItemData >> 3] |= (1 << (ReportItemData & 0x07));
+					DeviceReports++;
 				}
 
+				break;
+			case HID_RI_USAGE(0):
+				if (UsageListSize == HID_USAGE_STACK_DEPTH)
+				  return HID_PARSE_UsageListOverflow;
+
+				UsageListSize++;
+				break;
+			case HID_RI_COLLECTION(0):
+				CollectionPaths++;
+				CollectionDepth++;
+				break;
+			case HID_RI_END_COLLECTION(0):
+				if (!(CollectionDepth))
+				  return HID_PARSE_UnexpectedEndCollection;
+
+				CollectionDepth--;
+				break;
+			case HID_RI_INPUT(0):
+			case HID_RI_OUTPUT(0):
+			case HID_RI_FEATURE(0):
+				if (!(ReportItemData & HID_IOF_CONSTANT))
+				  ReportItems += ReportCountStack[StateDepth];
+
 				break;
 		}
 
 		if ((HIDReportItem & HID_RI_TYPE_MASK) == HID_RI_TYPE_MAIN)
-		{
-			UsageMinMax.Minimum = 0;
-			UsageMinMax.Maximum = 0;
-			UsageListSize       = 0;
-		}
+		  UsageListSize = 0;
 	}
 
-	if (!(ParserData->TotalReportItems))
+	if (!(ReportItems))
 	  return HID_PARSE_NoUnfilteredReportItems;
 
+	if (ReportItems > 0xFF)
+	  return HID_PARSE_InsufficientReportItems;
+
+	if (CollectionPaths > 0xFF)
+	  return HID_PARSE_InsufficientCollectionPaths;
+
+	if (DeviceReports > 0xFF)
+	  return HID_PARSE_InsufficientReportIDItems;
+
+	Counts->ReportItems     = ReportItems;
+	Counts->CollectionPaths = CollectionPaths;
+	Counts->DeviceReports   = MAX(DeviceReports, 1);
+
 	return HID_PARSE_Successful;
 }
 
+static uint8_t HID_FetchReportItem(const uint8_t** const ReportData,
+                                   uint16_t* const ReportSize,
+                                   uint32_t* const ReportItemData)
+{
+	const uint8_t* ItemData      = *ReportData;
+	uint8_t        HIDReportItem = *(ItemData++);
+	uint8_t        DataSize      = HID_ITEM_DATA_SIZE(HIDReportItem);
+
+	/* A truncated final item has its data ignored, rather than being read from beyond the end of the descriptor */
+	if (DataSize >= *ReportSize)
+	  DataSize = (*ReportSize - 1);
+
+	switch (DataSize)
+	{
+		case 4:
+			*ReportItemData = le32_to_cpu(*((uint32_t*)ItemData));
+			break;
+		case 2:
+			*ReportItemData = le16_to_cpu(*((uint16_t*)ItemData));
+			break;
+		case 1:
+			*ReportItemData = *ItemData;
+			break;
+		default:
+			*ReportItemData = 0;
+			break;
+	}
+
+	*ReportData  = (ItemData + DataSize);
+	*ReportSize -= (1 + DataSize);
+
+	return HIDReportItem;
+}
+
 bool USB_GetHIDReportItemInfo(const uint8_t* ReportData,
                               HID_ReportItem_t* const ReportItem)
 {
-	uint16_t DataBitsRem  = ReportItem->Attributes.BitSize;
-	uint16_t CurrentBit   = ReportItem->BitOffset;
-	uint32_t BitMask      = (1 << 0);
+	uint8_t  BitSize   = MIN(ReportItem->Attributes.BitSize, 32);
+	uint32_t ValueMask = HID_VALUE_MASK(BitSize);
 
 	if (ReportItem->ReportID)
 	{
@@ -303,26 +606,29 @@ bool USB_GetHIDReportItemInfo(const uint8_t* ReportData,
 	}
 
 	ReportItem->PreviousValue = ReportItem->Value;
-	ReportItem->Value = 0;
 
-	while (DataBitsRem--)
+	if (!(BitSize))
 	{
-		if (ReportData[CurrentBit / 8] & (1 << (CurrentBit % 8)))
-		  ReportItem->Value |= BitMask;
-
-		CurrentBit++;
-		BitMask <<= 1;
+		ReportItem->Value = 0;
+		return true;
 	}
 
+	uint8_t  BitShift   = (ReportItem->BitOffset & 0x07);
+	uint32_t FieldValue = (uint32_t)(HID_LoadFieldBytes(&ReportData[ReportItem->BitOffset >> 3], BitShift + BitSize) >> BitShift) & ValueMask;
+
+	/* Items with a negative logical minimum hold two's complement values, which are sign extended to the full value width */
+	if ((BitSize < 32) && ((int32_t)ReportItem->Attributes.Logical.Minimum < 0) && (FieldValue & (1UL << (BitSize - 1))))
+	  FieldValue |= ~ValueMask;
+
+	ReportItem->Value = FieldValue;
+
 	return true;
 }
 
 void USB_SetHIDReportItemInfo(uint8_t* ReportData,
                               HID_ReportItem_t* const ReportItem)
 {
-	uint16_t DataBitsRem  = ReportItem->Attributes.BitSize;
-	uint16_t CurrentBit   = ReportItem->BitOffset;
-	uint32_t BitMask      = (1 << 0);
+	uint8_t  BitSize = MIN(ReportItem->Attributes.BitSize, 32);
 
 	if (ReportItem->ReportID)
 	{
@@ -332,21 +638,317 @@ void USB_SetHIDReportItemInfo(uint8_t* ReportData,
 
 	ReportItem->PreviousValue = ReportItem->Value;
 
-	while (DataBitsRem--)
+	if (!(BitSize))
+	  return;
+
+	uint8_t  BitShift   = (ReportItem->BitOffset & 0x07);
+	uint8_t  FieldBits  = (BitShift + BitSize);
+	uint8_t* FieldData  = &ReportData[ReportItem->BitOffset >> 3];
+	uint64_t FieldMask  = ((uint64_t)HID_VALUE_MASK(BitSize) << BitShift);
+	uint64_t FieldValue = ((uint64_t)ReportItem->Value << BitShift);
+
+	FieldValue = ((HID_LoadFieldBytes(FieldData, FieldBits) & ~FieldMask) | (FieldValue & FieldMask));
+
+	for (uint8_t FieldByte = 0; FieldByte < ((FieldBits + 7) >> 3); FieldByte++)
+	{
+		FieldData[FieldByte] = (uint8_t)FieldValue;
+		FieldValue >>= 8;
+	}
+}
+
+bool USB_CompileHIDDecodePlan(const HID_ArenaReportInfo_t* const ParserData,
+                              const uint8_t ReportType,
+                              HID_DecodePlan_t* const Plan)
+{
+	uint8_t TotalOps = 0;
+
+	Plan->TotalReports   = 0;
+	Plan->UsingReportIDs = ParserData->UsingReportIDs;
+
+	/* Arena output is not bounded by the fixed size arrays of the plan */
+	if ((ParserData->TotalReportItems > HID_MAX_REPORTITEMS) || (ParserData->TotalDeviceReports > HID_MAX_REPORT_IDS))
+	  return false;
+
+	for (uint8_t ReportIndex = 0; ReportIndex < ParserData->TotalDeviceReports; ReportIndex++)
+	{
+		HID_DecodePlanReport_t* PlanReport = &Plan->Reports[Plan->TotalReports];
+
+		PlanReport->ReportID = ParserData->ReportIDSizes[ReportIndex].ReportID;
+		PlanReport->FirstOp  = TotalOps;
+
+		for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+		{
+			const HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+			HID_DecodeOp_t*         Op         = &Plan->Ops[TotalOps];
+
+			if ((ReportItem->ItemType != ReportType) || (ReportItem->ReportID != PlanReport->ReportID))
+			  continue;
+
+			uint8_t BitSize = MIN(ReportItem->Attributes.BitSize, 32);
+
+			Op->ByteOffset = (ReportItem->BitOffset >> 3);
+			Op->Shift      = (ReportItem->BitOffset & 0x07);
+			Op->ByteCount  = ((Op->Shift + BitSize + 7) >> 3);
+			Op->Mask       = HID_VALUE_MASK(BitSize);
+			Op->SignBit    = 0;
+			Op->ItemIndex  = ItemIndex;
+
+			if (BitSize && (BitSize < 32) && ((int32_t)ReportItem->Attributes.Logical.Minimum < 0))
+			  Op->SignBit = (1UL << (BitSize - 1));
+
+			TotalOps++;
+		}
+
+		PlanReport->TotalOps = (TotalOps - PlanReport->FirstOp);
+
+		if (PlanReport->TotalOps)
+		  Plan->TotalReports++;
+	}
+
+	return true;
+}
+
+bool USB_DecodeHIDReport(const HID_DecodePlan_t* const Plan,
+                         const uint8_t* ReportData,
+                         HID_DecodedReport_t* const Decoded)
+{
+	const HID_DecodePlanReport_t* PlanReport = &Plan->Reports[0];
+	uint8_t                       ReportID   = 0;
+
+	if (Plan->UsingReportIDs)
+	  ReportID = *(ReportData++);
+
+	for (uint8_t ReportIndex = 0; ReportIndex < Plan->TotalReports; ReportIndex++, PlanReport++)
 	{
-		if (ReportItem->Value & (1 << (CurrentBit % 8)))
-		  ReportData[CurrentBit / 8] |= BitMask;
+		if (PlanReport->ReportID != ReportID)
+		  continue;
 
-		CurrentBit++;
-		BitMask <<= 1;
+		const HID_DecodeOp_t* Op     = &Plan->Ops[PlanReport->FirstOp];
+		uint8_t*              Index  = Decoded->ItemIndexes;
+		uint32_t*             Value  = Decoded->Values;
+
+		for (uint8_t OpsRemaining = PlanReport->TotalOps; OpsRemaining; OpsRemaining--, Op++)
+		{
+			uint32_t FieldValue = (uint32_t)(HID_LoadFieldBytes(&ReportData[Op->ByteOffset], (Op->ByteCount << 3)) >> Op->Shift) & Op->Mask;
+
+			/* Branchless sign extension, a zero sign bit mask leaves unsigned values unchanged */
+			*(Value++) = ((FieldValue ^ Op->SignBit) - Op->SignBit);
+			*(Index++) = Op->ItemIndex;
+		}
+
+		Decoded->ReportID    = ReportID;
+		Decoded->TotalValues = PlanReport->TotalOps;
+
+		return true;
 	}
+
+	return false;
+}
+
+bool USB_BuildHIDUsageIndex(const HID_ArenaReportInfo_t* const ParserData,
+                            HID_UsageIndex_t* const Index)
+{
+	Index->TotalEntries = 0;
+
+	/* Arena output is not bounded by the fixed size arrays of the index */
+	if ((ParserData->TotalReportItems > HID_MAX_REPORTITEMS) || (ParserData->TotalCollectionPaths > HID_MAX_COLLECTIONS))
+	  return false;
+
+	Index->TotalEntries = ParserData->TotalReportItems;
+
+	/* Insertion sort both orderings - the index is only built once per parsed report, and items are often already ordered */
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		const HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		HID_UsageIndexEntry_t UsageEntry = (HID_UsageIndexEntry_t)
+			{
+				.Usage     = (((uint32_t)ReportItem->Attributes.Usage.Page << 16) | ReportItem->Attributes.Usage.Usage),
+				.ItemType  = ReportItem->ItemType,
+				.ReportID  = ReportItem->ReportID,
+				.ItemIndex = ItemIndex,
+			};
+
+		HID_CollectionIndexEntry_t CollectionEntry = (HID_CollectionIndexEntry_t)
+			{
+				.Collection = HID_INDEX_NO_COLLECTION,
+				.ItemIndex  = ItemIndex,
+			};
+
+		if (ReportItem->CollectionPath != NULL)
+		  CollectionEntry.Collection = (ReportItem->CollectionPath - ParserData->CollectionPaths);
+
+		uint64_t UsageKey    = HID_USAGE_INDEX_KEY(UsageEntry.Usage, UsageEntry.ItemType, UsageEntry.ReportID);
+		uint8_t  InsertIndex = ItemIndex;
+
+		while (InsertIndex)
+		{
+			HID_UsageIndexEntry_t* PrevEntry = &Index->UsageEntries[InsertIndex - 1];
+
+			if (HID_USAGE_INDEX_KEY(PrevEntry->Usage, PrevEntry->ItemType, PrevEntry->ReportID) <= UsageKey)
+			  break;
+
+			Index->UsageEntries[InsertIndex] = *PrevEntry;
+			InsertIndex--;
+		}
+
+		Index->UsageEntries[InsertIndex] = UsageEntry;
+
+		InsertIndex = ItemIndex;
+
+		while (InsertIndex && (Index->CollectionEntries[InsertIndex - 1].Collection > CollectionEntry.Collection))
+		{
+			Index->CollectionEntries[InsertIndex] = Index->CollectionEntries[InsertIndex - 1];
+			InsertIndex--;
+		}
+
+		Index->CollectionEntries[InsertIndex] = CollectionEntry;
+	}
+
+	/* Collections are stored in descriptor order, so each collection's nested collections directly follow it */
+	for (uint8_t Collection = 0; Collection < ParserData->TotalCollectionPaths; Collection++)
+	{
+		uint8_t CollectionEnd = (Collection + 1);
+
+		while (CollectionEnd < ParserData->TotalCollectionPaths)
+		{
+			const HID_CollectionPath_t* Parent = ParserData->CollectionPaths[CollectionEnd].Parent;
+
+			while ((Parent != NULL) && (Parent != &ParserData->CollectionPaths[Collection]))
+			  Parent = Parent->Parent;
+
+			if (Parent == NULL)
+			  break;
+
+			CollectionEnd++;
+		}
+
+		Index->CollectionEnd[Collection] = CollectionEnd;
+	}
+
+	return true;
+}
+
+HID_ReportItem_t* USB_FindHIDReportItem(const HID_ArenaReportInfo_t* const ParserData,
+                                        const HID_UsageIndex_t* const Index,
+                                        const uint16_t UsagePage,
+                                        const uint16_t Usage,
+                                        const uint8_t ItemType,
+                                        const uint8_t ReportID)
+{
+	uint32_t UsageValue = (((uint32_t)UsagePage << 16) | Usage);
+	uint8_t  EntryIndex = HID_UsageIndexLowerBound(Index, HID_USAGE_INDEX_KEY(UsageValue, ItemType, ReportID));
+
+	if (EntryIndex == Index->TotalEntries)
+	  return NULL;
+
+	const HID_UsageIndexEntry_t* Entry = &Index->UsageEntries[EntryIndex];
+
+	if ((Entry->Usage != UsageValue) || (Entry->ItemType != ItemType) || (Entry->ReportID != ReportID))
+	  return NULL;
+
+	return &ParserData->ReportItems[Entry->ItemIndex];
+}
+
+uint8_t USB_FindHIDUsageRange(const HID_UsageIndex_t* const Index,
+                              const uint16_t UsagePage,
+                              const uint16_t UsageMinimum,
+                              const uint16_t UsageMaximum,
+                              uint8_t* const FirstEntry)
+{
+	uint32_t UsageFirst = (((uint32_t)UsagePage << 16) | UsageMinimum);
+	uint32_t UsageLast  = (((uint32_t)UsagePage << 16) | UsageMaximum);
+
+	*FirstEntry = HID_UsageIndexLowerBound(Index, HID_USAGE_INDEX_KEY(UsageFirst, 0, 0));
+
+	if (UsageMaximum < UsageMinimum)
+	  return 0;
+
+	return (HID_UsageIndexLowerBound(Index, HID_USAGE_INDEX_KEY((uint64_t)UsageLast + 1, 0, 0)) - *FirstEntry);
+}
+
+uint8_t USB_FindHIDCollectionItems(const HID_ArenaReportInfo_t* const ParserData,
+                                   const HID_UsageIndex_t* const Index,
+                                   const HID_CollectionPath_t* const CollectionPath,
+                                   uint8_t* const FirstEntry)
+{
+	uint8_t Collection = (CollectionPath - ParserData->CollectionPaths);
+
+	*FirstEntry = HID_CollectionIndexLowerBound(Index, Collection);
+
+	return (HID_CollectionIndexLowerBound(Index, Index->CollectionEnd[Collection]) - *FirstEntry);
+}
+
+static uint8_t HID_UsageIndexLowerBound(const HID_UsageIndex_t* const Index,
+                                        const uint64_t Key)
+{
+	uint8_t Lower = 0;
+	uint8_t Upper = Index->TotalEntries;
+
+	while (Lower < Upper)
+	{
+		uint8_t                      Middle = (Lower + ((Upper - Lower) >> 1));
+		const HID_UsageIndexEntry_t* Entry  = &Index->UsageEntries[Middle];
+
+		if (HID_USAGE_INDEX_KEY(Entry->Usage, Entry->ItemType, Entry->ReportID) < Key)
+		  Lower = (Middle + 1);
+		else
+		  Upper = Middle;
+	}
+
+	return Lower;
+}
+
+static uint8_t HID_CollectionIndexLowerBound(const HID_UsageIndex_t* const Index,
+                                             const uint8_t Collection)
+{
+	uint8_t Lower = 0;
+	uint8_t Upper = Index->TotalEntries;
+
+	while (Lower < Upper)
+	{
+		uint8_t Middle = (Lower + ((Upper - Lower) >> 1));
+
+		if (Index->CollectionEntries[Middle].Collection < Collection)
+		  Lower = (Middle + 1);
+		else
+		  Upper = Middle;
+	}
+
+	return Lower;
+}
+
+static uint32_t HID_SignExtendItemData(const uint8_t HIDReportItem,
+                                       const uint32_t ReportItemData)
+{
+	switch (HIDReportItem & HID_RI_DATA_SIZE_MASK)
+	{
+		case HID_RI_DATA_BITS_8:
+			return (uint32_t)(int32_t)(int8_t)ReportItemData;
+		case HID_RI_DATA_BITS_16:
+			return (uint32_t)(int32_t)(int16_t)ReportItemData;
+		default:
+			return ReportItemData;
+	}
+}
+
+static uint64_t HID_LoadFieldBytes(const uint8_t* FieldData,
+                                   const uint8_t FieldBits)
+{
+	uint64_t FieldValue = 0;
+
+	/* Only the bytes the field spans are read, so that fields at the end of a report never read past the report buffer */
+	for (uint8_t ByteIndex = ((FieldBits + 7) >> 3); ByteIndex > 0; ByteIndex--)
+	  FieldValue = ((FieldValue << 8) | FieldData[ByteIndex - 1]);
+
+	return FieldValue;
 }
 
-uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData,
+uint16_t USB_GetHIDReportSize(const HID_ArenaReportInfo_t* const ParserData,
                               const uint8_t ReportID,
                               const uint8_t ReportType)
 {
-	for (uint8_t i = 0; i < HID_MAX_REPORT_IDS; i++)
+	for (uint8_t i = 0; i < ParserData->TotalDeviceReports; i++)
 	{
 		uint16_t ReportSizeBits = ParserData->ReportIDSizes[i].ReportSizeBits[ReportType];
 
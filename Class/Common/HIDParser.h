@@ -141,6 +141,9 @@
 		 */
 		#define HID_ALIGN_DATA(ReportItem, Type) ((Type)(ReportItem->Value << ((8 * sizeof(Type)) - ReportItem->Attributes.BitSize)))
 
+		/** Collection index given to report items which are not contained within any collection in a \ref HID_UsageIndex_t. */
+		#define HID_INDEX_NO_COLLECTION           0xFF
+
 	/* Public Interface - May be used in end-application: */
 		/* Enums: */
 			/** Enum for the possible error codes in the return value of the \ref USB_ProcessHIDReport() function. */
@@ -155,6 +158,7 @@
 				HID_PARSE_UsageListOverflow           = 6, /**< More than \ref HID_USAGE_STACK_DEPTH usages listed in a row. */
 				HID_PARSE_InsufficientReportIDItems   = 7, /**< More than \ref HID_MAX_REPORT_IDS report IDs in the device. */
 				HID_PARSE_NoUnfilteredReportItems     = 8, /**< All report items from the device were filtered by the filtering callback routine. */
+				HID_PARSE_InsufficientArenaSpace      = 9, /**< The arena given to \ref USB_ProcessHIDReportArena() is too small for the report. */
 			};
 
 		/* Type Defines: */
@@ -246,12 +250,45 @@
 				                             */
 			} HID_ReportSizeInfo_t;
 
+			/** \brief HID Parser Arena State Structure.
+			 *
+			 *  Type define for a complete processed HID report whose report items, collections and report sizes are
+			 *  stored in a caller supplied memory arena by \ref USB_ProcessHIDReportArena(), rather than in fixed size
+			 *  arrays. Each array is sized exactly to the number of records required by the processed report.
+			 *
+			 *  This is also the form in which the report lookup and decode functions take the parser output. Output
+			 *  processed into a \ref HID_ReportInfo_t is passed to them through its \c View element.
+			 */
+			typedef struct
+			{
+				uint8_t               TotalReportItems; /**< Total number of report items stored in the \c ReportItems array. */
+				uint8_t               TotalCollectionPaths; /**< Total number of collections stored in the \c CollectionPaths array. */
+				uint8_t               TotalDeviceReports; /**< Number of reports within the HID interface. */
+				bool                  UsingReportIDs; /**< Indicates if the device has at least one REPORT ID
+				                                       *   element in its HID report descriptor.
+				                                       */
+				uint16_t              LargestReportSizeBits; /**< Largest report that the attached device will generate, in bits. */
+				uint16_t              ArenaBytesUsed; /**< Number of bytes from the start of the arena used by the processed report,
+				                                       *   or required by it if no arena was given.
+				                                       */
+				HID_ReportItem_t*     ReportItems; /**< Report items array within the arena, including all IN, OUT and FEATURE items. */
+				HID_CollectionPath_t* CollectionPaths; /**< All collection items within the arena, referenced by the report items. */
+				HID_ReportSizeInfo_t* ReportIDSizes; /**< Report sizes within the arena for each report in the interface. */
+				uint8_t               MaxReportItems; /**< Capacity of the \c ReportItems array. */
+				uint8_t               MaxCollectionPaths; /**< Capacity of the \c CollectionPaths array. */
+				uint8_t               MaxDeviceReports; /**< Capacity of the \c ReportIDSizes array. */
+			} HID_ArenaReportInfo_t;
+
 			/** \brief HID Parser State Structure.
 			 *
 			 *  Type define for a complete processed HID report, including all report item data and collections.
 			 */
 			typedef struct
 			{
+				HID_ArenaReportInfo_t View; /**< View of the parser output in the form taken by the report lookup and decode
+				                             *   functions. Its arrays reference the fixed size arrays of this structure, so
+				                             *   it is only valid within the structure the report was processed into.
+				                             */
 				uint8_t              TotalReportItems; /**< Total number of report items stored in the \c ReportItems array. */
 				HID_ReportItem_t     ReportItems[HID_MAX_REPORTITEMS]; /**< Report items array, including all IN, OUT
 			                                                            *   and FEATURE items.
@@ -259,6 +296,7 @@
 				HID_CollectionPath_t CollectionPaths[HID_MAX_COLLECTIONS]; /**< All collection items, referenced
 				                                                            *   by the report items.
 				                                                            */
+				uint8_t              TotalCollectionPaths; /**< Total number of collections stored in the \c CollectionPaths array. */
 				uint8_t              TotalDeviceReports; /**< Number of reports within the HID interface */
 				HID_ReportSizeInfo_t ReportIDSizes[HID_MAX_REPORT_IDS]; /**< Report sizes for each report in the interface */
 				uint16_t             LargestReportSizeBits; /**< Largest report that the attached device will generate, in bits */
@@ -267,6 +305,140 @@
 				                                      */
 			} HID_ReportInfo_t;
 
+			/** \brief HID Parser State Table Structure.
+			 *
+			 *  Type define for an entry of the global item state stack within a \ref HID_ParserState_t. The contents of
+			 *  this structure are for internal use by the parser only.
+			 */
+			typedef struct
+			{
+				 HID_ReportItem_Attributes_t Attributes;
+				 uint8_t                     ReportCount;
+				 uint8_t                     ReportID;
+			} HID_StateTable_t;
+
+			/** \brief HID Incremental Parser State Structure.
+			 *
+			 *  Type define for the state of an incremental parse of a HID report descriptor, started via
+			 *  \ref USB_BeginHIDReportParse(). This retains all parser state between chunks of the descriptor, so
+			 *  that the descriptor need never be held in memory in its entirety. The contents of this structure are for
+			 *  internal use by the parser only, and the structure must not be moved while a parse is in progress.
+			 */
+			typedef struct
+			{
+				HID_StateTable_t      StateTable[HID_STATETABLE_STACK_DEPTH];
+				HID_StateTable_t*     CurrStateTable;
+				HID_CollectionPath_t* CurrCollectionPath;
+				HID_ReportSizeInfo_t* CurrReportIDInfo;
+				uint16_t              UsageList[HID_USAGE_STACK_DEPTH];
+				uint8_t               UsageListSize;
+				HID_MinMax_t          UsageMinMax;
+				HID_ArenaReportInfo_t Output;
+				HID_ReportInfo_t*     ParserData;
+				uint8_t               ItemBuffer[5];
+				uint8_t               ItemBufferLength;
+				uint8_t               ErrorCode;
+			} HID_ParserState_t;
+
+			/** \brief HID Decode Plan Operation Structure.
+			 *
+			 *  Type define for a single precomputed extraction operation within a \ref HID_DecodePlan_t, describing where
+			 *  one report item's value is located within a report and how it is converted into a value.
+			 */
+			typedef struct
+			{
+				uint16_t ByteOffset; /**< Offset in bytes of the first byte of the item's data, excluding any report ID. */
+				uint8_t  ByteCount;  /**< Number of report bytes spanned by the item's data. */
+				uint8_t  Shift;      /**< Number of bits the loaded bytes are shifted right to align the item's data. */
+				uint32_t Mask;       /**< Mask of the item's data bits once aligned. */
+				uint32_t SignBit;    /**< Mask of the item's sign bit if the item is signed and narrower than 32 bits, zero otherwise. */
+				uint8_t  ItemIndex;  /**< Index of the item in the source parser output's \c ReportItems array. */
+			} HID_DecodeOp_t;
+
+			/** \brief HID Decode Plan Report Structure.
+			 *
+			 *  Type define for the range of operations within a \ref HID_DecodePlan_t belonging to a single report ID.
+			 */
+			typedef struct
+			{
+				uint8_t ReportID; /**< Report ID of the report, or 0x00 if the device has only one report. */
+				uint8_t FirstOp;  /**< Index of the first operation for the report in the plan's \c Ops array. */
+				uint8_t TotalOps; /**< Number of operations for the report. */
+			} HID_DecodePlanReport_t;
+
+			/** \brief HID Decode Plan Structure.
+			 *
+			 *  Type define for a compiled extraction plan of all report items of one report type, created from a
+			 *  processed HID report descriptor via \ref USB_CompileHIDDecodePlan() so that whole reports can be
+			 *  decoded at once via \ref USB_DecodeHIDReport().
+			 */
+			typedef struct
+			{
+				uint8_t                TotalReports; /**< Number of reports stored in the \c Reports array. */
+				bool                   UsingReportIDs; /**< Indicates if reports are prefixed with a report ID byte. */
+				HID_DecodePlanReport_t Reports[HID_MAX_REPORT_IDS]; /**< Operation ranges for each report ID. */
+				HID_DecodeOp_t         Ops[HID_MAX_REPORTITEMS]; /**< Extraction operations, grouped by report ID. */
+			} HID_DecodePlan_t;
+
+			/** \brief HID Decoded Report Structure.
+			 *
+			 *  Type define for the output of \ref USB_DecodeHIDReport(), holding the values of all report items
+			 *  present in a decoded report as parallel arrays.
+			 */
+			typedef struct
+			{
+				uint8_t  ReportID; /**< Report ID of the decoded report. */
+				uint8_t  TotalValues; /**< Number of item values stored in the \c ItemIndexes and \c Values arrays. */
+				uint8_t  ItemIndexes[HID_MAX_REPORTITEMS]; /**< Index of each decoded item in the source parser output's
+				                                            *   \c ReportItems array.
+				                                            */
+				uint32_t Values[HID_MAX_REPORTITEMS]; /**< Decoded value of each item, sign extended for signed items in
+				                                       *   the same manner as \ref USB_GetHIDReportItemInfo().
+				                                       */
+			} HID_DecodedReport_t;
+
+			/** \brief HID Usage Index Entry Structure.
+			 *
+			 *  Type define for a single report item reference within the usage ordered array of a \ref HID_UsageIndex_t.
+			 */
+			typedef struct
+			{
+				uint32_t Usage;     /**< Usage page of the item in the upper 16 bits, and usage in the lower 16 bits. */
+				uint8_t  ItemType;  /**< Report item type, a value in \ref HID_ReportItemTypes_t. */
+				uint8_t  ReportID;  /**< Report ID the item belongs to. */
+				uint8_t  ItemIndex; /**< Index of the item in the source parser output's \c ReportItems array. */
+			} HID_UsageIndexEntry_t;
+
+			/** \brief HID Collection Index Entry Structure.
+			 *
+			 *  Type define for a single report item reference within the collection ordered array of a \ref HID_UsageIndex_t.
+			 */
+			typedef struct
+			{
+				uint8_t Collection; /**< Index of the item's collection in the source parser output's \c CollectionPaths array,
+				                     *   or \ref HID_INDEX_NO_COLLECTION if the item is not within a collection.
+				                     */
+				uint8_t ItemIndex;  /**< Index of the item in the source parser output's \c ReportItems array. */
+			} HID_CollectionIndexEntry_t;
+
+			/** \brief HID Usage Index Structure.
+			 *
+			 *  Type define for a sorted index over the report items of a processed HID report, created via
+			 *  \ref USB_BuildHIDUsageIndex(). The index allows report items to be located by usage or by collection
+			 *  with a binary search rather than a scan over every report item.
+			 */
+			typedef struct
+			{
+				uint8_t                    TotalEntries; /**< Number of entries in each of the entry arrays. */
+				HID_UsageIndexEntry_t      UsageEntries[HID_MAX_REPORTITEMS]; /**< Items ordered by usage page, usage,
+				                                                               *   item type and report ID.
+				                                                               */
+				HID_CollectionIndexEntry_t CollectionEntries[HID_MAX_REPORTITEMS]; /**< Items ordered by collection. */
+				uint8_t                    CollectionEnd[HID_MAX_COLLECTIONS]; /**< Index of the first collection following
+				                                                                *   each collection's nested collections.
+				                                                                */
+			} HID_UsageIndex_t;
+
 		/* Function Prototypes: */
 			/** Function to process a given HID report returned from an attached device, and store it into a given
 			 *  \ref HID_ReportInfo_t structure.
@@ -281,6 +453,63 @@
 			                             uint16_t ReportSize,
 			                             HID_ReportInfo_t* const ParserData) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
 
+			/** Begins an incremental parse of a HID report descriptor into the given \ref HID_ReportInfo_t structure. The
+			 *  descriptor is then supplied in chunks of any size via \ref USB_ParseHIDReportChunk(), such as one control
+			 *  transfer packet at a time, and the parse completed via \ref USB_EndHIDReportParse(). The results are identical
+			 *  to those of \ref USB_ProcessHIDReport() given the complete descriptor.
+			 *
+			 *  \param[out] State       Pointer to a \ref HID_ParserState_t instance to hold the parser state.
+			 *  \param[out] ParserData  Pointer to a \ref HID_ReportInfo_t instance for the parser output.
+			 */
+			void USB_BeginHIDReportParse(HID_ParserState_t* const State,
+			                             HID_ReportInfo_t* const ParserData) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Parses the next chunk of a HID report descriptor in an incremental parse started via
+			 *  \ref USB_BeginHIDReportParse(). Report items split across chunk boundaries are retained in the parser state
+			 *  until complete. Once an error has occurred, further chunks are ignored and the error returned again.
+			 *
+			 *  \param[in,out] State       Pointer to the \ref HID_ParserState_t instance of the parse in progress.
+			 *  \param[in]     ReportData  Buffer containing the next chunk of the device's HID report table.
+			 *  \param[in]     ReportSize  Size in bytes of the chunk.
+			 *
+			 *  \return A value in the \ref HID_Parse_ErrorCodes_t enum.
+			 */
+			uint8_t USB_ParseHIDReportChunk(HID_ParserState_t* const State,
+			                                const uint8_t* ReportData,
+			                                uint16_t ReportSize) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Completes an incremental parse of a HID report descriptor started via \ref USB_BeginHIDReportParse(), once
+			 *  all chunks of the descriptor have been supplied.
+			 *
+			 *  \param[in,out] State  Pointer to the \ref HID_ParserState_t instance of the parse in progress.
+			 *
+			 *  \return A value in the \ref HID_Parse_ErrorCodes_t enum.
+			 */
+			uint8_t USB_EndHIDReportParse(HID_ParserState_t* const State) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Function to process a given HID report returned from an attached device, storing the processed report items,
+			 *  collections and report sizes into a caller supplied memory arena. The report is processed in two passes; the
+			 *  first determines the exact number of each record required, and the second fills them in, so that the parser
+			 *  is not limited by \ref HID_MAX_REPORTITEMS, \ref HID_MAX_COLLECTIONS or \ref HID_MAX_REPORT_IDS and uses no
+			 *  more memory than the report requires.
+			 *
+			 *  Report items are stored last in the arena, so that any space after \c ArenaBytesUsed bytes, including that
+			 *  of items rejected by \ref CALLBACK_HIDParser_FilterHIDReportItem(), may be reused by the application.
+			 *
+			 *  \param[in]  ReportData  Buffer containing the device's HID report table.
+			 *  \param[in]  ReportSize  Size in bytes of the HID report table.
+			 *  \param[in]  Arena       Pointer to the memory arena, or \c NULL to only determine the arena size required.
+			 *  \param[in]  ArenaSize   Size in bytes of the memory arena.
+			 *  \param[out] ParserData  Pointer to a \ref HID_ArenaReportInfo_t instance for the parser output.
+			 *
+			 *  \return A value in the \ref HID_Parse_ErrorCodes_t enum.
+			 */
+			uint8_t USB_ProcessHIDReportArena(const uint8_t* ReportData,
+			                                  uint16_t ReportSize,
+			                                  void* Arena,
+			                                  const uint16_t ArenaSize,
+			                                  HID_ArenaReportInfo_t* const ParserData) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(5);
+
 			/** Extracts the given report item's value out of the given HID report and places it into the Value
 			 *  member of the report item's \ref HID_ReportItem_t structure.
 			 *
@@ -289,6 +518,9 @@
 			 *  a report. If the given item does not exist in the report, the function does not modify the report item's
 			 *  data.
 			 *
+			 *  Items with a negative logical minimum are treated as signed, and their value is sign extended to the full
+			 *  width of the Value member. Only the lower 32 bits of items larger than 32 bits are retrieved.
+			 *
 			 *  \param[in]     ReportData  Buffer containing an IN or FEATURE report from an attached device.
 			 *  \param[in,out] ReportItem  Pointer to the report item of interest in a \ref HID_ReportInfo_t ReportItem array.
 			 *
@@ -299,8 +531,8 @@
 
 			/** Retrieves the given report item's value out of the Value member of the report item's
 			 *  \ref HID_ReportItem_t structure and places it into the correct position in the HID report
-			 *  buffer. The report buffer is assumed to have the appropriate bits cleared before calling
-			 *  this function (i.e., the buffer should be explicitly cleared before report values are added).
+			 *  buffer. Only the bits belonging to the item are modified, so other items already placed into the
+			 *  report buffer are preserved.
 			 *
 			 *  When called, this copies the report item's Value element to it's PreviousValue element for easy
 			 *  checking to see if an item's value has changed before sending a report.
@@ -313,18 +545,119 @@
 			void USB_SetHIDReportItemInfo(uint8_t* ReportData,
 			                              HID_ReportItem_t* const ReportItem) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Compiles the report items of a given type within a processed HID report descriptor into a flat extraction
+			 *  plan, so that complete reports can later be decoded via \ref USB_DecodeHIDReport() without recomputing
+			 *  each item's location. The plan remains valid for as long as the source parser output is unchanged. As the
+			 *  plan is of a fixed size, output processed via \ref USB_ProcessHIDReportArena() may contain no more than
+			 *  \ref HID_MAX_REPORTITEMS report items and \ref HID_MAX_REPORT_IDS reports.
+			 *
+			 *  \param[in]  ParserData  Pointer to a \ref HID_ArenaReportInfo_t instance containing the parser output, or the
+			 *                          \c View element of a \ref HID_ReportInfo_t.
+			 *  \param[in]  ReportType  Type of the report items to compile, a value from the \ref HID_ReportItemTypes_t enum.
+			 *  \param[out] Plan        Pointer to a \ref HID_DecodePlan_t instance where the compiled plan is to be stored.
+			 *
+			 *  \return Boolean \c true if the plan was compiled, \c false if the parser output is too large for the plan.
+			 */
+			bool USB_CompileHIDDecodePlan(const HID_ArenaReportInfo_t* const ParserData,
+			                              const uint8_t ReportType,
+			                              HID_DecodePlan_t* const Plan) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Decodes the values of all report items within a given report using a plan previously compiled via
+			 *  \ref USB_CompileHIDDecodePlan(), storing them into the given \ref HID_DecodedReport_t structure.
+			 *
+			 *  \param[in]  Plan        Pointer to a compiled \ref HID_DecodePlan_t for the report type being decoded.
+			 *  \param[in]  ReportData  Buffer containing a report from an attached device, including any report ID.
+			 *  \param[out] Decoded     Pointer to a \ref HID_DecodedReport_t instance where the decoded values are to be stored.
+			 *
+			 *  \return Boolean \c true if the report's ID was found in the plan, \c false otherwise.
+			 */
+			bool USB_DecodeHIDReport(const HID_DecodePlan_t* const Plan,
+			                         const uint8_t* ReportData,
+			                         HID_DecodedReport_t* const Decoded) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2)
+			                         ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Builds a sorted index over the report items of a processed HID report, for later lookups via
+			 *  \ref USB_FindHIDReportItem(), \ref USB_FindHIDUsageRange() and \ref USB_FindHIDCollectionItems().
+			 *  The index remains valid for as long as the source parser output is unchanged. As the index is of a fixed
+			 *  size, output processed via \ref USB_ProcessHIDReportArena() may contain no more than
+			 *  \ref HID_MAX_REPORTITEMS report items and \ref HID_MAX_COLLECTIONS collections.
+			 *
+			 *  \param[in]  ParserData  Pointer to a \ref HID_ArenaReportInfo_t instance containing the parser output, or the
+			 *                          \c View element of a \ref HID_ReportInfo_t.
+			 *  \param[out] Index       Pointer to a \ref HID_UsageIndex_t instance where the index is to be stored.
+			 *
+			 *  \return Boolean \c true if the index was built, \c false if the parser output is too large for the index.
+			 */
+			bool USB_BuildHIDUsageIndex(const HID_ArenaReportInfo_t* const ParserData,
+			                            HID_UsageIndex_t* const Index) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Locates the report item with the given usage, item type and report ID in a processed HID report.
+			 *
+			 *  \param[in] ParserData  Pointer to a \ref HID_ArenaReportInfo_t instance containing the parser output, or the
+			 *                         \c View element of a \ref HID_ReportInfo_t.
+			 *  \param[in] Index       Pointer to a \ref HID_UsageIndex_t built from the given parser output.
+			 *  \param[in] UsagePage   Usage page of the item to locate.
+			 *  \param[in] Usage       Usage of the item to locate.
+			 *  \param[in] ItemType    Type of the item to locate, a value from the \ref HID_ReportItemTypes_t enum.
+			 *  \param[in] ReportID    Report ID of the item to locate, or 0x00 if the device has only one report.
+			 *
+			 *  \return Pointer to the located report item, or \c NULL if no such item exists.
+			 */
+			HID_ReportItem_t* USB_FindHIDReportItem(const HID_ArenaReportInfo_t* const ParserData,
+			                                        const HID_UsageIndex_t* const Index,
+			                                        const uint16_t UsagePage,
+			                                        const uint16_t Usage,
+			                                        const uint8_t ItemType,
+			                                        const uint8_t ReportID) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Locates all report items within a range of usages on a given usage page, such as the items created from a
+			 *  USAGE MINIMUM/USAGE MAXIMUM pair. The located items are returned as a contiguous run of the index's
+			 *  \c UsageEntries array, ordered by usage, item type and report ID.
+			 *
+			 *  \param[in]  Index         Pointer to a \ref HID_UsageIndex_t built from a processed HID report.
+			 *  \param[in]  UsagePage     Usage page of the items to locate.
+			 *  \param[in]  UsageMinimum  First usage in the range of usages to locate.
+			 *  \param[in]  UsageMaximum  Last usage in the range of usages to locate.
+			 *  \param[out] FirstEntry    Index of the first located entry in the \c UsageEntries array.
+			 *
+			 *  \return Number of located entries.
+			 */
+			uint8_t USB_FindHIDUsageRange(const HID_UsageIndex_t* const Index,
+			                              const uint16_t UsagePage,
+			                              const uint16_t UsageMinimum,
+			                              const uint16_t UsageMaximum,
+			                              uint8_t* const FirstEntry) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(5);
+
+			/** Locates all report items within a given collection, including those within its nested collections. The
+			 *  located items are returned as a contiguous run of the index's \c CollectionEntries array.
+			 *
+			 *  \param[in]  ParserData      Pointer to a \ref HID_ArenaReportInfo_t instance containing the parser output, or
+			 *                              the \c View element of a \ref HID_ReportInfo_t.
+			 *  \param[in]  Index           Pointer to a \ref HID_UsageIndex_t built from the given parser output.
+			 *  \param[in]  CollectionPath  Pointer to the collection within the parser output whose items are to be located.
+			 *  \param[out] FirstEntry      Index of the first located entry in the \c CollectionEntries array.
+			 *
+			 *  \return Number of located entries.
+			 */
+			uint8_t USB_FindHIDCollectionItems(const HID_ArenaReportInfo_t* const ParserData,
+			                                   const HID_UsageIndex_t* const Index,
+			                                   const HID_CollectionPath_t* const CollectionPath,
+			                                   uint8_t* const FirstEntry) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2)
+			                                   ATTR_NON_NULL_PTR_ARG(3) ATTR_NON_NULL_PTR_ARG(4);
+
 			/** Retrieves the size of a given HID report in bytes from it's Report ID.
 			 *
-			 *  \param[in] ParserData  Pointer to a \ref HID_ReportInfo_t instance containing the parser output.
+			 *  \param[in] ParserData  Pointer to a \ref HID_ArenaReportInfo_t instance containing the parser output, or the
+			 *                         \c View element of a \ref HID_ReportInfo_t.
 			 *  \param[in] ReportID    Report ID of the report whose size is to be retrieved.
 			 *  \param[in] ReportType  Type of the report whose size is to be determined, a valued from the
 			 *                         \ref HID_ReportItemTypes_t enum.
 			 *
 			 *  \return Size of the report in bytes, or 0 if the report does not exist.
 			 */
-			uint16_t USB_GetHIDReportSize(HID_ReportInfo_t* const ParserData,
+			uint16_t USB_GetHIDReportSize(const HID_ArenaReportInfo_t* const ParserData,
 			                              const uint8_t ReportID,
-			                              const uint8_t ReportType) ATTR_CONST ATTR_NON_NULL_PTR_ARG(1);
+			                              const uint8_t ReportType) ATTR_PURE ATTR_NON_NULL_PTR_ARG(1);
 
 			/** Callback routine for the HID Report Parser. This callback <b>must</b> be implemented by the user code when
 			 *  the parser is used, to determine what report IN, OUT and FEATURE item's information is stored into the user
@@ -343,10 +676,48 @@
 		/* Type Defines: */
 			typedef struct
 			{
-				 HID_ReportItem_Attributes_t Attributes;
-				 uint8_t                     ReportCount;
-				 uint8_t                     ReportID;
-			} HID_StateTable_t;
+				uint8_t ReportItems;
+				uint8_t CollectionPaths;
+				uint8_t DeviceReports;
+			} HID_ParserCounts_t;
+
+		/* Macros: */
+			#define HID_VALUE_MASK(BitSize)   (((BitSize) >= 32) ? 0xFFFFFFFFUL : ((1UL << (BitSize)) - 1))
+			#define HID_ITEM_DATA_SIZE(Item)  ((((Item) & HID_RI_DATA_SIZE_MASK) == HID_RI_DATA_BITS_32) ? 4 : ((Item) & HID_RI_DATA_SIZE_MASK))
+			#define HID_ARENA_ALIGN(Size)     (((Size) + (sizeof(void*) - 1)) & ~(sizeof(void*) - 1))
+			#define HID_USAGE_INDEX_KEY(Usage, ItemType, ReportID)  (((uint64_t)(Usage) << 16) | ((uint16_t)(ItemType) << 8) | (ReportID))
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_HIDPARSER_C)
+				static uint8_t HID_ParseReportDescriptor(const uint8_t* ReportData,
+				                                         uint16_t ReportSize,
+				                                         HID_ParserState_t* const State) ATTR_NON_NULL_PTR_ARG(1)
+				                                         ATTR_NON_NULL_PTR_ARG(3);
+				static void HID_InitParserState(HID_ParserState_t* const State) ATTR_NON_NULL_PTR_ARG(1);
+				static void HID_UpdateReportInfo(HID_ParserState_t* const State) ATTR_NON_NULL_PTR_ARG(1);
+				static uint8_t HID_FetchBufferedReportItem(HID_ParserState_t* const State,
+				                                           uint32_t* const ReportItemData) ATTR_NON_NULL_PTR_ARG(1)
+				                                           ATTR_NON_NULL_PTR_ARG(2);
+				static uint8_t HID_ProcessReportItem(HID_ParserState_t* const State,
+				                                     const uint8_t HIDReportItem,
+				                                     uint32_t ReportItemData) ATTR_NON_NULL_PTR_ARG(1);
+				static uint8_t HID_CountReportDescriptor(const uint8_t* ReportData,
+				                                         uint16_t ReportSize,
+				                                         HID_ParserCounts_t* const Counts) ATTR_NON_NULL_PTR_ARG(1)
+				                                         ATTR_NON_NULL_PTR_ARG(3);
+				static uint8_t HID_UsageIndexLowerBound(const HID_UsageIndex_t* const Index,
+				                                        const uint64_t Key) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+				static uint8_t HID_CollectionIndexLowerBound(const HID_UsageIndex_t* const Index,
+				                                             const uint8_t Collection) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+				static uint8_t HID_FetchReportItem(const uint8_t** const ReportData,
+				                                   uint16_t* const ReportSize,
+				                                   uint32_t* const ReportItemData) ATTR_NON_NULL_PTR_ARG(1)
+				                                   ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
+				static uint32_t HID_SignExtendItemData(const uint8_t HIDReportItem,
+				                                       const uint32_t ReportItemData) ATTR_CONST;
+				static uint64_t HID_LoadFieldBytes(const uint8_t* FieldData,
+				                                   const uint8_t FieldBits) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+			#endif
 	#endif
 
 	/* Disable C linkage for C++ Compilers: */
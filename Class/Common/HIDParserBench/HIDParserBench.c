@@ -0,0 +1,355 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host benchmark and differential check of the HID report parser. Each descriptor of the corpus is processed both
+ *  into fixed size output and into an arena, and checked against the reference parser of HIDParserReference.c. The
+ *  usage index lookups and the decode plans of both outputs are checked against linear scans and the reference item
+ *  extraction. Each descriptor is then timed to give the descriptors processed per second, the reports decoded per
+ *  second both item by item and via a compiled decode plan, and the peak stack use of each.
+ *
+ *  Stack figures are measured on the host, and so are only indicative of the relative stack use on the target.
+ */
+
+#include "HIDParserBench.h"
+
+/** Parser output of the descriptor currently being benchmarked. */
+static HID_ReportInfo_t ParserData;
+
+/** Parser output checked against the reference parser output in \ref ParserData. */
+static HID_ReportInfo_t CheckData;
+
+/** Decode plans of the descriptor currently being benchmarked, indexed by the \ref HID_ReportItemTypes_t enum. */
+static HID_DecodePlan_t DecodePlans[3];
+
+/** Arena parser output of the descriptor currently being benchmarked, checked alongside \ref ParserData. */
+static HID_ArenaReportInfo_t ArenaData;
+
+/** Memory arena holding the report items, collections and report sizes of \ref ArenaData. */
+static uint8_t ArenaBuffer[BENCH_ARENA_SIZE] ATTR_ALIGNED(sizeof(void*));
+
+/** Decode plans compiled from \ref ArenaData, indexed by the \ref HID_ReportItemTypes_t enum. */
+static HID_DecodePlan_t ArenaPlans[3];
+
+/** Usage index of the parser output currently being checked. */
+static HID_UsageIndex_t UsageIndex;
+
+/** Decoded report output of the decode plan benchmark. */
+static HID_DecodedReport_t DecodedReport;
+
+/** Sample reports of the descriptor currently being benchmarked. */
+static Bench_SampleReport_t SampleReports[BENCH_MAX_REPORTS];
+
+/** Number of sample reports stored in the \ref SampleReports array. */
+static uint8_t TotalSampleReports;
+
+/** Corpus descriptor currently being benchmarked. */
+static const HID_CorpusEntry_t* CurrentEntry;
+
+/** Sink for benchmark results, so that the benchmarked calls are not optimized away. */
+static volatile uint32_t BenchSink;
+
+/** Painted stack the peak stack measurements are run on, and the contexts used to switch to and from it. */
+static uint8_t    MeasureStack[BENCH_STACK_SIZE];
+static ucontext_t MainContext;
+static ucontext_t MeasureContext;
+static void       (*MeasureTask)(void);
+
+/** Parser filter callback, storing every report item of the descriptor. */
+bool CALLBACK_HIDParser_FilterHIDReportItem(HID_ReportItem_t* const CurrentItem)
+{
+	return true;
+}
+
+/** Main program entry point. Checks and benchmarks each descriptor in turn, then the corpus as a whole.
+ *
+ *  \return \c EXIT_SUCCESS if no differences were found by the differential checks, \c EXIT_FAILURE otherwise.
+ */
+int main(void)
+{
+	uint32_t TotalDifferences = 0;
+	uint32_t PeakStack        = 0;
+	uint32_t Iterations;
+	double   StartTime;
+	double   Elapsed;
+
+	printf("%-22s %5s %5s %7s %14s %14s %6s\n", "Descriptor", "Bytes", "Items", "Check", "Extract rep/s", "Decode rep/s", "Stack");
+
+	for (uint8_t EntryIndex = 0; EntryIndex < HID_CorpusEntries; EntryIndex++)
+	{
+		const HID_CorpusEntry_t* Entry       = &HID_Corpus[EntryIndex];
+		uint16_t                 Differences = Bench_CheckDescriptor(Entry);
+		double                   ExtractRate = 0;
+		double                   DecodeRate  = 0;
+		uint32_t                 EntryStack;
+
+		CurrentEntry = Entry;
+		EntryStack   = Bench_MeasurePeakStack(Bench_ProcessEntry);
+
+		if (Bench_PrepareDescriptor(Entry) == HID_PARSE_Successful)
+		{
+			Iterations = 0;
+			StartTime  = Bench_Seconds();
+
+			do
+			{
+				Bench_ExtractReports();
+				Iterations++;
+			} while ((Elapsed = (Bench_Seconds() - StartTime)) < BENCH_MIN_SECONDS);
+
+			ExtractRate = ((Iterations * (double)TotalSampleReports) / Elapsed);
+
+			Iterations = 0;
+			StartTime  = Bench_Seconds();
+
+			do
+			{
+				Bench_DecodeReports();
+				Iterations++;
+			} while ((Elapsed = (Bench_Seconds() - StartTime)) < BENCH_MIN_SECONDS);
+
+			DecodeRate = ((Iterations * (double)TotalSampleReports) / Elapsed);
+
+			uint32_t ExtractStack = Bench_MeasurePeakStack(Bench_ExtractReports);
+			uint32_t DecodeStack  = Bench_MeasurePeakStack(Bench_DecodeReports);
+
+			EntryStack = MAX(EntryStack, MAX(ExtractStack, DecodeStack));
+		}
+
+		printf("%-22s %5u %5u %7s %14.0f %14.0f %6u\n", Entry->Name, Entry->DescriptorSize, ParserData.TotalReportItems,
+		       (Differences ? "FAIL" : "pass"), ExtractRate, DecodeRate, EntryStack);
+
+		TotalDifferences += Differences;
+		PeakStack         = MAX(PeakStack, EntryStack);
+	}
+
+	Iterations = 0;
+	StartTime  = Bench_Seconds();
+
+	do
+	{
+		Bench_ProcessCorpus();
+		Iterations++;
+	} while ((Elapsed = (Bench_Seconds() - StartTime)) < BENCH_MIN_SECONDS);
+
+	printf("\nDescriptors processed per second: %.0f\n", ((Iterations * (double)HID_CorpusEntries) / Elapsed));
+	printf("Peak stack use:                   %u bytes\n", PeakStack);
+	printf("Differential check differences:   %u\n", TotalDifferences);
+
+	return (TotalDifferences ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/** Checks the given descriptor against the reference parser, both as fixed size and as arena output. The usage index
+ *  of each output is checked against a linear scan, and each sample report decoded from either output is checked
+ *  against the reference item extraction.
+ *
+ *  \param[in] Entry  Corpus descriptor to check.
+ *
+ *  \return Number of differences found, including a descriptor which did not parse with its expected error code.
+ */
+static uint16_t Bench_CheckDescriptor(const HID_CorpusEntry_t* const Entry)
+{
+	uint16_t Differences = Reference_CheckReportParse(Entry->Descriptor, Entry->DescriptorSize, &ParserData, &CheckData);
+
+	Differences += Reference_CheckReportArena(Entry->Descriptor, Entry->DescriptorSize, &CheckData,
+	                                          ArenaBuffer, sizeof(ArenaBuffer), &ArenaData);
+
+	if (Bench_PrepareDescriptor(Entry) != Entry->ExpectedErrorCode)
+	  return (Differences + 1);
+
+	if (Entry->ExpectedErrorCode != HID_PARSE_Successful)
+	  return Differences;
+
+	Differences += Reference_CheckUsageIndex(&ParserData.View, &UsageIndex);
+	Differences += Reference_CheckUsageIndex(&ArenaData, &UsageIndex);
+
+	for (uint8_t ReportType = HID_REPORT_ITEM_In; ReportType <= HID_REPORT_ITEM_Feature; ReportType++)
+	{
+		if (!(USB_CompileHIDDecodePlan(&ArenaData, ReportType, &ArenaPlans[ReportType])))
+		  Differences++;
+	}
+
+	for (uint8_t ReportIndex = 0; ReportIndex < TotalSampleReports; ReportIndex++)
+	{
+		Bench_SampleReport_t* Report = &SampleReports[ReportIndex];
+
+		Differences += Reference_CheckReportItems(&ParserData.View, &DecodePlans[Report->ReportType], Report->ReportType, Report->ReportData);
+		Differences += Reference_CheckReportItems(&ArenaData, &ArenaPlans[Report->ReportType], Report->ReportType, Report->ReportData);
+	}
+
+	return Differences;
+}
+
+/** Processes the given descriptor into \ref ParserData, compiles its decode plans and generates its sample reports.
+ *
+ *  \param[in] Entry  Corpus descriptor to prepare.
+ *
+ *  \return A value in the \ref HID_Parse_ErrorCodes_t enum.
+ */
+static uint8_t Bench_PrepareDescriptor(const HID_CorpusEntry_t* const Entry)
+{
+	uint8_t ErrorCode = USB_ProcessHIDReport(Entry->Descriptor, Entry->DescriptorSize, &ParserData);
+
+	TotalSampleReports = 0;
+
+	if (ErrorCode != HID_PARSE_Successful)
+	  return ErrorCode;
+
+	/* Sample reports are pseudo-random but repeatable, so that runs may be compared against one another */
+	srand(Entry->DescriptorSize);
+
+	for (uint8_t ReportType = HID_REPORT_ITEM_In; ReportType <= HID_REPORT_ITEM_Feature; ReportType++)
+	{
+		USB_CompileHIDDecodePlan(&ParserData.View, ReportType, &DecodePlans[ReportType]);
+
+		for (uint8_t ReportIndex = 0; ReportIndex < ParserData.TotalDeviceReports; ReportIndex++)
+		{
+			uint8_t  ReportID   = ParserData.ReportIDSizes[ReportIndex].ReportID;
+			uint16_t ReportSize = USB_GetHIDReportSize(&ParserData.View, ReportID, ReportType);
+
+			if (!(ReportSize))
+			  continue;
+
+			if (ParserData.UsingReportIDs)
+			  ReportSize++;
+
+			for (uint8_t Sample = 0; Sample < BENCH_REPORTS_PER_ID; Sample++)
+			{
+				Bench_SampleReport_t* Report = &SampleReports[TotalSampleReports++];
+
+				Report->ReportType = ReportType;
+				Report->ReportSize = MIN(ReportSize, BENCH_MAX_REPORT_SIZE);
+
+				for (uint16_t ReportByte = 0; ReportByte < Report->ReportSize; ReportByte++)
+				  Report->ReportData[ReportByte] = rand();
+
+				if (ParserData.UsingReportIDs)
+				  Report->ReportData[0] = ReportID;
+			}
+		}
+	}
+
+	return ErrorCode;
+}
+
+/** Retrieves the current time for the benchmark timings.
+ *
+ *  \return Monotonic time in seconds.
+ */
+static double Bench_Seconds(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (Now.tv_sec + (Now.tv_nsec / 1e9));
+}
+
+/** Processes every descriptor of the corpus once. */
+static void Bench_ProcessCorpus(void)
+{
+	for (uint8_t EntryIndex = 0; EntryIndex < HID_CorpusEntries; EntryIndex++)
+	  BenchSink += USB_ProcessHIDReport(HID_Corpus[EntryIndex].Descriptor, HID_Corpus[EntryIndex].DescriptorSize, &CheckData);
+}
+
+/** Processes the current descriptor once, for the peak stack measurement of the parser. */
+static void Bench_ProcessEntry(void)
+{
+	BenchSink += USB_ProcessHIDReport(CurrentEntry->Descriptor, CurrentEntry->DescriptorSize, &CheckData);
+}
+
+/** Retrieves the values of every report item from each sample report, one item at a time as an application would. */
+static void Bench_ExtractReports(void)
+{
+	for (uint8_t ReportIndex = 0; ReportIndex < TotalSampleReports; ReportIndex++)
+	{
+		Bench_SampleReport_t* Report   = &SampleReports[ReportIndex];
+		uint8_t               ReportID = (ParserData.UsingReportIDs ? Report->ReportData[0] : 0);
+
+		BenchSink += USB_GetHIDReportSize(&ParserData.View, ReportID, Report->ReportType);
+
+		for (uint8_t ItemIndex = 0; ItemIndex < ParserData.TotalReportItems; ItemIndex++)
+		{
+			HID_ReportItem_t* ReportItem = &ParserData.ReportItems[ItemIndex];
+
+			if ((ReportItem->ItemType == Report->ReportType) && USB_GetHIDReportItemInfo(Report->ReportData, ReportItem))
+			  BenchSink += ReportItem->Value;
+		}
+	}
+}
+
+/** Decodes each sample report at once via the compiled decode plan for its report type. */
+static void Bench_DecodeReports(void)
+{
+	for (uint8_t ReportIndex = 0; ReportIndex < TotalSampleReports; ReportIndex++)
+	{
+		Bench_SampleReport_t* Report = &SampleReports[ReportIndex];
+
+		if (USB_DecodeHIDReport(&DecodePlans[Report->ReportType], Report->ReportData, &DecodedReport))
+		  BenchSink += DecodedReport.TotalValues;
+	}
+}
+
+/** Entry point of the painted stack context, running the task being measured. */
+static void Bench_StackTaskEntry(void)
+{
+	MeasureTask();
+}
+
+/** Measures the peak stack use of the given task, by running it on a painted stack and determining how much of the
+ *  paint was overwritten. The figure includes the small overhead of the context switch to the painted stack.
+ *
+ *  \param[in] Task  Task whose stack use is to be measured.
+ *
+ *  \return Peak stack use of the task in bytes.
+ */
+static uint32_t Bench_MeasurePeakStack(void (*Task)(void))
+{
+	uint32_t UntouchedBytes = 0;
+
+	memset(MeasureStack, BENCH_STACK_PAINT, sizeof(MeasureStack));
+
+	getcontext(&MeasureContext);
+	MeasureContext.uc_stack.ss_sp   = MeasureStack;
+	MeasureContext.uc_stack.ss_size = sizeof(MeasureStack);
+	MeasureContext.uc_link          = &MainContext;
+	makecontext(&MeasureContext, Bench_StackTaskEntry, 0);
+
+	MeasureTask = Task;
+	swapcontext(&MainContext, &MeasureContext);
+
+	/* The stack grows downwards, so the paint remains intact from the lowest address up to the deepest use */
+	while ((UntouchedBytes < sizeof(MeasureStack)) && (MeasureStack[UntouchedBytes] == BENCH_STACK_PAINT))
+	  UntouchedBytes++;
+
+	return (sizeof(MeasureStack) - UntouchedBytes);
+}
+
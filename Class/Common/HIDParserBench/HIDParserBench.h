@@ -0,0 +1,91 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for HIDParserBench.c.
+ */
+
+#ifndef _HID_PARSER_BENCH_H_
+#define _HID_PARSER_BENCH_H_
+
+	/* Includes: */
+		#include <stdio.h>
+		#include <stdlib.h>
+		#include <time.h>
+		#include <ucontext.h>
+
+		#include "HIDParserCorpus.h"
+		#include "HIDParserReference.h"
+
+	/* Macros: */
+		/** Minimum duration of each timed benchmark, in seconds. */
+		#define BENCH_MIN_SECONDS           0.5
+
+		/** Number of pseudo-random sample reports generated for each report ID and type of a descriptor. */
+		#define BENCH_REPORTS_PER_ID        4
+
+		/** Maximum number of sample reports generated for a single descriptor. */
+		#define BENCH_MAX_REPORTS           (HID_MAX_REPORT_IDS * 3 * BENCH_REPORTS_PER_ID)
+
+		/** Maximum size in bytes of a single sample report, including its report ID. */
+		#define BENCH_MAX_REPORT_SIZE       128
+
+		/** Size in bytes of the memory arena the descriptors are processed into for the arena parser checks. */
+		#define BENCH_ARENA_SIZE            (16 * 1024)
+
+		/** Size in bytes of the painted stack the peak stack measurements are run on. */
+		#define BENCH_STACK_SIZE            (64 * 1024)
+
+		/** Byte value the measurement stack is painted with before each stack measurement. */
+		#define BENCH_STACK_PAINT           0xA5
+
+	/* Type Defines: */
+		/** Type define for a pseudo-random sample report of a corpus descriptor. */
+		typedef struct
+		{
+			uint8_t  ReportType; /**< Type of the report, a value from the \ref HID_ReportItemTypes_t enum. */
+			uint16_t ReportSize; /**< Size in bytes of the report, including its report ID. */
+			uint8_t  ReportData[BENCH_MAX_REPORT_SIZE]; /**< Report data, prefixed by the report ID if the device uses them. */
+		} Bench_SampleReport_t;
+
+	/* Function Prototypes: */
+		static uint16_t Bench_CheckDescriptor(const HID_CorpusEntry_t* const Entry);
+		static uint8_t  Bench_PrepareDescriptor(const HID_CorpusEntry_t* const Entry);
+		static double   Bench_Seconds(void);
+		static void     Bench_ProcessCorpus(void);
+		static void     Bench_ProcessEntry(void);
+		static void     Bench_ExtractReports(void);
+		static void     Bench_DecodeReports(void);
+		static void     Bench_StackTaskEntry(void);
+		static uint32_t Bench_MeasurePeakStack(void (*Task)(void));
+
+#endif
+
@@ -0,0 +1,373 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Corpus of HID report descriptors for the HID parser benchmark and differential check. The descriptors follow
+ *  those of common real-world devices, and together exercise report IDs, signed and 32-bit global items, units,
+ *  nested collections, usage lists and ranges, and deeply nested PUSH/POP items.
+ */
+
+#include "HIDParserCorpus.h"
+
+/** Boot protocol keyboard with six key rollover and LED output report. */
+static const uint8_t Corpus_Keyboard[] =
+{
+	HID_DESCRIPTOR_KEYBOARD(6)
+};
+
+/** Three button relative mouse with 8-bit X/Y axes. */
+static const uint8_t Corpus_Mouse[] =
+{
+	HID_DESCRIPTOR_MOUSE(-127, 127, -1, 1, 3, false)
+};
+
+/** Gamepad with sixteen buttons, a hat switch with a null state, four signed axes and a rumble output report. */
+static const uint8_t Corpus_Gamepad[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x05),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_USAGE_PAGE(8, 0x09),
+		HID_RI_USAGE_MINIMUM(8, 0x01),
+		HID_RI_USAGE_MAXIMUM(8, 0x10),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x10),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_USAGE_PAGE(8, 0x01),
+		HID_RI_USAGE(8, 0x39),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x07),
+		HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+		HID_RI_PHYSICAL_MAXIMUM(16, 315),
+		HID_RI_UNIT(8, 0x14),
+		HID_RI_REPORT_SIZE(8, 0x04),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_NULLSTATE),
+		HID_RI_UNIT(8, 0x00),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE(8, 0x01),
+		HID_RI_COLLECTION(8, 0x00),
+			HID_RI_USAGE(8, 0x30),
+			HID_RI_USAGE(8, 0x31),
+			HID_RI_USAGE(8, 0x32),
+			HID_RI_USAGE(8, 0x35),
+			HID_RI_LOGICAL_MINIMUM(8, -127),
+			HID_RI_LOGICAL_MAXIMUM(8, 127),
+			HID_RI_PHYSICAL_MINIMUM(16, -1000),
+			HID_RI_PHYSICAL_MAXIMUM(16, 1000),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x04),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_END_COLLECTION(0),
+		HID_RI_USAGE_PAGE(16, 0xFF00),
+		HID_RI_USAGE(8, 0x01),
+		HID_RI_USAGE(8, 0x02),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+		HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+		HID_RI_PHYSICAL_MAXIMUM(8, 0x00),
+		HID_RI_REPORT_COUNT(8, 0x02),
+		HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Two contact multi-touch screen, with 16-bit X/Y coordinates in units of 0.01cm and a contact count maximum
+ *  feature report.
+ */
+static const uint8_t Corpus_Digitizer[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x0D),
+	HID_RI_USAGE(8, 0x04),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x01),
+		HID_RI_USAGE(8, 0x22),
+		HID_RI_COLLECTION(8, 0x02),
+			HID_RI_USAGE(8, 0x42),
+			HID_RI_USAGE(8, 0x32),
+			HID_RI_LOGICAL_MINIMUM(8, 0x00),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+			HID_RI_REPORT_SIZE(8, 0x01),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_COUNT(8, 0x06),
+			HID_RI_INPUT(8, HID_IOF_CONSTANT),
+			HID_RI_USAGE(8, 0x51),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x0F),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_PUSH(0),
+				HID_RI_USAGE_PAGE(8, 0x01),
+				HID_RI_USAGE(8, 0x30),
+				HID_RI_USAGE(8, 0x31),
+				HID_RI_LOGICAL_MAXIMUM(16, 4095),
+				HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+				HID_RI_PHYSICAL_MAXIMUM(16, 1500),
+				HID_RI_UNIT(8, 0x11),
+				HID_RI_UNIT_EXPONENT(8, 0x0E),
+				HID_RI_REPORT_SIZE(8, 0x10),
+				HID_RI_REPORT_COUNT(8, 0x02),
+				HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_POP(0),
+		HID_RI_END_COLLECTION(0),
+		HID_RI_USAGE(8, 0x22),
+		HID_RI_COLLECTION(8, 0x02),
+			HID_RI_USAGE(8, 0x42),
+			HID_RI_USAGE(8, 0x32),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+			HID_RI_REPORT_SIZE(8, 0x01),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_REPORT_COUNT(8, 0x06),
+			HID_RI_INPUT(8, HID_IOF_CONSTANT),
+			HID_RI_USAGE(8, 0x51),
+			HID_RI_LOGICAL_MAXIMUM(8, 0x0F),
+			HID_RI_REPORT_SIZE(8, 0x08),
+			HID_RI_REPORT_COUNT(8, 0x01),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_PUSH(0),
+				HID_RI_USAGE_PAGE(8, 0x01),
+				HID_RI_USAGE(8, 0x30),
+				HID_RI_USAGE(8, 0x31),
+				HID_RI_LOGICAL_MAXIMUM(16, 4095),
+				HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+				HID_RI_PHYSICAL_MAXIMUM(16, 1500),
+				HID_RI_UNIT(8, 0x11),
+				HID_RI_UNIT_EXPONENT(8, 0x0E),
+				HID_RI_REPORT_SIZE(8, 0x10),
+				HID_RI_REPORT_COUNT(8, 0x02),
+				HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_POP(0),
+		HID_RI_END_COLLECTION(0),
+		HID_RI_USAGE(8, 0x54),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x02),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_ID(8, 0x02),
+		HID_RI_USAGE(8, 0x55),
+		HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Vendor defined page device with 64 byte IN and OUT reports, as used for bootloaders and configuration tools. */
+static const uint8_t Corpus_Vendor[] =
+{
+	HID_DESCRIPTOR_VENDOR(0x00, 0x01, 0x02, 0x03, 64)
+};
+
+/** Composite keyboard, consumer control and system control device, distinguished by report ID. */
+static const uint8_t Corpus_MediaKeyboard[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x06),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x01),
+		HID_RI_USAGE_PAGE(8, 0x07),
+		HID_RI_USAGE_MINIMUM(8, 0xE0),
+		HID_RI_USAGE_MAXIMUM(8, 0xE7),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x08),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE_PAGE(8, 0x08),
+		HID_RI_USAGE_MINIMUM(8, 0x01),
+		HID_RI_USAGE_MAXIMUM(8, 0x05),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x05),
+		HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE | HID_IOF_NON_VOLATILE),
+		HID_RI_REPORT_SIZE(8, 0x03),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_OUTPUT(8, HID_IOF_CONSTANT),
+		HID_RI_USAGE_PAGE(8, 0x07),
+		HID_RI_USAGE_MINIMUM(8, 0x00),
+		HID_RI_USAGE_MAXIMUM(8, 0x65),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x65),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(8, 0x06),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_USAGE_PAGE(8, 0x0C),
+	HID_RI_USAGE(8, 0x01),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x02),
+		HID_RI_USAGE_MINIMUM(8, 0x00),
+		HID_RI_USAGE_MAXIMUM(16, 0x029C),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x029C),
+		HID_RI_REPORT_SIZE(8, 0x10),
+		HID_RI_REPORT_COUNT(8, 0x02),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_ARRAY | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x80),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x03),
+		HID_RI_USAGE_MINIMUM(8, 0x81),
+		HID_RI_USAGE_MAXIMUM(8, 0x83),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+		HID_RI_REPORT_SIZE(8, 0x01),
+		HID_RI_REPORT_COUNT(8, 0x03),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_REPORT_SIZE(8, 0x05),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_INPUT(8, HID_IOF_CONSTANT),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Vendor sensor device which nests PUSH items six deep, changing the report ID, report size, signed 32-bit logical
+ *  ranges and units within the nested global state, and restoring each on the matching POP.
+ */
+static const uint8_t Corpus_DeepPushPop[] =
+{
+	HID_RI_USAGE_PAGE(16, 0xFF10),
+	HID_RI_USAGE(8, 0x01),
+	HID_RI_COLLECTION(8, 0x01),
+		HID_RI_REPORT_ID(8, 0x10),
+		HID_RI_LOGICAL_MINIMUM(8, 0x00),
+		HID_RI_LOGICAL_MAXIMUM(16, 0x00FF),
+		HID_RI_REPORT_SIZE(8, 0x08),
+		HID_RI_REPORT_COUNT(8, 0x01),
+		HID_RI_USAGE(8, 0x10),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_PUSH(0),
+			HID_RI_LOGICAL_MINIMUM(8, -8),
+			HID_RI_LOGICAL_MAXIMUM(8, 7),
+			HID_RI_REPORT_SIZE(8, 0x04),
+			HID_RI_REPORT_COUNT(8, 0x02),
+			HID_RI_USAGE(8, 0x11),
+			HID_RI_USAGE(8, 0x12),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_PUSH(0),
+				HID_RI_USAGE_PAGE(8, 0x01),
+				HID_RI_LOGICAL_MINIMUM(32, -100000),
+				HID_RI_LOGICAL_MAXIMUM(32, 100000),
+				HID_RI_PHYSICAL_MINIMUM(16, -1000),
+				HID_RI_PHYSICAL_MAXIMUM(16, 1000),
+				HID_RI_UNIT(32, 0x0000E111),
+				HID_RI_UNIT_EXPONENT(8, 0x0D),
+				HID_RI_REPORT_SIZE(8, 0x20),
+				HID_RI_REPORT_COUNT(8, 0x01),
+				HID_RI_USAGE(8, 0x30),
+				HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+				HID_RI_PUSH(0),
+					HID_RI_REPORT_ID(8, 0x11),
+					HID_RI_USAGE_PAGE(8, 0x09),
+					HID_RI_LOGICAL_MINIMUM(8, 0x00),
+					HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+					HID_RI_PHYSICAL_MINIMUM(8, 0x00),
+					HID_RI_PHYSICAL_MAXIMUM(8, 0x00),
+					HID_RI_UNIT(8, 0x00),
+					HID_RI_UNIT_EXPONENT(8, 0x00),
+					HID_RI_REPORT_SIZE(8, 0x01),
+					HID_RI_REPORT_COUNT(8, 0x08),
+					HID_RI_USAGE_MINIMUM(8, 0x01),
+					HID_RI_USAGE_MAXIMUM(8, 0x08),
+					HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+					HID_RI_PUSH(0),
+						HID_RI_USAGE_PAGE(8, 0x01),
+						HID_RI_LOGICAL_MAXIMUM(16, 4095),
+						HID_RI_REPORT_SIZE(8, 0x0C),
+						HID_RI_REPORT_COUNT(8, 0x03),
+						HID_RI_USAGE_MINIMUM(8, 0x30),
+						HID_RI_USAGE_MAXIMUM(8, 0x32),
+						HID_RI_FEATURE(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+						HID_RI_PUSH(0),
+							HID_RI_USAGE_PAGE(16, 0xFF10),
+							HID_RI_LOGICAL_MAXIMUM(8, 0x7F),
+							HID_RI_REPORT_SIZE(8, 0x07),
+							HID_RI_REPORT_COUNT(8, 0x01),
+							HID_RI_USAGE(8, 0x20),
+							HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+							HID_RI_PUSH(0),
+								HID_RI_REPORT_SIZE(8, 0x01),
+								HID_RI_USAGE(8, 0x21),
+								HID_RI_OUTPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+							HID_RI_POP(0),
+						HID_RI_POP(0),
+						HID_RI_USAGE(8, 0x33),
+						HID_RI_REPORT_COUNT(8, 0x01),
+						HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+					HID_RI_POP(0),
+				HID_RI_POP(0),
+				HID_RI_USAGE(8, 0x31),
+				HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+			HID_RI_POP(0),
+			HID_RI_USAGE(8, 0x13),
+			HID_RI_USAGE(8, 0x14),
+			HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+		HID_RI_POP(0),
+		HID_RI_USAGE(8, 0x15),
+		HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
+	HID_RI_END_COLLECTION(0),
+};
+
+/** Malformed descriptor nesting more PUSH items than the state table stack can hold. */
+static const uint8_t Corpus_PushOverflow[] =
+{
+	HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0),
+	HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0),
+	HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0),
+	HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0), HID_RI_PUSH(0),
+};
+
+/** Malformed descriptor closing a collection that was never opened. */
+static const uint8_t Corpus_UnbalancedCollection[] =
+{
+	HID_RI_USAGE_PAGE(8, 0x01),
+	HID_RI_USAGE(8, 0x02),
+	HID_RI_COLLECTION(8, 0x01),
+	HID_RI_END_COLLECTION(0),
+	HID_RI_END_COLLECTION(0),
+};
+
+const HID_CorpusEntry_t HID_Corpus[] =
+{
+	{"Keyboard",             Corpus_Keyboard,             sizeof(Corpus_Keyboard),             HID_PARSE_Successful},
+	{"Mouse",                Corpus_Mouse,                sizeof(Corpus_Mouse),                HID_PARSE_Successful},
+	{"Gamepad",              Corpus_Gamepad,              sizeof(Corpus_Gamepad),              HID_PARSE_Successful},
+	{"Digitizer",            Corpus_Digitizer,            sizeof(Corpus_Digitizer),            HID_PARSE_Successful},
+	{"Vendor",               Corpus_Vendor,               sizeof(Corpus_Vendor),               HID_PARSE_Successful},
+	{"Media keyboard",       Corpus_MediaKeyboard,        sizeof(Corpus_MediaKeyboard),        HID_PARSE_Successful},
+	{"Deep PUSH/POP",        Corpus_DeepPushPop,          sizeof(Corpus_DeepPushPop),          HID_PARSE_Successful},
+	{"PUSH overflow",        Corpus_PushOverflow,         sizeof(Corpus_PushOverflow),         HID_PARSE_HIDStackOverflow},
+	{"Unbalanced collection", Corpus_UnbalancedCollection, sizeof(Corpus_UnbalancedCollection), HID_PARSE_UnexpectedEndCollection},
+};
+
+const uint8_t HID_CorpusEntries = (sizeof(HID_Corpus) / sizeof(HID_Corpus[0]));
+
@@ -0,0 +1,59 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for HIDParserCorpus.c.
+ */
+
+#ifndef _HID_PARSER_CORPUS_H_
+#define _HID_PARSER_CORPUS_H_
+
+	/* Includes: */
+		#define  __INCLUDE_FROM_USB_DRIVER
+		#define  __INCLUDE_FROM_HID_DRIVER
+		#include "../HIDParser.h"
+
+	/* Type Defines: */
+		/** Type define for a single report descriptor of the parser corpus. */
+		typedef struct
+		{
+			const char*    Name; /**< Human readable name of the descriptor. */
+			const uint8_t* Descriptor; /**< Report descriptor bytes, as returned by a device. */
+			uint16_t       DescriptorSize; /**< Size in bytes of the report descriptor. */
+			uint8_t        ExpectedErrorCode; /**< Value from the \ref HID_Parse_ErrorCodes_t enum the descriptor must parse with. */
+		} HID_CorpusEntry_t;
+
+	/* External Variables: */
+		extern const HID_CorpusEntry_t HID_Corpus[];
+		extern const uint8_t           HID_CorpusEntries;
+
+#endif
+
@@ -0,0 +1,615 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Reference implementations of the HID report parser routines, and differential checks of the library's parser
+ *  routines against them. The reference implementations are deliberately simple, and share no code with the library
+ *  routines they check.
+ */
+
+#define  __INCLUDE_FROM_HIDPARSERREFERENCE_C
+#include "HIDParserReference.h"
+
+uint8_t Reference_CheckReportParse(const uint8_t* ReportData,
+                                uint16_t ReportSize,
+                                HID_ReportInfo_t* const ReferenceData,
+                                HID_ReportInfo_t* const CheckData)
+{
+	HID_ParserState_t State;
+	uint16_t          Differences = 0;
+	uint8_t           ReferenceErrorCode;
+	uint8_t           CheckErrorCode;
+
+	ReferenceErrorCode = Reference_ProcessReport(ReportData, ReportSize, ReferenceData);
+
+	CheckErrorCode = USB_ProcessHIDReport(ReportData, ReportSize, CheckData);
+	Differences   += Reference_CompareReport(ReferenceErrorCode, &ReferenceData->View, CheckErrorCode, &CheckData->View);
+
+	USB_BeginHIDReportParse(&State, CheckData);
+
+	for (uint16_t ReportByte = 0; ReportByte < ReportSize; ReportByte++)
+	  USB_ParseHIDReportChunk(&State, &ReportData[ReportByte], 1);
+
+	CheckErrorCode = USB_EndHIDReportParse(&State);
+	Differences   += Reference_CompareReport(ReferenceErrorCode, &ReferenceData->View, CheckErrorCode, &CheckData->View);
+
+	return MIN(Differences, 0xFF);
+}
+
+uint8_t Reference_CheckReportArena(const uint8_t* ReportData,
+                                   uint16_t ReportSize,
+                                   HID_ReportInfo_t* const ReferenceData,
+                                   void* Arena,
+                                   const uint16_t ArenaSize,
+                                   HID_ArenaReportInfo_t* const ArenaData)
+{
+	uint16_t Differences = 0;
+	uint8_t  ReferenceErrorCode;
+	uint8_t  ArenaErrorCode;
+	uint16_t RequiredSize;
+
+	ReferenceErrorCode = Reference_ProcessReport(ReportData, ReportSize, ReferenceData);
+
+	/* The arena output is not bounded by the fixed size arrays, so descriptors exceeding them are not compared */
+	if ((ReferenceErrorCode == HID_PARSE_InsufficientReportItems)     ||
+	    (ReferenceErrorCode == HID_PARSE_InsufficientCollectionPaths) ||
+	    (ReferenceErrorCode == HID_PARSE_InsufficientReportIDItems))
+	{
+		return 0;
+	}
+
+	ArenaErrorCode = USB_ProcessHIDReportArena(ReportData, ReportSize, NULL, 0, ArenaData);
+	RequiredSize   = ArenaData->ArenaBytesUsed;
+
+	if (ArenaErrorCode != HID_PARSE_Successful)
+	  return (ArenaErrorCode != ReferenceErrorCode);
+
+	if (RequiredSize > ArenaSize)
+	  return 1;
+
+	if (RequiredSize && (USB_ProcessHIDReportArena(ReportData, ReportSize, Arena, (RequiredSize - 1), ArenaData) !=
+	                     HID_PARSE_InsufficientArenaSpace))
+	{
+		Differences++;
+	}
+
+	ArenaErrorCode = USB_ProcessHIDReportArena(ReportData, ReportSize, Arena, RequiredSize, ArenaData);
+	Differences   += Reference_CompareReport(ReferenceErrorCode, &ReferenceData->View, ArenaErrorCode, ArenaData);
+
+	if (ArenaData->ArenaBytesUsed > RequiredSize)
+	  Differences++;
+
+	return MIN(Differences, 0xFF);
+}
+
+uint8_t Reference_CheckReportItems(const HID_ArenaReportInfo_t* const ParserData,
+                                   const HID_DecodePlan_t* const Plan,
+                                   const uint8_t ReportType,
+                                   const uint8_t* ReportData)
+{
+	HID_DecodedReport_t Decoded;
+	uint8_t             Differences = 0;
+	uint8_t             ReportID    = (ParserData->UsingReportIDs ? ReportData[0] : 0);
+	uint16_t            ReportSize  = (USB_GetHIDReportSize(ParserData, ReportID, ReportType) + (ReportID ? 1 : 0));
+	uint8_t             RebuiltReport[ReportSize];
+	uint8_t             DecodedValues = 0;
+
+	if (USB_DecodeHIDReport(Plan, ReportData, &Decoded))
+	  DecodedValues = Decoded.TotalValues;
+
+	memset(RebuiltReport, 0x00, ReportSize);
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem    = &ParserData->ReportItems[ItemIndex];
+		uint32_t          Value         = ReportItem->Value;
+		uint32_t          PreviousValue = ReportItem->PreviousValue;
+
+		if ((ReportItem->ItemType != ReportType) || (ReportItem->ReportID != ReportID))
+		  continue;
+
+		uint32_t ReferenceValue = Reference_GetItemValue(&ReportData[ReportID ? 1 : 0], ReportItem);
+
+		if (!(USB_GetHIDReportItemInfo(ReportData, ReportItem)) || (ReportItem->Value != ReferenceValue))
+		  Differences++;
+
+		ReportItem->Value = ReferenceValue;
+		USB_SetHIDReportItemInfo(RebuiltReport, ReportItem);
+
+		bool DecodedFound = false;
+
+		for (uint8_t DecodedIndex = 0; DecodedIndex < DecodedValues; DecodedIndex++)
+		{
+			if (Decoded.ItemIndexes[DecodedIndex] == ItemIndex)
+			{
+				DecodedFound = true;
+
+				if (Decoded.Values[DecodedIndex] != ReferenceValue)
+				  Differences++;
+			}
+		}
+
+		if (!(DecodedFound))
+		  Differences++;
+
+		ReportItem->Value         = Value;
+		ReportItem->PreviousValue = PreviousValue;
+
+		/* The rebuilt report must hold the same data as the original report for every bit of the item */
+		if (Reference_GetItemValue(&RebuiltReport[ReportID ? 1 : 0], ReportItem) != ReferenceValue)
+		  Differences++;
+	}
+
+	return Differences;
+}
+
+uint8_t Reference_CheckUsageIndex(const HID_ArenaReportInfo_t* const ParserData,
+                                  HID_UsageIndex_t* const Index)
+{
+	uint16_t Differences = 0;
+
+	if (!(USB_BuildHIDUsageIndex(ParserData, Index)))
+	  return ((ParserData->TotalReportItems <= HID_MAX_REPORTITEMS) && (ParserData->TotalCollectionPaths <= HID_MAX_COLLECTIONS));
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		const HID_ReportItem_t* ReportItem   = &ParserData->ReportItems[ItemIndex];
+		uint16_t                UsagePage    = ReportItem->Attributes.Usage.Page;
+		uint16_t                UsageMinimum = ReportItem->Attributes.Usage.Usage;
+		uint16_t                UsageMaximum = (UsageMinimum + REFERENCE_USAGE_RANGE);
+		uint8_t                 FirstEntry;
+		uint8_t                 TotalEntries;
+		uint8_t                 RangeItems   = 0;
+
+		/* Each item's own usage must be located, and the following usage located only if some item has it */
+		for (uint8_t UsageOffset = 0; UsageOffset < 2; UsageOffset++)
+		{
+			uint16_t Usage = (UsageMinimum + UsageOffset);
+
+			if (USB_FindHIDReportItem(ParserData, Index, UsagePage, Usage, ReportItem->ItemType, ReportItem->ReportID) !=
+			    Reference_FindItem(ParserData, UsagePage, Usage, ReportItem->ItemType, ReportItem->ReportID))
+			{
+				Differences++;
+			}
+		}
+
+		TotalEntries = USB_FindHIDUsageRange(Index, UsagePage, UsageMinimum, UsageMaximum, &FirstEntry);
+
+		for (uint8_t EntryIndex = FirstEntry; EntryIndex < (FirstEntry + TotalEntries); EntryIndex++)
+		{
+			const HID_ReportItem_t* RangeItem = &ParserData->ReportItems[Index->UsageEntries[EntryIndex].ItemIndex];
+
+			if ((RangeItem->Attributes.Usage.Page != UsagePage) || (RangeItem->Attributes.Usage.Usage < UsageMinimum) ||
+			    (RangeItem->Attributes.Usage.Usage > UsageMaximum))
+			{
+				Differences++;
+			}
+		}
+
+		for (uint8_t RangeIndex = 0; RangeIndex < ParserData->TotalReportItems; RangeIndex++)
+		{
+			const HID_ReportItem_t* RangeItem = &ParserData->ReportItems[RangeIndex];
+
+			if ((RangeItem->Attributes.Usage.Page == UsagePage) && (RangeItem->Attributes.Usage.Usage >= UsageMinimum) &&
+			    (RangeItem->Attributes.Usage.Usage <= UsageMaximum))
+			{
+				RangeItems++;
+			}
+		}
+
+		if (TotalEntries != RangeItems)
+		  Differences++;
+	}
+
+	for (uint8_t CollectionIndex = 0; CollectionIndex < ParserData->TotalCollectionPaths; CollectionIndex++)
+	{
+		const HID_CollectionPath_t* CollectionPath  = &ParserData->CollectionPaths[CollectionIndex];
+		uint8_t                     CollectionItems = 0;
+		uint8_t                     FirstEntry;
+		uint8_t                     TotalEntries;
+
+		TotalEntries = USB_FindHIDCollectionItems(ParserData, Index, CollectionPath, &FirstEntry);
+
+		for (uint8_t EntryIndex = FirstEntry; EntryIndex < (FirstEntry + TotalEntries); EntryIndex++)
+		{
+			if (!(Reference_InCollection(&ParserData->ReportItems[Index->CollectionEntries[EntryIndex].ItemIndex], CollectionPath)))
+			  Differences++;
+		}
+
+		for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+		{
+			if (Reference_InCollection(&ParserData->ReportItems[ItemIndex], CollectionPath))
+			  CollectionItems++;
+		}
+
+		if (TotalEntries != CollectionItems)
+		  Differences++;
+	}
+
+	return MIN(Differences, 0xFF);
+}
+
+static uint32_t Reference_GetItemValue(const uint8_t* ReportData,
+                                          const HID_ReportItem_t* const ReportItem)
+{
+	uint8_t  BitSize = MIN(ReportItem->Attributes.BitSize, 32);
+	uint32_t Value   = 0;
+
+	for (uint8_t BitIndex = 0; BitIndex < BitSize; BitIndex++)
+	{
+		uint16_t CurrentBit = (ReportItem->BitOffset + BitIndex);
+
+		if (ReportData[CurrentBit / 8] & (1 << (CurrentBit % 8)))
+		  Value |= (1UL << BitIndex);
+	}
+
+	if (BitSize && (BitSize < 32) && ((int32_t)ReportItem->Attributes.Logical.Minimum < 0) && (Value & (1UL << (BitSize - 1))))
+	  Value |= ~((1UL << BitSize) - 1);
+
+	return Value;
+}
+
+static HID_ReportItem_t* Reference_FindItem(const HID_ArenaReportInfo_t* const ParserData,
+                                            const uint16_t UsagePage,
+                                            const uint16_t Usage,
+                                            const uint8_t ItemType,
+                                            const uint8_t ReportID)
+{
+	for (uint8_t ItemIndex = 0; ItemIndex < ParserData->TotalReportItems; ItemIndex++)
+	{
+		HID_ReportItem_t* ReportItem = &ParserData->ReportItems[ItemIndex];
+
+		if ((ReportItem->Attributes.Usage.Page == UsagePage) && (ReportItem->Attributes.Usage.Usage == Usage) &&
+		    (ReportItem->ItemType == ItemType) && (ReportItem->ReportID == ReportID))
+		{
+			return ReportItem;
+		}
+	}
+
+	return NULL;
+}
+
+static bool Reference_InCollection(const HID_ReportItem_t* const ReportItem,
+                                   const HID_CollectionPath_t* const CollectionPath)
+{
+	for (const HID_CollectionPath_t* Parent = ReportItem->CollectionPath; Parent != NULL; Parent = Parent->Parent)
+	{
+		if (Parent == CollectionPath)
+		  return true;
+	}
+
+	return false;
+}
+
+static uint8_t Reference_ProcessReport(const uint8_t* ReportData,
+                                          uint16_t ReportSize,
+                                          HID_ReportInfo_t* const ParserData)
+{
+	/* Deliberately simple second implementation of the descriptor parser, sharing none of the item fetching, state
+	 * table or output handling of the parser under test so that the two may be checked against one another */
+	Reference_Globals_t Globals[HID_STATETABLE_STACK_DEPTH];
+	uint8_t                GlobalDepth = 0;
+	uint16_t               Usages[HID_USAGE_STACK_DEPTH];
+	uint8_t                TotalUsages = 0;
+	uint8_t                NextUsage   = 0;
+	uint32_t               UsageMinimum = 0;
+	uint32_t               UsageMaximum = 0;
+	uint8_t                OpenCollections[HID_MAX_COLLECTIONS];
+	uint8_t                CollectionDepth = 0;
+	uint8_t                CurrentReport   = 0;
+	uint16_t               ItemStart       = 0;
+
+	memset(ParserData, 0x00, sizeof(HID_ReportInfo_t));
+	memset(&Globals[0], 0x00, sizeof(Reference_Globals_t));
+
+	HID_ArenaReportInfo_t* Output = &ParserData->View;
+
+	Output->ReportItems        = ParserData->ReportItems;
+	Output->MaxReportItems     = HID_MAX_REPORTITEMS;
+	Output->CollectionPaths    = ParserData->CollectionPaths;
+	Output->MaxCollectionPaths = HID_MAX_COLLECTIONS;
+	Output->ReportIDSizes      = ParserData->ReportIDSizes;
+	Output->MaxDeviceReports   = HID_MAX_REPORT_IDS;
+
+	Output->TotalDeviceReports = 1;
+
+	while (ItemStart < ReportSize)
+	{
+		Reference_Globals_t* Global    = &Globals[GlobalDepth];
+		uint8_t                 Prefix    = ReportData[ItemStart];
+		uint8_t                 DataBytes = (((Prefix & 0x03) == 0x03) ? 4 : (Prefix & 0x03));
+		uint32_t                Data      = 0;
+		uint32_t                SignedData;
+
+		for (uint8_t DataByte = 0; (DataByte < DataBytes) && ((ItemStart + 1 + DataByte) < ReportSize); DataByte++)
+		  Data |= ((uint32_t)ReportData[ItemStart + 1 + DataByte] << (8 * DataByte));
+
+		ItemStart += (1 + DataBytes);
+
+		if (DataBytes == 1)
+		  SignedData = (uint32_t)(int32_t)(int8_t)Data;
+		else if (DataBytes == 2)
+		  SignedData = (uint32_t)(int32_t)(int16_t)Data;
+		else
+		  SignedData = Data;
+
+		switch (Prefix & 0xFC)
+		{
+			case HID_RI_PUSH(0):
+				if (GlobalDepth == (HID_STATETABLE_STACK_DEPTH - 1))
+				  return HID_PARSE_HIDStackOverflow;
+
+				Globals[GlobalDepth + 1] = Globals[GlobalDepth];
+				GlobalDepth++;
+				break;
+			case HID_RI_POP(0):
+				if (!(GlobalDepth))
+				  return HID_PARSE_HIDStackUnderflow;
+
+				GlobalDepth--;
+
+				for (uint8_t Report = 0; Output->UsingReportIDs && (Report < Output->TotalDeviceReports); Report++)
+				{
+					if (Output->ReportIDSizes[Report].ReportID == Globals[GlobalDepth].ReportID)
+					  CurrentReport = Report;
+				}
+
+				break;
+			case HID_RI_USAGE_PAGE(0):
+				Global->UsagePage = Data;
+				break;
+			case HID_RI_LOGICAL_MINIMUM(0):
+				Global->LogicalMinimum = SignedData;
+				break;
+			case HID_RI_LOGICAL_MAXIMUM(0):
+				Global->LogicalMaximum = (((int32_t)Global->LogicalMinimum < 0) ? SignedData : Data);
+				break;
+			case HID_RI_PHYSICAL_MINIMUM(0):
+				Global->PhysicalMinimum = SignedData;
+				break;
+			case HID_RI_PHYSICAL_MAXIMUM(0):
+				Global->PhysicalMaximum = (((int32_t)Global->PhysicalMinimum < 0) ? SignedData : Data);
+				break;
+			case HID_RI_UNIT_EXPONENT(0):
+				Global->UnitExponent = Data;
+				break;
+			case HID_RI_UNIT(0):
+				Global->Unit = Data;
+				break;
+			case HID_RI_REPORT_SIZE(0):
+				Global->ReportSize = Data;
+				break;
+			case HID_RI_REPORT_COUNT(0):
+				Global->ReportCount = Data;
+				break;
+			case HID_RI_REPORT_ID(0):
+				Global->ReportID = Data;
+
+				/* Items before the first REPORT ID belong to the first report, whatever its ID */
+				if (Output->UsingReportIDs)
+				{
+					for (CurrentReport = 0; CurrentReport < Output->TotalDeviceReports; CurrentReport++)
+					{
+						if (Output->ReportIDSizes[CurrentReport].ReportID == Global->ReportID)
+						  break;
+					}
+
+					if (CurrentReport == Output->TotalDeviceReports)
+					{
+						if (Output->TotalDeviceReports == HID_MAX_REPORT_IDS)
+						  return HID_PARSE_InsufficientReportIDItems;
+
+						Output->TotalDeviceReports++;
+					}
+				}
+
+				Output->UsingReportIDs = true;
+				Output->ReportIDSizes[CurrentReport].ReportID = Global->ReportID;
+				break;
+			case HID_RI_USAGE(0):
+				if (TotalUsages == HID_USAGE_STACK_DEPTH)
+				  return HID_PARSE_UsageListOverflow;
+
+				Usages[TotalUsages++] = Data;
+				break;
+			case HID_RI_USAGE_MINIMUM(0):
+				UsageMinimum = Data;
+				break;
+			case HID_RI_USAGE_MAXIMUM(0):
+				UsageMaximum = Data;
+				break;
+			case HID_RI_COLLECTION(0):
+				if (Output->TotalCollectionPaths == HID_MAX_COLLECTIONS)
+				  return HID_PARSE_InsufficientCollectionPaths;
+
+				HID_CollectionPath_t* Collection = &Output->CollectionPaths[Output->TotalCollectionPaths];
+
+				Collection->Type       = Data;
+				Collection->Usage.Page = Global->UsagePage;
+				Collection->Parent     = (CollectionDepth ? &Output->CollectionPaths[OpenCollections[CollectionDepth - 1]] : NULL);
+
+				if (NextUsage < TotalUsages)
+				  Collection->Usage.Usage = Usages[NextUsage++];
+				else if (UsageMinimum <= UsageMaximum)
+				  Collection->Usage.Usage = UsageMinimum++;
+
+				OpenCollections[CollectionDepth++] = Output->TotalCollectionPaths++;
+				break;
+			case HID_RI_END_COLLECTION(0):
+				if (!(CollectionDepth))
+				  return HID_PARSE_UnexpectedEndCollection;
+
+				CollectionDepth--;
+				break;
+			case HID_RI_INPUT(0):
+			case HID_RI_OUTPUT(0):
+			case HID_RI_FEATURE(0):
+				for (uint8_t Count = 0; Count < Global->ReportCount; Count++)
+				{
+					HID_ReportSizeInfo_t* Report = &Output->ReportIDSizes[CurrentReport];
+					HID_ReportItem_t      Item;
+
+					memset(&Item, 0x00, sizeof(HID_ReportItem_t));
+
+					if ((Prefix & 0xFC) == HID_RI_INPUT(0))
+					  Item.ItemType = HID_REPORT_ITEM_In;
+					else if ((Prefix & 0xFC) == HID_RI_OUTPUT(0))
+					  Item.ItemType = HID_REPORT_ITEM_Out;
+					else
+					  Item.ItemType = HID_REPORT_ITEM_Feature;
+
+					Item.BitOffset                    = Report->ReportSizeBits[Item.ItemType];
+					Item.ItemFlags                    = Data;
+					Item.ReportID                     = Global->ReportID;
+					Item.CollectionPath               = (CollectionDepth ? &Output->CollectionPaths[OpenCollections[CollectionDepth - 1]] : NULL);
+					Item.Attributes.BitSize           = Global->ReportSize;
+					Item.Attributes.Usage.Page        = Global->UsagePage;
+					Item.Attributes.Unit.Type         = Global->Unit;
+					Item.Attributes.Unit.Exponent     = Global->UnitExponent;
+					Item.Attributes.Logical.Minimum   = Global->LogicalMinimum;
+					Item.Attributes.Logical.Maximum   = Global->LogicalMaximum;
+					Item.Attributes.Physical.Minimum  = Global->PhysicalMinimum;
+					Item.Attributes.Physical.Maximum  = Global->PhysicalMaximum;
+
+					if (NextUsage < TotalUsages)
+					  Item.Attributes.Usage.Usage = Usages[NextUsage++];
+					else if (UsageMinimum <= UsageMaximum)
+					  Item.Attributes.Usage.Usage = UsageMinimum++;
+
+					Report->ReportSizeBits[Item.ItemType] += Global->ReportSize;
+
+					if (Output->LargestReportSizeBits < Item.BitOffset)
+					  Output->LargestReportSizeBits = Item.BitOffset;
+
+					if ((Data & HID_IOF_CONSTANT) || !(CALLBACK_HIDParser_FilterHIDReportItem(&Item)))
+					  continue;
+
+					if (Output->TotalReportItems == HID_MAX_REPORTITEMS)
+					  return HID_PARSE_InsufficientReportItems;
+
+					Output->ReportItems[Output->TotalReportItems++] = Item;
+				}
+
+				break;
+		}
+
+		/* Local items only apply to the main item that follows them */
+		if (!(Prefix & HID_RI_TYPE_MASK))
+		{
+			TotalUsages  = 0;
+			NextUsage    = 0;
+			UsageMinimum = 0;
+			UsageMaximum = 0;
+		}
+	}
+
+	if (!(Output->TotalReportItems))
+	  return HID_PARSE_NoUnfilteredReportItems;
+
+	return HID_PARSE_Successful;
+}
+
+static uint16_t Reference_CompareReport(const uint8_t ReferenceErrorCode,
+                                           const HID_ArenaReportInfo_t* const ReferenceData,
+                                           const uint8_t CheckErrorCode,
+                                           const HID_ArenaReportInfo_t* const CheckData)
+{
+	uint16_t Differences = 0;
+
+	if (ReferenceErrorCode != CheckErrorCode)
+	  return 1;
+
+	/* The output of a failed parse is incomplete, so only the error codes of failed parses are compared */
+	if (ReferenceErrorCode != HID_PARSE_Successful)
+	  return 0;
+
+	if ((ReferenceData->TotalReportItems      != CheckData->TotalReportItems)      ||
+	    (ReferenceData->TotalCollectionPaths  != CheckData->TotalCollectionPaths)  ||
+	    (ReferenceData->TotalDeviceReports    != CheckData->TotalDeviceReports)    ||
+	    (ReferenceData->LargestReportSizeBits != CheckData->LargestReportSizeBits) ||
+	    (ReferenceData->UsingReportIDs        != CheckData->UsingReportIDs))
+	{
+		return 1;
+	}
+
+	for (uint8_t ItemIndex = 0; ItemIndex < ReferenceData->TotalReportItems; ItemIndex++)
+	{
+		const HID_ReportItem_t*            ReferenceItem       = &ReferenceData->ReportItems[ItemIndex];
+		const HID_ReportItem_t*            CheckItem           = &CheckData->ReportItems[ItemIndex];
+		const HID_ReportItem_Attributes_t* ReferenceAttributes = &ReferenceItem->Attributes;
+		const HID_ReportItem_Attributes_t* CheckAttributes     = &CheckItem->Attributes;
+
+		if ((ReferenceItem->BitOffset != CheckItem->BitOffset) || (ReferenceItem->ItemType != CheckItem->ItemType) ||
+		    (ReferenceItem->ItemFlags != CheckItem->ItemFlags) || (ReferenceItem->ReportID != CheckItem->ReportID) ||
+		    (REFERENCE_PATH_INDEX(ReferenceData, ReferenceItem->CollectionPath) != REFERENCE_PATH_INDEX(CheckData, CheckItem->CollectionPath)) ||
+		    (ReferenceAttributes->BitSize          != CheckAttributes->BitSize)          ||
+		    (ReferenceAttributes->Usage.Page       != CheckAttributes->Usage.Page)       ||
+		    (ReferenceAttributes->Usage.Usage      != CheckAttributes->Usage.Usage)      ||
+		    (ReferenceAttributes->Unit.Type        != CheckAttributes->Unit.Type)        ||
+		    (ReferenceAttributes->Unit.Exponent    != CheckAttributes->Unit.Exponent)    ||
+		    (ReferenceAttributes->Logical.Minimum  != CheckAttributes->Logical.Minimum)  ||
+		    (ReferenceAttributes->Logical.Maximum  != CheckAttributes->Logical.Maximum)  ||
+		    (ReferenceAttributes->Physical.Minimum != CheckAttributes->Physical.Minimum) ||
+		    (ReferenceAttributes->Physical.Maximum != CheckAttributes->Physical.Maximum))
+		{
+			Differences++;
+		}
+	}
+
+	for (uint8_t CollectionIndex = 0; CollectionIndex < ReferenceData->TotalCollectionPaths; CollectionIndex++)
+	{
+		const HID_CollectionPath_t* ReferenceCollection = &ReferenceData->CollectionPaths[CollectionIndex];
+		const HID_CollectionPath_t* CheckCollection     = &CheckData->CollectionPaths[CollectionIndex];
+
+		if ((ReferenceCollection->Type        != CheckCollection->Type)       ||
+		    (ReferenceCollection->Usage.Page  != CheckCollection->Usage.Page) ||
+		    (ReferenceCollection->Usage.Usage != CheckCollection->Usage.Usage) ||
+		    (REFERENCE_PATH_INDEX(ReferenceData, ReferenceCollection->Parent) != REFERENCE_PATH_INDEX(CheckData, CheckCollection->Parent)))
+		{
+			Differences++;
+		}
+	}
+
+	for (uint8_t ReportIndex = 0; ReportIndex < ReferenceData->TotalDeviceReports; ReportIndex++)
+	{
+		const HID_ReportSizeInfo_t* ReferenceReport = &ReferenceData->ReportIDSizes[ReportIndex];
+		const HID_ReportSizeInfo_t* CheckReport     = &CheckData->ReportIDSizes[ReportIndex];
+
+		if ((ReferenceReport->ReportID != CheckReport->ReportID) ||
+		    memcmp(ReferenceReport->ReportSizeBits, CheckReport->ReportSizeBits, sizeof(ReferenceReport->ReportSizeBits)))
+		{
+			Differences++;
+		}
+	}
+
+	return Differences;
+}
+
@@ -0,0 +1,156 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for HIDParserReference.c.
+ */
+
+#ifndef _HID_PARSER_REFERENCE_H_
+#define _HID_PARSER_REFERENCE_H_
+
+	/* Includes: */
+		#define  __INCLUDE_FROM_USB_DRIVER
+		#define  __INCLUDE_FROM_HID_DRIVER
+		#include "../HIDParser.h"
+
+	/* Macros: */
+		/** Number of usages following each item's own usage which are included in the usage range lookup checks. */
+		#define REFERENCE_USAGE_RANGE            3
+
+		/** Index of the given collection within the given parser output's \c CollectionPaths array, or -1 for none. */
+		#define REFERENCE_PATH_INDEX(ParserData, Path)  ((Path) ? ((Path) - (ParserData)->CollectionPaths) : -1)
+
+	/* Type Defines: */
+		/** Type define for the global item state of the reference parser. */
+		typedef struct
+		{
+			uint16_t UsagePage; /**< Current USAGE PAGE. */
+			uint32_t LogicalMinimum; /**< Current LOGICAL MINIMUM. */
+			uint32_t LogicalMaximum; /**< Current LOGICAL MAXIMUM. */
+			uint32_t PhysicalMinimum; /**< Current PHYSICAL MINIMUM. */
+			uint32_t PhysicalMaximum; /**< Current PHYSICAL MAXIMUM. */
+			uint32_t Unit; /**< Current UNIT. */
+			uint8_t  UnitExponent; /**< Current UNIT EXPONENT. */
+			uint8_t  ReportSize; /**< Current REPORT SIZE, in bits. */
+			uint8_t  ReportCount; /**< Current REPORT COUNT. */
+			uint8_t  ReportID; /**< Current REPORT ID. */
+		} Reference_Globals_t;
+
+	/* Function Prototypes: */
+		/** Differential check of the report descriptor parser. The given descriptor is first processed by a simple,
+		 *  separately written reference parser. It is then processed in a single pass via \ref USB_ProcessHIDReport(),
+		 *  and again one byte at a time via \ref USB_ParseHIDReportChunk(), and each result compared against that of the
+		 *  reference parser.
+		 *
+		 *  \param[in]  ReportData     Buffer containing the device's HID report table.
+		 *  \param[in]  ReportSize     Size in bytes of the HID report table.
+		 *  \param[out] ReferenceData  Pointer to a \ref HID_ReportInfo_t instance for the reference parser output.
+		 *  \param[out] CheckData      Pointer to a \ref HID_ReportInfo_t instance for the checked parser output.
+		 *
+		 *  \return Number of differences found between the reference and checked parser outputs.
+		 */
+		uint8_t Reference_CheckReportParse(const uint8_t* ReportData,
+		                                   uint16_t ReportSize,
+		                                   HID_ReportInfo_t* const ReferenceData,
+		                                   HID_ReportInfo_t* const CheckData);
+
+		/** Differential check of the arena report descriptor parser. The arena size required by the given descriptor is
+		 *  determined via \ref USB_ProcessHIDReportArena() without an arena, and an arena one byte smaller must then be
+		 *  rejected. The descriptor processed into an arena of exactly the required size is compared against the output
+		 *  of the reference parser. Descriptors which exceed the fixed size arrays of the reference output are not checked.
+		 *
+		 *  \param[in]  ReportData     Buffer containing the device's HID report table.
+		 *  \param[in]  ReportSize     Size in bytes of the HID report table.
+		 *  \param[out] ReferenceData  Pointer to a \ref HID_ReportInfo_t instance for the reference parser output.
+		 *  \param[in]  Arena          Pointer aligned memory arena for the checked parser output.
+		 *  \param[in]  ArenaSize      Size in bytes of the memory arena.
+		 *  \param[out] ArenaData      Pointer to a \ref HID_ArenaReportInfo_t instance for the checked parser output.
+		 *
+		 *  \return Number of differences found between the reference and checked parser outputs.
+		 */
+		uint8_t Reference_CheckReportArena(const uint8_t* ReportData,
+		                                   uint16_t ReportSize,
+		                                   HID_ReportInfo_t* const ReferenceData,
+		                                   void* Arena,
+		                                   const uint16_t ArenaSize,
+		                                   HID_ArenaReportInfo_t* const ArenaData);
+
+		/** Differential check of the report item value extraction and insertion routines. Each item of the given report
+		 *  is extracted by a simple bit at a time reference implementation, and compared against the values retrieved
+		 *  via \ref USB_GetHIDReportItemInfo() and \ref USB_DecodeHIDReport(). Each value is then inserted into a
+		 *  copy of the report via \ref USB_SetHIDReportItemInfo(), which must reproduce the original report data.
+		 *  The report items' \c Value and \c PreviousValue elements are left unchanged.
+		 *
+		 *  \param[in] ParserData  Pointer to the parser output, or the \c View element of a \ref HID_ReportInfo_t.
+		 *  \param[in] Plan        Pointer to a \ref HID_DecodePlan_t compiled from the parser output for the report type.
+		 *  \param[in] ReportType  Type of the report, a value from the \ref HID_ReportItemTypes_t enum.
+		 *  \param[in] ReportData  Buffer containing a report of the given type, including any report ID.
+		 *
+		 *  \return Number of differences found between the reference implementation and the checked routines.
+		 */
+		uint8_t Reference_CheckReportItems(const HID_ArenaReportInfo_t* const ParserData,
+		                                   const HID_DecodePlan_t* const Plan,
+		                                   const uint8_t ReportType,
+		                                   const uint8_t* ReportData);
+
+		/** Differential check of the usage index lookups. An index is built over the given parser output, and the
+		 *  results of \ref USB_FindHIDReportItem(), \ref USB_FindHIDUsageRange() and \ref USB_FindHIDCollectionItems()
+		 *  for the usages and collections of the output are compared against a linear scan of its report items.
+		 *
+		 *  \param[in]  ParserData  Pointer to the parser output, or the \c View element of a \ref HID_ReportInfo_t.
+		 *  \param[out] Index       Pointer to a \ref HID_UsageIndex_t instance for the index of the parser output.
+		 *
+		 *  \return Number of differences found between the index lookups and the linear scan.
+		 */
+		uint8_t Reference_CheckUsageIndex(const HID_ArenaReportInfo_t* const ParserData,
+		                                  HID_UsageIndex_t* const Index);
+
+		#if defined(__INCLUDE_FROM_HIDPARSERREFERENCE_C)
+			static uint32_t Reference_GetItemValue(const uint8_t* ReportData,
+			                                       const HID_ReportItem_t* const ReportItem);
+			static HID_ReportItem_t* Reference_FindItem(const HID_ArenaReportInfo_t* const ParserData,
+			                                            const uint16_t UsagePage,
+			                                            const uint16_t Usage,
+			                                            const uint8_t ItemType,
+			                                            const uint8_t ReportID);
+			static bool Reference_InCollection(const HID_ReportItem_t* const ReportItem,
+			                                   const HID_CollectionPath_t* const CollectionPath);
+			static uint8_t Reference_ProcessReport(const uint8_t* ReportData,
+			                                       uint16_t ReportSize,
+			                                       HID_ReportInfo_t* const ParserData);
+			static uint16_t Reference_CompareReport(const uint8_t ReferenceErrorCode,
+			                                        const HID_ArenaReportInfo_t* const ReferenceData,
+			                                        const uint8_t CheckErrorCode,
+			                                        const HID_ArenaReportInfo_t* const CheckData);
+		#endif
+
+#endif
+
@@ -0,0 +1,154 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host stand-in for the LPC134x register header, so that the USB driver can be built with the host compiler. The
+ *  USB controller's command and data port registers are routed to the \c Host_* functions of a simulated controller,
+ *  which benches running the driver, such as the LPC13xx enumeration bench, must supply; benches which only build
+ *  against the driver headers never access them, and so need not define them. The system control, pin and interrupt
+ *  controller registers used to start the USB controller are plain variables of the simulation.
+ *
+ *  Builds defining the \c LPC13XX_HOST_SIMULATION token also take the core's interrupt mask from the simulation.
+ */
+
+#ifndef _HOST_LPC134X_H_
+#define _HOST_LPC134X_H_
+
+	/* Includes: */
+		#include <stdint.h>
+
+	/* Macros: */
+		/** \name Simulated USB Controller Registers */
+		//@{
+		#define USB_CMDCODE                      (*Host_WriteRegister(HOST_REGISTER_CMDCODE))
+		#define USB_CMDDATA                      (Host_ReadRegister(HOST_REGISTER_CMDDATA))
+		#define USB_DEVINTCLR                    (*Host_WriteRegister(HOST_REGISTER_DEVINTCLR))
+		#define USB_DEVINTST                     (Host_ReadRegister(HOST_REGISTER_DEVINTST))
+		#define USB_RXPLEN                       (Host_ReadRegister(HOST_REGISTER_RXPLEN))
+		#define USB_RXDATA                       (Host_ReadRegister(HOST_REGISTER_RXDATA))
+		#define USB_TXDATA                       (*Host_WriteRegister(HOST_REGISTER_TXDATA))
+		//@}
+
+		/** \name System Control Register Bits */
+		//@{
+		#define SCB_SYSAHBCLKCTRL_GPIO           (1UL << 6)
+		#define SCB_SYSAHBCLKCTRL_CT32B1         (1UL << 10)
+		#define SCB_SYSAHBCLKCTRL_USB_REG        (1UL << 14)
+		#define SCB_SYSAHBCLKCTRL_IOCON          (1UL << 16)
+		#define SCB_PDSLEEPCFG_USBPLL_PD         (1UL << 8)
+		#define SCB_PDSLEEPCFG_USBPAD_PD         (1UL << 10)
+		#define SCB_USBPLLCLKSEL_SOURCE_MAINOSC  0x00000001UL
+		#define SCB_USBPLLCLKUEN_DISABLE         0x00000000UL
+		#define SCB_USBPLLCLKUEN_UPDATE          0x00000001UL
+		#define SCB_USBPLLCTRL_MULT_4            0x00000003UL
+		#define SCB_USBPLLSTAT_LOCK              0x00000001UL
+		#define SCB_USBCLKSEL_SOURCE_USBPLLOUT   0x00000000UL
+		//@}
+
+		/** \name Pin Function Register Bits */
+		//@{
+		#define IOCON_PIO0_1_FUNC_MASK           0x00000007UL
+		#define IOCON_PIO0_1_FUNC_CLKOUT         0x00000001UL
+		#define IOCON_PIO0_3_FUNC_MASK           0x00000007UL
+		#define IOCON_PIO0_3_FUNC_USB_VBUS       0x00000001UL
+		#define IOCON_PIO0_6_FUNC_MASK           0x00000007UL
+		#define IOCON_PIO0_6_FUNC_USB_CONNECT    0x00000001UL
+		//@}
+
+	/* Enums: */
+		/** Enum for the simulated USB controller registers, passed to \ref Host_WriteRegister() and
+		 *  \ref Host_ReadRegister().
+		 */
+		enum Host_Registers_t
+		{
+			HOST_REGISTER_CMDCODE   = 0, /**< SIE command code register, written. */
+			HOST_REGISTER_CMDDATA   = 1, /**< SIE command data register, read. */
+			HOST_REGISTER_DEVINTCLR = 2, /**< Device interrupt clear register, written. */
+			HOST_REGISTER_DEVINTST  = 3, /**< Device interrupt status register, read. */
+			HOST_REGISTER_RXPLEN    = 4, /**< Receive packet length register, read. */
+			HOST_REGISTER_RXDATA    = 5, /**< Receive data register, read. */
+			HOST_REGISTER_TXDATA    = 6, /**< Transmit data register, written. */
+		};
+
+	/* Type Defines: */
+		/** Type define for the interrupt numbers of the simulated interrupt controller. */
+		typedef enum
+		{
+			USB_IRQn = 42, /**< USB controller interrupt. */
+		} IRQn_Type;
+
+	/* External Variables: */
+		extern volatile uint32_t USB_CTRL;
+		extern volatile uint32_t USB_DEVINTEN;
+		extern volatile uint32_t USB_TXPLEN;
+
+		extern volatile uint32_t SCB_SYSAHBCLKCTRL;
+		extern volatile uint32_t SCB_PDRUNCFG;
+		extern volatile uint32_t SCB_USBPLLCLKSEL;
+		extern volatile uint32_t SCB_USBPLLCLKUEN;
+		extern volatile uint32_t SCB_USBPLLCTRL;
+		extern volatile uint32_t SCB_USBPLLSTAT;
+		extern volatile uint32_t SCB_USBCLKSEL;
+
+		extern volatile uint32_t IOCON_PIO0_1;
+		extern volatile uint32_t IOCON_PIO0_3;
+		extern volatile uint32_t IOCON_PIO0_6;
+
+	/* Function Prototypes: */
+		/** Starts a write of the given simulated controller register. The value stored through the returned pointer is
+		 *  acted on by the simulation in the order written, before any subsequent register read.
+		 *
+		 *  \param[in] Register  Register to write, a value from the \ref Host_Registers_t enum.
+		 *
+		 *  \return Pointer to the location receiving the written value.
+		 */
+		volatile uint32_t* Host_WriteRegister(const uint8_t Register);
+
+		/** Reads the given simulated controller register.
+		 *
+		 *  \param[in] Register  Register to read, a value from the \ref Host_Registers_t enum.
+		 *
+		 *  \return Current value of the register.
+		 */
+		uint32_t Host_ReadRegister(const uint8_t Register);
+
+		/** Returns a free running, up counting 32-bit tick count of the simulation, in nanoseconds. */
+		uint32_t Host_ReadTicks(void);
+
+		void NVIC_EnableIRQ(const IRQn_Type IRQn);
+		void NVIC_DisableIRQ(const IRQn_Type IRQn);
+
+		uint32_t __get_PRIMASK(void);
+		void     __set_PRIMASK(const uint32_t PriMask);
+		void     __enable_irq(void);
+		void     __disable_irq(void);
+
+#endif
@@ -40,12 +40,51 @@
  *
  *  General HID constant definitions for HID Report Descriptor elements.
  *
+ *  The report layout macros allow the report size and field offsets of a device's reports to be derived at compile
+ *  time from the same field definitions used to build the report descriptor, so that the descriptor and the C
+ *  structure used to build each report cannot silently drift apart. Each field is defined once as a macro giving its
+ *  main item type, size in bits, count and item flags, and referenced from both the descriptor and a layout list:
+ *
+ *  \code
+ *  #define MOUSE_FIELD_BUTTONS  INPUT, 1, 3, (HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE)
+ *  #define MOUSE_FIELD_PADDING  INPUT, 1, 5, (HID_IOF_CONSTANT)
+ *  #define MOUSE_FIELD_AXES     INPUT, 8, 2, (HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_RELATIVE)
+ *
+ *  #define MOUSE_LAYOUT(Field)  Field(Buttons, MOUSE_FIELD_BUTTONS) \
+ *                               Field(Padding, MOUSE_FIELD_PADDING) \
+ *                               Field(Axes,    MOUSE_FIELD_AXES)
+ *
+ *  HID_REPORT_LAYOUT(Mouse, MOUSE_LAYOUT);
+ *
+ *  const USB_Descriptor_HIDReport_Datatype_t PROGMEM MouseReport[] =
+ *  {
+ *      ...
+ *      HID_RI_USAGE_MINIMUM(8, 0x01),
+ *      HID_RI_USAGE_MAXIMUM(8, 0x03),
+ *      HID_RI_LOGICAL_MINIMUM(8, 0x00),
+ *      HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+ *      HID_RI_REPORT_FIELD(MOUSE_FIELD_BUTTONS),
+ *      HID_RI_REPORT_FIELD(MOUSE_FIELD_PADDING),
+ *      ...
+ *      HID_RI_REPORT_FIELD(MOUSE_FIELD_AXES),
+ *      ...
+ *  };
+ *
+ *  HID_REPORT_LAYOUT_CHECK_SIZE(Mouse, USB_MouseReport_Data_t);
+ *  HID_REPORT_LAYOUT_CHECK_FIELD(Mouse, Axes, USB_MouseReport_Data_t, X);
+ *  \endcode
+ *
+ *  A mismatch between the report structure and the descriptor's fields then fails the build.
+ *
  *  @{
  */
 
 #ifndef __HIDREPORTDATA_H__
 #define __HIDREPORTDATA_H__
 
+	/* Includes: */
+		#include <stddef.h>
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		/* Macros: */
@@ -71,6 +110,22 @@
 			
 			#define _HID_RI_ENTRY(Type, Tag, DataBits, ...) \
 			                                                (Type | Tag | HID_RI_DATA_BITS(DataBits)) _HID_RI_ENCODE(DataBits, (__VA_ARGS__))
+
+			#define _HID_RI_REPORT_FIELD(MainItem, BitSize, Count, Flags) \
+			                                                HID_RI_REPORT_SIZE(8, BitSize), HID_RI_REPORT_COUNT(8, Count), \
+			                                                HID_RI_ ## MainItem(8, Flags)
+
+			#define _HID_LAYOUT_MEMBER(Name, Field)         __HID_LAYOUT_MEMBER(Name, Field)
+			#define __HID_LAYOUT_MEMBER(Name, MainItem, BitSize, Count, Flags) \
+			                                                uint8_t Name[(BitSize) * (Count)];
+
+			#define _HID_LAYOUT_STATIC_ASSERT(Name, Condition) \
+			                                                typedef char Name[(Condition) ? 1 : -1]
+			#define _HID_LAYOUT_ASSERT_NAME(Layout, Check)  _HID_LAYOUT_ASSERT_NAME_LINE(Layout, Check, __LINE__)
+			#define _HID_LAYOUT_ASSERT_NAME_LINE(Layout, Check, Line) \
+			                                                __HID_LAYOUT_ASSERT_NAME_LINE(Layout, Check, Line)
+			#define __HID_LAYOUT_ASSERT_NAME_LINE(Layout, Check, Line) \
+			                                                Layout ## _HIDLayout ## Check ## Line ## _t
 	#endif
 	
 	/* Public Interface - May be used in end-application: */
@@ -119,6 +174,52 @@
 			#define HID_RI_USAGE(DataBits, ...)             _HID_RI_ENTRY(HID_RI_TYPE_LOCAL , 0x00, DataBits, __VA_ARGS__)
 			#define HID_RI_USAGE_MINIMUM(DataBits, ...)     _HID_RI_ENTRY(HID_RI_TYPE_LOCAL , 0x10, DataBits, __VA_ARGS__)
 			#define HID_RI_USAGE_MAXIMUM(DataBits, ...)     _HID_RI_ENTRY(HID_RI_TYPE_LOCAL , 0x20, DataBits, __VA_ARGS__)
+
+			/** Emits the REPORT SIZE, REPORT COUNT and main item (INPUT, OUTPUT or FEATURE) descriptor items for a report
+			 *  field definition of the form <tt>MainItem, BitSize, Count, Flags</tt>, so that the same definition can be
+			 *  referenced from a report layout list. The size and count must each fit within 8 bits.
+			 */
+			#define HID_RI_REPORT_FIELD(Field)              _HID_RI_REPORT_FIELD(Field)
+		//@}
+
+		/** \name HID Report Layout Macros */
+		//@{
+			/** Declares the compile time layout of a report from a list of report field definitions. The list is a macro
+			 *  taking a single macro parameter, which it invokes as <tt>Field(Name, FieldDefinition)</tt> for each field of
+			 *  the report in descriptor order, where \c FieldDefinition is a field definition also used with
+			 *  \ref HID_RI_REPORT_FIELD(). No storage is allocated by the layout.
+			 *
+			 *  \param[in] Layout  Name of the layout, used to reference it in the other layout macros.
+			 *  \param[in] Fields  Name of the field list macro.
+			 */
+			#define HID_REPORT_LAYOUT(Layout, Fields)       typedef struct { Fields(_HID_LAYOUT_MEMBER) } Layout ## _HIDLayout_t
+
+			/** Evaluates to the offset in bits of a field within a report layout declared via \ref HID_REPORT_LAYOUT(),
+			 *  excluding any report ID, as a compile time constant.
+			 */
+			#define HID_REPORT_LAYOUT_BIT_OFFSET(Layout, Name)   offsetof(Layout ## _HIDLayout_t, Name)
+
+			/** Evaluates to the total size in bits of a report layout declared via \ref HID_REPORT_LAYOUT(), excluding any
+			 *  report ID, as a compile time constant.
+			 */
+			#define HID_REPORT_LAYOUT_BITS(Layout)          sizeof(Layout ## _HIDLayout_t)
+
+			/** Evaluates to the total size in bytes of a report layout declared via \ref HID_REPORT_LAYOUT(), excluding any
+			 *  report ID, as a compile time constant.
+			 */
+			#define HID_REPORT_LAYOUT_BYTES(Layout)         ((HID_REPORT_LAYOUT_BITS(Layout) + 7) / 8)
+
+			/** Fails the build unless the given report structure is exactly the size of the given report layout. */
+			#define HID_REPORT_LAYOUT_CHECK_SIZE(Layout, ReportType) \
+			        _HID_LAYOUT_STATIC_ASSERT(_HID_LAYOUT_ASSERT_NAME(Layout, Size), \
+			                                  (sizeof(ReportType) == HID_REPORT_LAYOUT_BYTES(Layout)))
+
+			/** Fails the build unless the given member of a report structure is located at the same, byte aligned, offset
+			 *  as the given field of a report layout.
+			 */
+			#define HID_REPORT_LAYOUT_CHECK_FIELD(Layout, Name, ReportType, Member) \
+			        _HID_LAYOUT_STATIC_ASSERT(_HID_LAYOUT_ASSERT_NAME(Layout, Field), \
+			                                  ((offsetof(ReportType, Member) * 8) == HID_REPORT_LAYOUT_BIT_OFFSET(Layout, Name)))
 		//@}
 
 /** @} */
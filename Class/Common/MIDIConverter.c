@@ -0,0 +1,227 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#define  __INCLUDE_FROM_MIDI_DRIVER
+#define  __INCLUDE_FROM_MIDICONVERTER_C
+#include "MIDIConverter.h"
+
+/** Number of MIDI bytes carried by an event packet of each USB-MIDI Code Index Number, zero for reserved values. */
+static const uint8_t MIDI_CodeIndexLengths[16] = {0, 0, 2, 3, 3, 1, 2, 3, 3, 3, 3, 3, 2, 2, 3, 1};
+
+void MIDI_InitConverter(MIDI_ConverterState_t* const ConverterState)
+{
+	memset(ConverterState, 0x00, sizeof(MIDI_ConverterState_t));
+}
+
+bool MIDI_ConvertStreamByte(MIDI_ConverterState_t* const ConverterState,
+                            const uint8_t CableNumber,
+                            const uint8_t Byte,
+                            MIDI_EventPacket_t* const Event)
+{
+	if (CableNumber >= MIDI_CONVERTER_TOTAL_CABLES)
+	  return false;
+
+	MIDI_CableState_t* Cable = &ConverterState->Cables[CableNumber];
+
+	/* Real-time messages may appear anywhere, and are passed straight through without disturbing the current message */
+	if (Byte >= MIDI_STATUS_REALTIME)
+	{
+		MIDI_BuildEvent(Event, CableNumber, MIDI_CIN_SINGLE_BYTE, &Byte, 1);
+		return true;
+	}
+
+	if (Byte & 0x80)
+	{
+		if (Byte == MIDI_STATUS_SYSEX_END)
+		{
+			if (!(Cable->InSysEx))
+			  return false;
+
+			Cable->Message[Cable->MessageBytes++] = Byte;
+			MIDI_BuildEvent(Event, CableNumber, (MIDI_CIN_SYSEX_END_1BYTE + Cable->MessageBytes - 1),
+			                Cable->Message, Cable->MessageBytes);
+
+			Cable->InSysEx      = false;
+			Cable->MessageBytes = 0;
+			return true;
+		}
+
+		/* Any other status byte abandons an unterminated System Exclusive message or incomplete message */
+		Cable->InSysEx      = false;
+		Cable->Message[0]   = Byte;
+		Cable->MessageBytes = 1;
+
+		if (Byte == MIDI_STATUS_SYSEX_START)
+		{
+			Cable->InSysEx       = true;
+			Cable->RunningStatus = 0;
+			return false;
+		}
+
+		/* Only channel messages establish running status, system common messages cancel it */
+		Cable->MessageLength = MIDI_GetMessageLength(Byte);
+		Cable->RunningStatus = (Byte < MIDI_STATUS_SYSEX_START) ? Byte : 0;
+	}
+	else if (Cable->InSysEx)
+	{
+		Cable->Message[Cable->MessageBytes++] = Byte;
+
+		if (Cable->MessageBytes < sizeof(Cable->Message))
+		  return false;
+
+		MIDI_BuildEvent(Event, CableNumber, MIDI_CIN_SYSEX_CONTINUE, Cable->Message, sizeof(Cable->Message));
+		Cable->MessageBytes = 0;
+		return true;
+	}
+	else
+	{
+		if (!(Cable->MessageBytes))
+		{
+			/* Data bytes without a status byte or running status in effect are discarded */
+			if (!(Cable->RunningStatus))
+			  return false;
+
+			Cable->Message[0]    = Cable->RunningStatus;
+			Cable->MessageBytes  = 1;
+			Cable->MessageLength = MIDI_GetMessageLength(Cable->RunningStatus);
+		}
+
+		Cable->Message[Cable->MessageBytes++] = Byte;
+	}
+
+	if (Cable->MessageBytes < Cable->MessageLength)
+	  return false;
+
+	uint8_t Status = Cable->Message[0];
+	uint8_t CodeIndex;
+
+	if (Status < MIDI_STATUS_SYSEX_START)
+	  CodeIndex = (Status >> 4);
+	else if (Cable->MessageLength == 1)
+	  CodeIndex = MIDI_CIN_SINGLE_BYTE_COMMON;
+	else if (Cable->MessageLength == 2)
+	  CodeIndex = MIDI_CIN_TWO_BYTE_COMMON;
+	else
+	  CodeIndex = MIDI_CIN_THREE_BYTE_COMMON;
+
+	MIDI_BuildEvent(Event, CableNumber, CodeIndex, Cable->Message, Cable->MessageLength);
+	Cable->MessageBytes = 0;
+	return true;
+}
+
+uint16_t MIDI_ConvertStream(MIDI_ConverterState_t* const ConverterState,
+                            const uint8_t CableNumber,
+                            const uint8_t* Bytes,
+                            const uint16_t Length,
+                            MIDI_EventPacket_t* const Events,
+                            const uint16_t MaxEvents,
+                            uint16_t* const BytesConverted)
+{
+	uint16_t EventCount = 0;
+	uint16_t ByteCount  = 0;
+
+	/* Each byte completes at most one event packet, so a byte is only consumed while there is room for its event */
+	while ((ByteCount < Length) && (EventCount < MaxEvents))
+	{
+		if (MIDI_ConvertStreamByte(ConverterState, CableNumber, Bytes[ByteCount++], &Events[EventCount]))
+		  EventCount++;
+	}
+
+	*BytesConverted = ByteCount;
+	return EventCount;
+}
+
+uint8_t MIDI_ConvertEvent(MIDI_ConverterState_t* const ConverterState,
+                          const MIDI_EventPacket_t* const Event,
+                          uint8_t* const Bytes)
+{
+	uint8_t CableNumber = Event->CableNumber;
+	uint8_t CodeIndex   = Event->Command;
+	uint8_t Length      = MIDI_CodeIndexLengths[CodeIndex];
+
+	if (!(Length) || (CableNumber >= MIDI_CONVERTER_TOTAL_CABLES))
+	  return 0;
+
+	MIDI_CableState_t* Cable = &ConverterState->Cables[CableNumber];
+	const uint8_t*     Data  = &Event->Data1;
+
+	if ((CodeIndex >= (MIDI_COMMAND_NOTE_OFF >> 4)) && (CodeIndex < MIDI_CIN_SINGLE_BYTE))
+	{
+		/* Channel messages with the same status as the last one sent on this cable can omit their status byte */
+		if (Data[0] == Cable->OutputStatus)
+		{
+			Data++;
+			Length--;
+		}
+		else
+		{
+			Cable->OutputStatus = Data[0];
+		}
+	}
+	else if (!((CodeIndex == MIDI_CIN_SINGLE_BYTE) && (Data[0] >= MIDI_STATUS_REALTIME)))
+	{
+		Cable->OutputStatus = 0;
+	}
+
+	memcpy(Bytes, Data, Length);
+	return Length;
+}
+
+static uint8_t MIDI_GetMessageLength(const uint8_t Status)
+{
+	if (Status < MIDI_STATUS_SYSEX_START)
+	  return (((Status & 0xE0) == 0xC0) ? 2 : 3);
+
+	switch (Status)
+	{
+		case 0xF1:
+		case 0xF3:
+			return 2;
+		case 0xF2:
+			return 3;
+		default:
+			return 1;
+	}
+}
+
+static void MIDI_BuildEvent(MIDI_EventPacket_t* const Event,
+                            const uint8_t CableNumber,
+                            const uint8_t CodeIndex,
+                            const uint8_t* const Data,
+                            const uint8_t Length)
+{
+	Event->Command     = CodeIndex;
+	Event->CableNumber = CableNumber;
+	Event->Data1       = Data[0];
+	Event->Data2       = (Length > 1) ? Data[1] : 0;
+	Event->Data3       = (Length > 2) ? Data[2] : 0;
+}
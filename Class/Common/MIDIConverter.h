@@ -0,0 +1,201 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+
+/** \file
+ *  \brief MIDI 1.0 byte stream to USB-MIDI event packet converter.
+ *
+ *  This file contains a streaming converter between serial MIDI 1.0 byte streams and USB-MIDI event packets, for
+ *  bridging physical MIDI ports to and from a USB MIDI interface.
+ */
+
+/** \ingroup Group_USBClassMIDI
+ *  \defgroup Group_MIDIConverter MIDI Stream Converter
+ *  \brief MIDI 1.0 byte stream to USB-MIDI event packet converter.
+ *
+ *  \section Sec_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - LUFA/Drivers/USB/Class/Common/MIDIConverter.c <i>(Makefile source module name: LUFA_SRC_USBCLASS)</i>
+ *
+ *  \section Sec_ModDescription Module Description
+ *  Converter between serial MIDI 1.0 byte streams and the event packets of a USB MIDI interface, in both directions.
+ *  Incoming bytes are assembled into event packets with the correct Code Index Number, following running status and
+ *  splitting System Exclusive messages of any length into three byte fragments. Real-time messages are converted as
+ *  soon as they are received, even part way through another message, without disturbing the message they interrupt.
+ *  Outgoing event packets are converted back into bytes, with running status applied to consecutive channel messages.
+ *
+ *  The state of each direction is kept separately for each virtual cable, so that a single converter instance can
+ *  bridge up to \ref MIDI_CONVERTER_TOTAL_CABLES physical ports.
+ *
+ *  @{
+ */
+
+#ifndef __MIDICONVERTER_H__
+#define __MIDICONVERTER_H__
+
+	/* Includes: */
+		#include "MIDI.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_MIDI_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(MIDI_CONVERTER_TOTAL_CABLES) || defined(__DOXYGEN__)
+				/** Number of virtual cables whose state is tracked by each converter instance, from 1 to 16. Events and bytes
+				 *  for cable numbers outside this range are discarded. This may be overridden in the user project makefile by
+				 *  passing the \c MIDI_CONVERTER_TOTAL_CABLES token to the compiler via the -D switch.
+				 */
+				#define MIDI_CONVERTER_TOTAL_CABLES   16
+			#endif
+
+		/* Type Defines: */
+			/** \brief MIDI Stream Converter Cable State.
+			 *
+			 *  Type define for the conversion state of a single virtual cable, for both directions of conversion.
+			 */
+			typedef struct
+			{
+				uint8_t RunningStatus; /**< Running status of the incoming byte stream, zero if none is in effect. */
+				uint8_t Message[3]; /**< Bytes of the incoming message or System Exclusive fragment being assembled. */
+				uint8_t MessageBytes; /**< Number of bytes of the incoming message assembled so far. */
+				uint8_t MessageLength; /**< Total length in bytes of the incoming message being assembled. */
+				bool    InSysEx; /**< Indicates if a System Exclusive message is being received on the incoming byte stream. */
+				uint8_t OutputStatus; /**< Running status of the outgoing byte stream, zero if none is in effect. */
+			} MIDI_CableState_t;
+
+			/** \brief MIDI Stream Converter State.
+			 *
+			 *  Type define for the state of a MIDI stream converter instance. An instance of this structure should be made for
+			 *  each set of ports bridged by the application, and initialized via \ref MIDI_InitConverter() before use.
+			 */
+			typedef struct
+			{
+				MIDI_CableState_t Cables[MIDI_CONVERTER_TOTAL_CABLES]; /**< Conversion state of each virtual cable. */
+			} MIDI_ConverterState_t;
+
+		/* Function Prototypes: */
+			/** Resets the state of a MIDI stream converter, clearing any running status and partially received messages.
+			 *
+			 *  \param[out] ConverterState  Pointer to the converter state to initialize.
+			 */
+			void MIDI_InitConverter(MIDI_ConverterState_t* const ConverterState) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Converts the next byte of a serial MIDI byte stream received on the given virtual cable, producing an event packet
+			 *  each time a complete message, System Exclusive fragment or real-time message has been received.
+			 *
+			 *  \param[in,out] ConverterState  Pointer to the converter state.
+			 *  \param[in]     CableNumber     Virtual cable number the byte was received on.
+			 *  \param[in]     Byte            Byte received from the MIDI byte stream.
+			 *  \param[out]    Event           Pointer to the location where the completed event packet is to be stored.
+			 *
+			 *  \return Boolean \c true if an event packet was completed, \c false otherwise.
+			 */
+			bool MIDI_ConvertStreamByte(MIDI_ConverterState_t* const ConverterState,
+			                            const uint8_t CableNumber,
+			                            const uint8_t Byte,
+			                            MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4);
+
+			/** Converts a block of a serial MIDI byte stream received on the given virtual cable into event packets. Conversion stops
+			 *  early if the event packet array is filled, in which case the remaining bytes should be passed in a subsequent call.
+			 *
+			 *  \param[in,out] ConverterState  Pointer to the converter state.
+			 *  \param[in]     CableNumber     Virtual cable number the bytes were received on.
+			 *  \param[in]     Bytes           Pointer to the bytes received from the MIDI byte stream.
+			 *  \param[in]     Length          Number of bytes to convert.
+			 *  \param[out]    Events          Pointer to an array where the completed event packets are to be stored.
+			 *  \param[in]     MaxEvents       Maximum number of event packets to store into the array.
+			 *  \param[out]    BytesConverted  Pointer to a location where the number of bytes consumed is to be stored.
+			 *
+			 *  \return Number of event packets stored into the array.
+			 */
+			uint16_t MIDI_ConvertStream(MIDI_ConverterState_t* const ConverterState,
+			                            const uint8_t CableNumber,
+			                            const uint8_t* Bytes,
+			                            const uint16_t Length,
+			                            MIDI_EventPacket_t* const Events,
+			                            const uint16_t MaxEvents,
+			                            uint16_t* const BytesConverted) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3)
+			                            ATTR_NON_NULL_PTR_ARG(5) ATTR_NON_NULL_PTR_ARG(7);
+
+			/** Converts a USB-MIDI event packet into the bytes to send on the serial MIDI byte stream of the event's virtual cable.
+			 *  Channel messages repeating the previous channel message's status on the same cable have their status byte omitted,
+			 *  following running status.
+			 *
+			 *  \param[in,out] ConverterState  Pointer to the converter state.
+			 *  \param[in]     Event           Pointer to the event packet to convert.
+			 *  \param[out]    Bytes           Pointer to a buffer of at least three bytes where the converted bytes are to be stored.
+			 *
+			 *  \return Number of bytes stored into the buffer, zero if the event packet is empty or reserved.
+			 */
+			uint8_t MIDI_ConvertEvent(MIDI_ConverterState_t* const ConverterState,
+			                          const MIDI_EventPacket_t* const Event,
+			                          uint8_t* const Bytes) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2) ATTR_NON_NULL_PTR_ARG(3);
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define MIDI_CIN_TWO_BYTE_COMMON      0x02
+			#define MIDI_CIN_THREE_BYTE_COMMON    0x03
+			#define MIDI_CIN_SYSEX_CONTINUE       0x04
+			#define MIDI_CIN_SINGLE_BYTE_COMMON   0x05
+			#define MIDI_CIN_SYSEX_END_1BYTE      0x05
+			#define MIDI_CIN_SINGLE_BYTE          0x0F
+
+			#define MIDI_STATUS_SYSEX_START       0xF0
+			#define MIDI_STATUS_SYSEX_END         0xF7
+			#define MIDI_STATUS_REALTIME          0xF8
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_MIDICONVERTER_C)
+				static uint8_t MIDI_GetMessageLength(const uint8_t Status) ATTR_CONST;
+				static void MIDI_BuildEvent(MIDI_EventPacket_t* const Event,
+				                            const uint8_t CableNumber,
+				                            const uint8_t CodeIndex,
+				                            const uint8_t* const Data,
+				                            const uint8_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(4);
+			#endif
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
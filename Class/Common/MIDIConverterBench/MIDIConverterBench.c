@@ -0,0 +1,433 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host round-trip check and throughput benchmark of the MIDI stream converter. Pseudo-random MIDI byte streams are
+ *  generated for each of 16 virtual cables, with running status, System Exclusive messages of varying length and
+ *  real-time messages interleaved at any point, even part way through another message. The streams are converted a
+ *  chunk at a time in turn into event packets and back into byte streams, which must match the generated streams once
+ *  both are normalized. Each direction of conversion is then timed, and compared against the byte rate of a DIN MIDI
+ *  port on every cable.
+ */
+
+#include "MIDIConverterBench.h"
+
+/** Generated and converted streams of each virtual cable. */
+static Bench_CableStream_t Streams[BENCH_TOTAL_CABLES];
+
+/** Converter state for the conversion of the byte streams into event packets. */
+static MIDI_ConverterState_t InputConverter;
+
+/** Converter state for the conversion of the event packets back into byte streams. */
+static MIDI_ConverterState_t OutputConverter;
+
+/** Normalized form of the stream currently being checked. */
+static uint8_t Normalized[BENCH_STREAM_SIZE];
+
+/** State of the pseudo-random stream generator. */
+static uint32_t RandomState = BENCH_RANDOM_SEED;
+
+/** Sink for benchmark results, so that the benchmarked calls are not optimized away. */
+static volatile uint32_t BenchSink;
+
+/** Main program entry point. Generates and checks the stream of each cable, then benchmarks each direction of conversion.
+ *
+ *  \return \c EXIT_SUCCESS if no differences were found by the round-trip check, \c EXIT_FAILURE otherwise.
+ */
+int main(void)
+{
+	uint32_t TotalInputBytes  = 0;
+	uint32_t TotalEvents      = 0;
+	uint32_t TotalOutputBytes = 0;
+	uint32_t Iterations;
+	double   StartTime;
+	double   Elapsed;
+
+	for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+	  Bench_GenerateStream(&Streams[Cable]);
+
+	uint32_t Differences = Bench_CheckRoundTrip();
+
+	for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+	{
+		TotalInputBytes  += Streams[Cable].InputLength;
+		TotalEvents      += Streams[Cable].TotalEvents;
+		TotalOutputBytes += Streams[Cable].OutputLength;
+	}
+
+	Iterations = 0;
+	StartTime  = Bench_Seconds();
+
+	do
+	{
+		Bench_ConvertStreams();
+		Iterations++;
+	} while ((Elapsed = (Bench_Seconds() - StartTime)) < BENCH_MIN_SECONDS);
+
+	double StreamRate = ((Iterations * (double)TotalInputBytes) / Elapsed);
+
+	Iterations = 0;
+	StartTime  = Bench_Seconds();
+
+	do
+	{
+		Bench_ConvertEvents();
+		Iterations++;
+	} while ((Elapsed = (Bench_Seconds() - StartTime)) < BENCH_MIN_SECONDS);
+
+	double EventRate     = ((Iterations * (double)TotalEvents) / Elapsed);
+	double EventByteRate = ((Iterations * (double)TotalOutputBytes) / Elapsed);
+	double RequiredRate  = ((double)BENCH_DIN_BYTES_PER_SECOND * BENCH_TOTAL_CABLES);
+
+	printf("Cables:                            %u\n", BENCH_TOTAL_CABLES);
+	printf("Stream bytes / event packets:      %u / %u\n", TotalInputBytes, TotalEvents);
+	printf("Round-trip check differences:      %u\n", Differences);
+	printf("\nRequired byte rate (DIN MIDI):     %.0f bytes/s\n", RequiredRate);
+	printf("Stream to event bytes per second:  %.0f (%.0fx required)\n", StreamRate, (StreamRate / RequiredRate));
+	printf("Event to stream events per second: %.0f\n", EventRate);
+	printf("Event to stream bytes per second:  %.0f (%.0fx required)\n", EventByteRate, (EventByteRate / RequiredRate));
+
+	return (Differences ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/** Retrieves the next value of the pseudo-random stream generator.
+ *
+ *  \return Pseudo-random 32-bit value.
+ */
+static uint32_t Bench_Random(void)
+{
+	RandomState ^= (RandomState << 13);
+	RandomState ^= (RandomState >> 17);
+	RandomState ^= (RandomState << 5);
+
+	return RandomState;
+}
+
+/** Determines the total length of a message, independently of the converter, for the normalization of byte streams.
+ *
+ *  \param[in] Status  Status byte of the message, other than a System Exclusive or real-time status.
+ *
+ *  \return Length of the message in bytes, including its status byte.
+ */
+static uint8_t Bench_MessageLength(const uint8_t Status)
+{
+	if (Status < MIDI_STATUS_SYSEX_START)
+	  return (((Status & 0xF0) == 0xC0) || ((Status & 0xF0) == 0xD0)) ? 2 : 3;
+	else if (Status == 0xF2)
+	  return 3;
+	else if ((Status == 0xF1) || (Status == 0xF3))
+	  return 2;
+	else
+	  return 1;
+}
+
+/** Generates the pseudo-random byte stream of a cable, along with its normalized form.
+ *
+ *  \param[out] Stream  Cable stream to generate.
+ */
+static void Bench_GenerateStream(Bench_CableStream_t* const Stream)
+{
+	static const uint8_t CommonStatuses[] = {0xF1, 0xF2, 0xF3, 0xF6};
+
+	uint8_t Message[BENCH_MAX_SYSEX_DATA + 2];
+	uint8_t RunningStatus = 0;
+
+	Stream->InputLength    = 0;
+	Stream->ExpectedLength = 0;
+
+	/* Each message byte may be preceded by a real-time message, so up to twice its length is written to the stream */
+	while (Stream->InputLength < (BENCH_STREAM_SIZE - (2 * sizeof(Message))))
+	{
+		uint8_t MessageKind   = (Bench_Random() % 8);
+		uint8_t MessageLength;
+		uint8_t FirstByte     = 0;
+
+		if (MessageKind < 5)
+		{
+			Message[0]    = (0x80 + (Bench_Random() % 0x70));
+			MessageLength = Bench_MessageLength(Message[0]);
+
+			if ((Message[0] == RunningStatus) && (Bench_Random() & 0x01))
+			  FirstByte = 1;
+
+			RunningStatus = Message[0];
+		}
+		else if (MessageKind < 7)
+		{
+			MessageLength = (2 + (Bench_Random() % (BENCH_MAX_SYSEX_DATA + 1)));
+			Message[0]    = MIDI_STATUS_SYSEX_START;
+			RunningStatus = 0;
+		}
+		else
+		{
+			Message[0]    = CommonStatuses[Bench_Random() % sizeof(CommonStatuses)];
+			MessageLength = Bench_MessageLength(Message[0]);
+			RunningStatus = 0;
+		}
+
+		for (uint8_t DataByte = 1; DataByte < MessageLength; DataByte++)
+		  Message[DataByte] = (Bench_Random() & 0x7F);
+
+		if (Message[0] == MIDI_STATUS_SYSEX_START)
+		  Message[MessageLength - 1] = MIDI_STATUS_SYSEX_END;
+
+		for (uint8_t MessageByte = FirstByte; MessageByte < MessageLength; MessageByte++)
+		{
+			/* Real-time messages received part way through a message are converted before the message completes */
+			if (!(Bench_Random() % 8))
+			{
+				uint8_t RealTime = (MIDI_STATUS_REALTIME | (Bench_Random() & 0x07));
+
+				Stream->Input[Stream->InputLength++]       = RealTime;
+				Stream->Expected[Stream->ExpectedLength++] = RealTime;
+			}
+
+			Stream->Input[Stream->InputLength++] = Message[MessageByte];
+		}
+
+		memcpy(&Stream->Expected[Stream->ExpectedLength], Message, MessageLength);
+		Stream->ExpectedLength += MessageLength;
+	}
+}
+
+/** Normalizes a MIDI byte stream, independently of the converter. Each message is written out in full with its status
+ *  byte once it completes, so that running status no longer affects the stream. Real-time messages are written out as
+ *  soon as they are received, and so precede any message they interrupt.
+ *
+ *  \param[in]  Bytes       Byte stream to normalize.
+ *  \param[in]  Length      Number of bytes in the stream.
+ *  \param[out] Normalized  Buffer where the normalized stream is to be stored, of at least \c Length bytes.
+ *
+ *  \return Number of bytes stored into the normalized buffer.
+ */
+static uint16_t Bench_NormalizeStream(const uint8_t* const Bytes,
+                                      const uint16_t Length,
+                                      uint8_t* const Normalized)
+{
+	uint8_t  Message[BENCH_MAX_SYSEX_DATA + 2];
+	uint8_t  MessageBytes     = 0;
+	uint8_t  MessageLength    = 0;
+	uint8_t  RunningStatus    = 0;
+	bool     InSysEx          = false;
+	uint16_t NormalizedLength = 0;
+
+	for (uint16_t ByteIndex = 0; ByteIndex < Length; ByteIndex++)
+	{
+		uint8_t Byte = Bytes[ByteIndex];
+
+		if (Byte >= MIDI_STATUS_REALTIME)
+		{
+			Normalized[NormalizedLength++] = Byte;
+			continue;
+		}
+
+		if (Byte == MIDI_STATUS_SYSEX_END)
+		{
+			if (!(InSysEx) || (MessageBytes == sizeof(Message)))
+			  continue;
+
+			Message[MessageBytes++] = Byte;
+			MessageLength = MessageBytes;
+		}
+		else if (Byte & 0x80)
+		{
+			InSysEx       = (Byte == MIDI_STATUS_SYSEX_START);
+			RunningStatus = ((Byte < MIDI_STATUS_SYSEX_START) ? Byte : 0);
+			Message[0]    = Byte;
+			MessageBytes  = 1;
+			MessageLength = (InSysEx ? 0 : Bench_MessageLength(Byte));
+		}
+		else
+		{
+			if (!(MessageBytes))
+			{
+				if (!(RunningStatus))
+				  continue;
+
+				Message[0]    = RunningStatus;
+				MessageBytes  = 1;
+				MessageLength = Bench_MessageLength(RunningStatus);
+			}
+
+			if (MessageBytes == sizeof(Message))
+			  continue;
+
+			Message[MessageBytes++] = Byte;
+		}
+
+		if (MessageBytes != MessageLength)
+		  continue;
+
+		memcpy(&Normalized[NormalizedLength], Message, MessageBytes);
+		NormalizedLength += MessageBytes;
+		MessageBytes      = 0;
+		InSysEx           = false;
+	}
+
+	return NormalizedLength;
+}
+
+/** Converts the stream of each cable into event packets and back, and checks the result against the generated stream.
+ *  The cables are converted a random sized chunk at a time in turn, so that each relies on its own conversion state
+ *  being kept between calls.
+ *
+ *  \return Number of differences found, counting each cable whose stream does not survive the round trip and each event
+ *          packet carrying the wrong cable number.
+ */
+static uint32_t Bench_CheckRoundTrip(void)
+{
+	uint16_t InputOffsets[BENCH_TOTAL_CABLES] = {0};
+	uint32_t Differences = 0;
+	bool     Converting;
+
+	MIDI_InitConverter(&InputConverter);
+	MIDI_InitConverter(&OutputConverter);
+
+	for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+	{
+		Streams[Cable].TotalEvents  = 0;
+		Streams[Cable].OutputLength = 0;
+	}
+
+	do
+	{
+		Converting = false;
+
+		for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+		{
+			Bench_CableStream_t* Stream      = &Streams[Cable];
+			uint16_t             ChunkLength = (1 + (Bench_Random() % BENCH_MAX_CHUNK));
+			MIDI_EventPacket_t*  Events      = &Stream->Events[Stream->TotalEvents];
+			uint16_t             BytesConverted;
+
+			ChunkLength = MIN(ChunkLength, (Stream->InputLength - InputOffsets[Cable]));
+
+			if (!(ChunkLength))
+			  continue;
+
+			uint16_t ChunkEvents = MIDI_ConvertStream(&InputConverter, Cable, &Stream->Input[InputOffsets[Cable]], ChunkLength,
+			                                          Events, BENCH_MAX_CHUNK_EVENTS, &BytesConverted);
+
+			for (uint16_t EventIndex = 0; EventIndex < ChunkEvents; EventIndex++)
+			{
+				if (Events[EventIndex].CableNumber != Cable)
+				  Differences++;
+
+				Stream->OutputLength += MIDI_ConvertEvent(&OutputConverter, &Events[EventIndex],
+				                                          &Stream->Output[Stream->OutputLength]);
+			}
+
+			InputOffsets[Cable] += BytesConverted;
+			Stream->TotalEvents += ChunkEvents;
+			Converting           = true;
+		}
+	} while (Converting);
+
+	for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+	{
+		Bench_CableStream_t* Stream = &Streams[Cable];
+
+		/* The generated stream is normalized too, as a check of the normalization itself */
+		uint16_t NormalizedLength = Bench_NormalizeStream(Stream->Input, Stream->InputLength, Normalized);
+
+		if ((NormalizedLength != Stream->ExpectedLength) || memcmp(Normalized, Stream->Expected, NormalizedLength))
+		{
+			printf("Cable %2u: generated stream does not normalize to its expected form\n", Cable);
+			Differences++;
+		}
+
+		NormalizedLength = Bench_NormalizeStream(Stream->Output, Stream->OutputLength, Normalized);
+
+		if ((NormalizedLength != Stream->ExpectedLength) || memcmp(Normalized, Stream->Expected, NormalizedLength))
+		{
+			printf("Cable %2u: round-trip stream differs from the generated stream\n", Cable);
+			Differences++;
+		}
+	}
+
+	return Differences;
+}
+
+/** Retrieves the current time for the benchmark timings.
+ *
+ *  \return Monotonic time in seconds.
+ */
+static double Bench_Seconds(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (Now.tv_sec + (Now.tv_nsec / 1e9));
+}
+
+/** Converts the stream of every cable into event packets once, a block of event packets at a time. */
+static void Bench_ConvertStreams(void)
+{
+	MIDI_EventPacket_t Events[BENCH_EVENTS_PER_CALL];
+
+	MIDI_InitConverter(&InputConverter);
+
+	for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+	{
+		Bench_CableStream_t* Stream      = &Streams[Cable];
+		uint16_t             InputOffset = 0;
+		uint16_t             BytesConverted;
+
+		while (InputOffset < Stream->InputLength)
+		{
+			BenchSink += MIDI_ConvertStream(&InputConverter, Cable, &Stream->Input[InputOffset], (Stream->InputLength - InputOffset),
+			                                Events, BENCH_EVENTS_PER_CALL, &BytesConverted);
+			BenchSink += Events[0].Data1;
+
+			InputOffset += BytesConverted;
+		}
+	}
+}
+
+/** Converts the event packets of every cable back into byte streams once. */
+static void Bench_ConvertEvents(void)
+{
+	uint8_t Bytes[3];
+
+	MIDI_InitConverter(&OutputConverter);
+
+	for (uint8_t Cable = 0; Cable < BENCH_TOTAL_CABLES; Cable++)
+	{
+		Bench_CableStream_t* Stream = &Streams[Cable];
+
+		for (uint16_t EventIndex = 0; EventIndex < Stream->TotalEvents; EventIndex++)
+		{
+			BenchSink += MIDI_ConvertEvent(&OutputConverter, &Stream->Events[EventIndex], Bytes);
+			BenchSink += Bytes[0];
+		}
+	}
+}
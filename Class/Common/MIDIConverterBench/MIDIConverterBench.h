@@ -0,0 +1,107 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for MIDIConverterBench.c.
+ */
+
+#ifndef _MIDI_CONVERTER_BENCH_H_
+#define _MIDI_CONVERTER_BENCH_H_
+
+	/* Includes: */
+		#include <stdio.h>
+		#include <stdlib.h>
+		#include <time.h>
+
+		#define  __INCLUDE_FROM_USB_DRIVER
+		#define  __INCLUDE_FROM_MIDI_DRIVER
+		#include "../MIDIConverter.h"
+
+	/* Macros: */
+		/** Minimum duration of each timed benchmark, in seconds. */
+		#define BENCH_MIN_SECONDS           0.5
+
+		/** Number of virtual cables the round-trip check and benchmark are run over. */
+		#define BENCH_TOTAL_CABLES          16
+
+		/** Size in bytes of the generated MIDI byte stream of each cable. */
+		#define BENCH_STREAM_SIZE           32768
+
+		/** Maximum number of data bytes of each generated System Exclusive message. */
+		#define BENCH_MAX_SYSEX_DATA        40
+
+		/** Maximum number of bytes of a cable's byte stream passed to the converter in a single call. */
+		#define BENCH_MAX_CHUNK             24
+
+		/** Maximum number of event packets stored by a single call to the converter during the round-trip check, kept small so
+		 *  that conversion regularly stops early on a full event packet array.
+		 */
+		#define BENCH_MAX_CHUNK_EVENTS      4
+
+		/** Number of event packets converted by each call to the converter during the throughput benchmark. */
+		#define BENCH_EVENTS_PER_CALL       64
+
+		/** Seed of the pseudo-random stream generator, so that runs may be compared against one another. */
+		#define BENCH_RANDOM_SEED           0x2F6B1C3DUL
+
+		/** Byte rate of a single DIN MIDI port, at 31.25 kbaud with ten bits transmitted per byte. */
+		#define BENCH_DIN_BYTES_PER_SECOND  (31250 / 10)
+
+	/* Type Defines: */
+		/** Type define for the generated byte streams of a single virtual cable. */
+		typedef struct
+		{
+			uint8_t  Input[BENCH_STREAM_SIZE]; /**< Byte stream passed to the converter, with running status and interleaved
+			                                    *   real-time messages.
+			                                    */
+			uint16_t InputLength; /**< Number of bytes stored in the \c Input stream. */
+			uint8_t  Expected[BENCH_STREAM_SIZE]; /**< Normalized form of the \c Input stream, see \ref Bench_NormalizeStream(). */
+			uint16_t ExpectedLength; /**< Number of bytes stored in the \c Expected stream. */
+			uint8_t  Output[BENCH_STREAM_SIZE]; /**< Byte stream converted back from the cable's event packets. */
+			uint16_t OutputLength; /**< Number of bytes stored in the \c Output stream. */
+			MIDI_EventPacket_t Events[BENCH_STREAM_SIZE]; /**< Event packets converted from the \c Input stream. */
+			uint16_t TotalEvents; /**< Number of event packets stored in the \c Events array. */
+		} Bench_CableStream_t;
+
+	/* Function Prototypes: */
+		static uint32_t Bench_Random(void);
+		static uint8_t  Bench_MessageLength(const uint8_t Status);
+		static void     Bench_GenerateStream(Bench_CableStream_t* const Stream);
+		static uint16_t Bench_NormalizeStream(const uint8_t* const Bytes,
+		                                      const uint16_t Length,
+		                                      uint8_t* const Normalized);
+		static uint32_t Bench_CheckRoundTrip(void);
+		static double   Bench_Seconds(void);
+		static void     Bench_ConvertStreams(void);
+		static void     Bench_ConvertEvents(void);
+
+#endif
+
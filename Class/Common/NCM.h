@@ -0,0 +1,268 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Common definitions and declarations for the library USB CDC-NCM Class driver.
+ *
+ *  Common definitions and declarations for the library USB CDC-NCM Class driver.
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB module driver
+ *        dispatch header located in LUFA/Drivers/USB.h.
+ */
+
+/** \ingroup Group_USBClassNCM
+ *  \defgroup Group_USBClassNCMCommon  Common Class Definitions
+ *
+ *  \section Sec_ModDescription Module Description
+ *  Constants, Types and Enum definitions that are common to both Device and Host modes for the USB
+ *  CDC Network Control Model (NCM) Class.
+ *
+ *  @{
+ */
+
+#ifndef _NCM_CLASS_COMMON_H_
+#define _NCM_CLASS_COMMON_H_
+
+	/* Macros: */
+		#define __INCLUDE_FROM_CDC_DRIVER
+		#define __INCLUDE_FROM_RNDIS_DRIVER
+
+	/* Includes: */
+		#include "../../Core/StdDescriptors.h"
+		#include "CDC.h"
+		#include "RNDIS.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_NCM_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB.h instead.
+		#endif
+
+	/* Macros: */
+		/** Additional error code for NCM functions when a datagram or NTB is rejected as malformed or oversized. */
+		#define NCM_ERROR_LOGICAL_CMD_FAILED          0x80
+
+		/** Signature of a 16-bit NCM Transfer Header, the ASCII string "NCMH" in little endian order. */
+		#define NCM_NTH16_SIGNATURE                   0x484D434EUL
+
+		/** Signature of a 16-bit NCM Datagram Pointer Table without CRC, the ASCII string "NCM0" in little endian order. */
+		#define NCM_NDP16_SIGNATURE_NOCRC             0x304D434EUL
+
+		/** Maximum size in bytes of a single NCM datagram, an Ethernet frame including its 14 byte header. */
+		#define NCM_DATAGRAM_SIZE_MAX                 (ETHERNET_FRAME_SIZE_MAX + 14)
+
+		/** Mask for the \c bmNtbFormatsSupported field of the \ref NCM_NTB_Parameters_t structure, indicating that
+		 *  16-bit NTB structures are supported.
+		 */
+		#define NCM_NTB_FORMAT_SUPPORTED_16BIT        (1 << 0)
+
+		/** \name NCM Functional Descriptor Network Capabilities Masks */
+		//@{
+		#define NCM_NETWORK_CAPABILITY_PACKET_FILTER  (1 << 0)
+		#define NCM_NETWORK_CAPABILITY_NET_ADDRESS    (1 << 1)
+		#define NCM_NETWORK_CAPABILITY_ENCAPSULATED   (1 << 2)
+		#define NCM_NETWORK_CAPABILITY_MAX_DATAGRAM   (1 << 3)
+		#define NCM_NETWORK_CAPABILITY_CRC_MODE       (1 << 4)
+		#define NCM_NETWORK_CAPABILITY_NTB_INPUT_8BYTE (1 << 5)
+		//@}
+
+		/** \name Ethernet Packet Filter Masks */
+		//@{
+		#define NCM_PACKET_TYPE_PROMISCUOUS           (1 << 0)
+		#define NCM_PACKET_TYPE_ALL_MULTICAST         (1 << 1)
+		#define NCM_PACKET_TYPE_DIRECTED              (1 << 2)
+		#define NCM_PACKET_TYPE_BROADCAST             (1 << 3)
+		#define NCM_PACKET_TYPE_MULTICAST             (1 << 4)
+		//@}
+
+	/* Enums: */
+		/** Enum for possible Class, Subclass and Protocol values of device and interface descriptors relating to the
+		 *  CDC-NCM device class.
+		 */
+		enum NCM_Descriptor_ClassSubclassProtocol_t
+		{
+			NCM_CSCP_NCMSubclass            = 0x0D, /**< Descriptor Subclass value indicating that the device or interface
+			                                         *   belongs to the Network Control Model CDC subclass.
+			                                         */
+			NCM_CSCP_NoSpecificProtocol     = 0x00, /**< Descriptor Protocol value indicating that the control interface
+			                                         *   belongs to no specific protocol of the NCM subclass.
+			                                         */
+			NCM_CSCP_NTBDataProtocol        = 0x01, /**< Descriptor Protocol value indicating that the data interface
+			                                         *   transfers Network Transfer Blocks.
+			                                         */
+		};
+
+		/** Enum for the CDC-NCM class specific control requests that can be issued by the USB bus host. */
+		enum NCM_ClassRequests_t
+		{
+			NCM_REQ_SetEthernetPacketFilter = 0x43, /**< Request to set the Ethernet packet types delivered to the host. */
+			NCM_REQ_GetNTBParameters        = 0x80, /**< Request to retrieve the device's NTB size and alignment parameters. */
+			NCM_REQ_GetNetAddress           = 0x81, /**< Request to retrieve the current network (MAC) address of the device. */
+			NCM_REQ_SetNetAddress           = 0x82, /**< Request to set the network (MAC) address of the device. */
+			NCM_REQ_GetNTBFormat            = 0x83, /**< Request to retrieve the current NTB format, 16 or 32-bit. */
+			NCM_REQ_SetNTBFormat            = 0x84, /**< Request to select the NTB format, 16 or 32-bit. */
+			NCM_REQ_GetNTBInputSize         = 0x85, /**< Request to retrieve the current maximum IN NTB size. */
+			NCM_REQ_SetNTBInputSize         = 0x86, /**< Request to set the maximum IN NTB size the host will accept. */
+			NCM_REQ_GetMaxDatagramSize      = 0x87, /**< Request to retrieve the current maximum datagram size. */
+			NCM_REQ_SetMaxDatagramSize      = 0x88, /**< Request to set the maximum datagram size. */
+			NCM_REQ_GetCRCMode              = 0x89, /**< Request to retrieve the current datagram CRC mode. */
+			NCM_REQ_SetCRCMode              = 0x8A, /**< Request to set the datagram CRC mode. */
+		};
+
+		/** Enum for the CDC-NCM class specific notification requests that can be issued by a NCM device to a host. */
+		enum NCM_ClassNotifications_t
+		{
+			NCM_NOTIF_NetworkConnection     = 0x00, /**< Notification of a change in the network link state. */
+			NCM_NOTIF_ConnectionSpeedChange = 0x2A, /**< Notification of the current upstream and downstream bit rates. */
+		};
+
+		/** Enum for the CDC-NCM class specific interface descriptor subtypes. */
+		enum NCM_DescriptorSubtypes_t
+		{
+			NCM_DSUBTYPE_CSInterface_NCM    = 0x1A, /**< CDC class-specific NCM functional descriptor. */
+		};
+
+	/* Type Defines: */
+		/** \brief CDC class-specific Functional Ethernet Networking Descriptor (LUFA naming conventions).
+		 *
+		 *  Type define for a CDC class-specific Ethernet Networking functional descriptor, which gives the host the
+		 *  adapter's MAC address string and maximum segment size. See the CDC ECM specification for more details.
+		 */
+		typedef struct
+		{
+			USB_Descriptor_Header_t Header; /**< Regular descriptor header containing the descriptor's type and length. */
+			uint8_t                 Subtype; /**< Sub type value used to distinguish between CDC class-specific descriptors,
+			                                  *   must be \ref CDC_DSUBTYPE_CSInterface_Ethernet.
+			                                  */
+			uint8_t                 MACAddressStrIndex; /**< Index of the string descriptor holding the adapter's MAC address
+			                                             *   as 12 hexadecimal digits.
+			                                             */
+			uint32_t                EthernetStatistics; /**< Bit mask of the Ethernet statistics the adapter collects. */
+			uint16_t                MaxSegmentSize; /**< Maximum segment size of the adapter, typically 1514 bytes. */
+			uint16_t                NumberMCFilters; /**< Number of multicast filters the adapter can configure. */
+			uint8_t                 NumberPowerFilters; /**< Number of wake-up pattern filters the adapter supports. */
+		} ATTR_PACKED USB_NCM_Descriptor_FunctionalEthernet_t;
+
+		/** \brief CDC class-specific Functional NCM Descriptor (LUFA naming conventions).
+		 *
+		 *  Type define for a CDC class-specific NCM functional descriptor, which indicates the NCM specification
+		 *  version and the optional requests the adapter supports.
+		 */
+		typedef struct
+		{
+			USB_Descriptor_Header_t Header; /**< Regular descriptor header containing the descriptor's type and length. */
+			uint8_t                 Subtype; /**< Sub type value used to distinguish between CDC class-specific descriptors,
+			                                  *   must be \ref NCM_DSUBTYPE_CSInterface_NCM.
+			                                  */
+			uint16_t                NCMVersion; /**< Version number of the NCM specification implemented, encoded in BCD format. */
+			uint8_t                 NetworkCapabilities; /**< Supported optional requests, a mask of \c NCM_NETWORK_CAPABILITY_*
+			                                              *   masks.
+			                                              */
+		} ATTR_PACKED USB_NCM_Descriptor_FunctionalNCM_t;
+
+		/** \brief NCM NTB Parameter Structure.
+		 *
+		 *  Type define for the response to the \ref NCM_REQ_GetNTBParameters request, describing the sizes and alignment
+		 *  of the Network Transfer Blocks the adapter can send and receive.
+		 */
+		typedef struct
+		{
+			uint16_t Length; /**< Size of this structure, in bytes. */
+			uint16_t NTBFormatsSupported; /**< Mask of supported NTB formats, \ref NCM_NTB_FORMAT_SUPPORTED_16BIT. */
+			uint32_t NTBInMaxSize; /**< Maximum size of an IN NTB the adapter can generate. */
+			uint16_t NDPInDivisor; /**< Modulus for the alignment of IN datagram payloads. */
+			uint16_t NDPInPayloadRemainder; /**< Remainder for the alignment of IN datagram payloads. */
+			uint16_t NDPInAlignment; /**< Alignment of IN NDP structures within the NTB. */
+			uint16_t Reserved;
+			uint32_t NTBOutMaxSize; /**< Maximum size of an OUT NTB the adapter can receive. */
+			uint16_t NDPOutDivisor; /**< Modulus for the alignment of OUT datagram payloads. */
+			uint16_t NDPOutPayloadRemainder; /**< Remainder for the alignment of OUT datagram payloads. */
+			uint16_t NDPOutAlignment; /**< Alignment of OUT NDP structures within the NTB. */
+			uint16_t NTBOutMaxDatagrams; /**< Maximum number of datagrams the adapter accepts in one OUT NTB, zero for no limit. */
+		} ATTR_PACKED NCM_NTB_Parameters_t;
+
+		/** \brief NCM 16-bit Transfer Header Structure.
+		 *
+		 *  Type define for the header placed at the start of every 16-bit Network Transfer Block.
+		 */
+		typedef struct
+		{
+			uint32_t Signature; /**< Header signature, must be \ref NCM_NTH16_SIGNATURE. */
+			uint16_t HeaderLength; /**< Size of this header, in bytes. */
+			uint16_t Sequence; /**< Sequence number of the NTB, incremented for each NTB sent. */
+			uint16_t BlockLength; /**< Total size of the NTB, in bytes. */
+			uint16_t NDPIndex; /**< Offset of the first NDP structure from the start of the NTB. */
+		} ATTR_PACKED NCM_NTH16_t;
+
+		/** \brief NCM 16-bit Datagram Pointer Entry Structure.
+		 *
+		 *  Type define for a single datagram reference within a 16-bit NCM Datagram Pointer Table.
+		 */
+		typedef struct
+		{
+			uint16_t DatagramIndex; /**< Offset of the datagram from the start of the NTB, zero to terminate the table. */
+			uint16_t DatagramLength; /**< Length of the datagram in bytes, zero to terminate the table. */
+		} ATTR_PACKED NCM_DatagramPointer16_t;
+
+		/** \brief NCM 16-bit Datagram Pointer Table Header Structure.
+		 *
+		 *  Type define for the header of a 16-bit NCM Datagram Pointer Table, which is followed by a zero-terminated
+		 *  list of \ref NCM_DatagramPointer16_t entries.
+		 */
+		typedef struct
+		{
+			uint32_t Signature; /**< Table signature, \ref NCM_NDP16_SIGNATURE_NOCRC for datagrams without CRC. */
+			uint16_t Length; /**< Size of the table including its terminating entry, in bytes. */
+			uint16_t NextNDPIndex; /**< Offset of the next NDP in the NTB, zero if this is the last table. */
+		} ATTR_PACKED NCM_NDP16_t;
+
+		/** \brief NCM Connection Speed Change Notification Data Structure.
+		 *
+		 *  Type define for the data payload of a \ref NCM_NOTIF_ConnectionSpeedChange notification.
+		 */
+		typedef struct
+		{
+			uint32_t DownlinkBitRate; /**< Bit rate of data sent from the device to the host, in bits per second. */
+			uint32_t UplinkBitRate; /**< Bit rate of data sent from the host to the device, in bits per second. */
+		} ATTR_PACKED NCM_ConnectionSpeed_t;
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
@@ -160,6 +160,9 @@
 		#define OID_GEN_XMIT_ERROR                    0x00020103UL
 		#define OID_GEN_RCV_ERROR                     0x00020104UL
 		#define OID_GEN_RCV_NO_BUFFER                 0x00020105UL
+		#define OID_GEN_BYTES_RCV                     0x00020219UL
+		#define OID_GEN_BYTES_XMIT                    0x0002021AUL
+		#define OID_GEN_RCV_DISCARDS                  0x0002021BUL
 		#define OID_802_3_PERMANENT_ADDRESS           0x01010101UL
 		#define OID_802_3_CURRENT_ADDRESS             0x01010102UL
 		#define OID_802_3_MULTICAST_LIST              0x01010103UL
@@ -175,6 +178,15 @@
 		/** Maximum size in bytes of an Ethernet frame according to the Ethernet standard. */
 		#define ETHERNET_FRAME_SIZE_MAX               1500
 
+		#if !defined(RNDIS_MULTICAST_LIST_SIZE_MAX) || defined(__DOXYGEN__)
+			/** Maximum number of multicast addresses the adapter reports it can filter on. As multicast addresses are stored
+			 *  in a hash table rather than an exact match list there is no RAM cost to a larger value, only a higher chance
+			 *  of unwanted frames passing the filter. This may be overridden in the user project makefile by passing the
+			 *  \c RNDIS_MULTICAST_LIST_SIZE_MAX token to the compiler via the -D switch.
+			 */
+			#define RNDIS_MULTICAST_LIST_SIZE_MAX     32
+		#endif
+
 	/* Enums: */
 		/** Enum for the RNDIS class specific control requests that can be issued by the USB bus host. */
 		enum RNDIS_ClassRequests_t
@@ -42,6 +42,12 @@ void Audio_Device_ProcessControlRequest(USB_ClassInfo_Audio_Device_t* const Audi
 	if (!(Endpoint_IsSETUPReceived()))
 	  return;
 
+	if ((USB_ControlRequest.bmRequestType & CONTROL_REQTYPE_RECIPIENT) == REQREC_ENDPOINT)
+	{
+		Audio_Device_ProcessEndpointRequest(AudioInterfaceInfo);
+		return;
+	}
+
 	if (USB_ControlRequest.wIndex != AudioInterfaceInfo->Config.StreamingInterfaceNumber)
 	  return;
 
@@ -54,6 +60,7 @@ void Audio_Device_ProcessControlRequest(USB_ClassInfo_Audio_Device_t* const Audi
 				Endpoint_ClearStatusStage();
 
 				AudioInterfaceInfo->State.InterfaceEnabled = ((USB_ControlRequest.wValue & 0xFF) != 0);
+				Audio_Device_ResetFIFOs(AudioInterfaceInfo);
 			}
 
 			break;
@@ -82,6 +89,12 @@ bool Audio_Device_ConfigureEndpoints(USB_ClassInfo_Audio_Device_t* const AudioIn
 			Direction    = ENDPOINT_DIR_OUT;
 			Type         = EP_TYPE_ISOCHRONOUS;
 		}
+		else if (EndpointNum == AudioInterfaceInfo->Config.FeedbackEndpointNumber)
+		{
+			Size         = AudioInterfaceInfo->Config.FeedbackEndpointSize;
+			Direction    = ENDPOINT_DIR_IN;
+			Type         = EP_TYPE_ISOCHRONOUS;
+		}
 		else
 		{
 			continue;
@@ -91,7 +104,551 @@ bool Audio_Device_ConfigureEndpoints(USB_ClassInfo_Audio_Device_t* const AudioIn
 		  return false;
 	}
 
+	AudioInterfaceInfo->State.CurrentSampleRate = AudioInterfaceInfo->Config.SampleRate;
+	Audio_Device_ResetFIFOs(AudioInterfaceInfo);
+
 	return true;
 }
 
+void Audio_Device_StartOfFrame(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	uint8_t FrameSize = AudioInterfaceInfo->Config.SampleFrameSize;
+
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(AudioInterfaceInfo->State.InterfaceEnabled) ||
+	    !(AudioInterfaceInfo->State.CurrentSampleRate) || !(FrameSize) || !(AudioInterfaceInfo->Config.PacketBuffer))
+	{
+		return;
+	}
+
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
+	uint8_t* PacketBuffer        = AudioInterfaceInfo->Config.PacketBuffer;
+
+	/* Work out this frame's share of samples, carrying fractional samples over so that the long term rate is exact */
+	uint32_t SampleCount = (AudioInterfaceInfo->State.CurrentSampleRate + AudioInterfaceInfo->State.SampleRateRemainder);
+	AudioInterfaceInfo->State.SampleRateRemainder = (SampleCount % 1000);
+	SampleCount /= 1000;
+
+	if (AudioInterfaceInfo->Config.DataINEndpointNumber && AudioInterfaceInfo->Config.INFIFO)
+	{
+		Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.DataINEndpointNumber);
+
+		if (Endpoint_IsINReady())
+		{
+			uint16_t MaxFrames   = (MIN(AudioInterfaceInfo->Config.DataINEndpointSize, AUDIO_DEVICE_PACKET_BUFFER_SIZE) / FrameSize);
+			uint16_t PacketSize  = (MIN(SampleCount, MaxFrames) * FrameSize);
+			uint16_t ReadIndex   = AudioInterfaceInfo->State.INFIFOReadIndex;
+			uint16_t BytesQueued = (uint16_t)(AudioInterfaceInfo->State.INFIFOWriteIndex - ReadIndex);
+			uint16_t BytesToSend = MIN(BytesQueued, PacketSize);
+
+			BytesToSend -= (BytesToSend % FrameSize);
+
+			Audio_Device_CopyFromFIFO(AudioInterfaceInfo->Config.INFIFO, ReadIndex, PacketBuffer, BytesToSend);
+			AudioInterfaceInfo->State.INFIFOReadIndex = (ReadIndex + BytesToSend);
+
+			if (BytesToSend < PacketSize)
+			{
+				memset(&PacketBuffer[BytesToSend], 0x00, (PacketSize - BytesToSend));
+				AudioInterfaceInfo->State.INUnderruns++;
+			}
+
+			Endpoint_write_buf(PacketBuffer, PacketSize);
+			Endpoint_ClearIN();
+		}
+	}
+
+	if (AudioInterfaceInfo->Config.DataOUTEndpointNumber && AudioInterfaceInfo->Config.OUTFIFO)
+	{
+		Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.DataOUTEndpointNumber);
+
+		if (Endpoint_IsOUTReceived())
+		{
+			uint16_t PacketSize = MIN(Endpoint_Read_buf(PacketBuffer, AUDIO_DEVICE_PACKET_BUFFER_SIZE), AUDIO_DEVICE_PACKET_BUFFER_SIZE);
+			Endpoint_ClearOUT();
+
+			uint16_t WriteIndex = AudioInterfaceInfo->State.OUTFIFOWriteIndex;
+			uint16_t BytesFree  = (AUDIO_DEVICE_FIFO_SIZE - (uint16_t)(WriteIndex - AudioInterfaceInfo->State.OUTFIFOReadIndex));
+			uint16_t BytesToAdd = (PacketSize - (PacketSize % FrameSize));
+
+			if (BytesToAdd > BytesFree)
+			{
+				BytesToAdd = (BytesFree - (BytesFree % FrameSize));
+				AudioInterfaceInfo->State.OUTOverruns++;
+			}
+
+			Audio_Device_CopyToFIFO(AudioInterfaceInfo->Config.OUTFIFO, WriteIndex, PacketBuffer, BytesToAdd);
+			AudioInterfaceInfo->State.OUTFIFOWriteIndex = (WriteIndex + BytesToAdd);
+		}
+
+		if (AudioInterfaceInfo->Config.FeedbackEndpointNumber)
+		  Audio_Device_UpdateFeedback(AudioInterfaceInfo);
+	}
+
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+}
+
+uint16_t Audio_Device_WriteFIFO(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+                                const void* const Buffer,
+                                const uint16_t Length)
+{
+	if (!(AudioInterfaceInfo->Config.INFIFO))
+	  return 0;
+
+	uint8_t  FrameSize  = MAX(AudioInterfaceInfo->Config.SampleFrameSize, 1);
+	uint16_t WriteIndex = AudioInterfaceInfo->State.INFIFOWriteIndex;
+	uint16_t BytesFree  = Audio_Device_INFIFOFree(AudioInterfaceInfo);
+	uint16_t BytesToAdd = Length;
+
+	if (BytesToAdd > BytesFree)
+	{
+		BytesToAdd = (BytesFree - (BytesFree % FrameSize));
+		AudioInterfaceInfo->State.INOverruns++;
+	}
+
+	Audio_Device_CopyToFIFO(AudioInterfaceInfo->Config.INFIFO, WriteIndex, Buffer, BytesToAdd);
+	AudioInterfaceInfo->State.INFIFOWriteIndex = (WriteIndex + BytesToAdd);
+
+	return BytesToAdd;
+}
+
+uint16_t Audio_Device_ReadFIFO(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+                               void* const Buffer,
+                               const uint16_t Length)
+{
+	if (!(AudioInterfaceInfo->Config.OUTFIFO))
+	  return 0;
+
+	uint8_t  FrameSize     = MAX(AudioInterfaceInfo->Config.SampleFrameSize, 1);
+	uint16_t ReadIndex     = AudioInterfaceInfo->State.OUTFIFOReadIndex;
+	uint16_t BytesQueued   = Audio_Device_OUTFIFOCount(AudioInterfaceInfo);
+	uint16_t BytesToRemove = Length;
+
+	if (BytesToRemove > BytesQueued)
+	{
+		BytesToRemove = (BytesQueued - (BytesQueued % FrameSize));
+		memset(&((uint8_t*)Buffer)[BytesToRemove], 0x00, (Length - BytesToRemove));
+		AudioInterfaceInfo->State.OUTUnderruns++;
+	}
+
+	Audio_Device_CopyFromFIFO(AudioInterfaceInfo->Config.OUTFIFO, ReadIndex, Buffer, BytesToRemove);
+	AudioInterfaceInfo->State.OUTFIFOReadIndex = (ReadIndex + BytesToRemove);
+
+	return BytesToRemove;
+}
+
+uint16_t Audio_Device_WriteFrames(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+                                  const void* const Buffer,
+                                  const uint16_t FrameCount,
+                                  const uint8_t Format)
+{
+	uint8_t SubframeSize = AudioInterfaceInfo->Config.SampleSubframeSize;
+	uint8_t FrameSize    = AudioInterfaceInfo->Config.SampleFrameSize;
+
+	if (!(SubframeSize) || (FrameSize < SubframeSize) || !(AudioInterfaceInfo->Config.INFIFO))
+	  return 0;
+
+	uint8_t  SampleWidth  = (Format == AUDIO_SAMPLE_FORMAT_Q15) ? sizeof(int16_t) : sizeof(int32_t);
+	uint16_t FramesToAdd  = MIN(FrameCount, (Audio_Device_INFIFOFree(AudioInterfaceInfo) / FrameSize));
+	uint32_t SamplesLeft  = ((uint32_t)FramesToAdd * (FrameSize / SubframeSize));
+	uint16_t WriteIndex   = AudioInterfaceInfo->State.INFIFOWriteIndex;
+	const uint8_t* AppBuffer = (const uint8_t*)Buffer;
+
+	uint8_t Chunk[AUDIO_DEVICE_CONVERT_CHUNK_SIZE] ATTR_ALIGNED(4);
+
+	while (SamplesLeft)
+	{
+		uint16_t Samples = MIN(SamplesLeft, (sizeof(Chunk) / SubframeSize));
+
+		if (SubframeSize == 3)
+		  Audio_Device_Pack24(AppBuffer, Chunk, Samples, Format);
+		else
+		  Audio_Device_Pack16(AppBuffer, Chunk, Samples, Format);
+
+		Audio_Device_CopyToFIFO(AudioInterfaceInfo->Config.INFIFO, WriteIndex, Chunk, (Samples * SubframeSize));
+
+		WriteIndex  += (Samples * SubframeSize);
+		AppBuffer   += (Samples * SampleWidth);
+		SamplesLeft -= Samples;
+	}
+
+	AudioInterfaceInfo->State.INFIFOWriteIndex = WriteIndex;
+
+	if (FramesToAdd < FrameCount)
+	  AudioInterfaceInfo->State.INOverruns++;
+
+	return FramesToAdd;
+}
+
+uint16_t Audio_Device_ReadFrames(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+                                 void* const Buffer,
+                                 const uint16_t FrameCount,
+                                 const uint8_t Format)
+{
+	uint8_t SubframeSize = AudioInterfaceInfo->Config.SampleSubframeSize;
+	uint8_t FrameSize    = AudioInterfaceInfo->Config.SampleFrameSize;
+
+	if (!(SubframeSize) || (FrameSize < SubframeSize) || !(AudioInterfaceInfo->Config.OUTFIFO))
+	  return 0;
+
+	uint8_t  SampleWidth  = (Format == AUDIO_SAMPLE_FORMAT_Q15) ? sizeof(int16_t) : sizeof(int32_t);
+	uint8_t  Channels     = (FrameSize / SubframeSize);
+	uint16_t FramesToRead = MIN(FrameCount, (Audio_Device_OUTFIFOCount(AudioInterfaceInfo) / FrameSize));
+	uint32_t SamplesLeft  = ((uint32_t)FramesToRead * Channels);
+	uint16_t ReadIndex    = AudioInterfaceInfo->State.OUTFIFOReadIndex;
+	uint8_t* AppBuffer    = (uint8_t*)Buffer;
+
+	uint8_t Chunk[AUDIO_DEVICE_CONVERT_CHUNK_SIZE] ATTR_ALIGNED(4);
+
+	while (SamplesLeft)
+	{
+		uint16_t Samples = MIN(SamplesLeft, (sizeof(Chunk) / SubframeSize));
+
+		Audio_Device_CopyFromFIFO(AudioInterfaceInfo->Config.OUTFIFO, ReadIndex, Chunk, (Samples * SubframeSize));
+
+		if (SubframeSize == 3)
+		  Audio_Device_Unpack24(Chunk, AppBuffer, Samples, Format);
+		else
+		  Audio_Device_Unpack16(Chunk, AppBuffer, Samples, Format);
+
+		ReadIndex   += (Samples * SubframeSize);
+		AppBuffer   += (Samples * SampleWidth);
+		SamplesLeft -= Samples;
+	}
+
+	AudioInterfaceInfo->State.OUTFIFOReadIndex = ReadIndex;
+
+	if (FramesToRead < FrameCount)
+	{
+		memset(AppBuffer, 0x00, ((uint32_t)(FrameCount - FramesToRead) * Channels * SampleWidth));
+		AudioInterfaceInfo->State.OUTUnderruns++;
+	}
+
+	return FramesToRead;
+}
+
+static void Audio_Device_ResetFIFOs(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	/* The SOF interrupt must not update the FIFO indexes part way through the reset, or it would write back stale ones */
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	AudioInterfaceInfo->State.INFIFOWriteIndex    = 0;
+	AudioInterfaceInfo->State.INFIFOReadIndex     = 0;
+	AudioInterfaceInfo->State.OUTFIFOWriteIndex   = 0;
+	AudioInterfaceInfo->State.OUTFIFOReadIndex    = 0;
+	AudioInterfaceInfo->State.SampleRateRemainder = 0;
+
+	/* Restart the feedback loop from the nominal rate, with the OUT FIFO assumed to be at its half full target level */
+	uint32_t SampleRate = AudioInterfaceInfo->State.CurrentSampleRate;
+
+	AudioInterfaceInfo->State.FeedbackValue        = (((SampleRate / 1000) << 16) | (((SampleRate % 1000) << 16) / 1000));
+	AudioInterfaceInfo->State.FeedbackFilteredFill = ((uint32_t)(AUDIO_DEVICE_FIFO_SIZE / 2) << 8);
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+}
+
+static void Audio_Device_UpdateFeedback(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	uint32_t SampleRate      = AudioInterfaceInfo->State.CurrentSampleRate;
+	uint32_t NominalFeedback = (((SampleRate / 1000) << 16) | (((SampleRate % 1000) << 16) / 1000));
+	int32_t  MaxCorrection   = (NominalFeedback >> 5);
+
+	/* Low pass filter the OUT FIFO fill level to reject the jitter of the application's reads against the USB frames */
+	int32_t FillDelta = ((int32_t)((uint32_t)Audio_Device_OUTFIFOCount(AudioInterfaceInfo) << 8) -
+	                     (int32_t)AudioInterfaceInfo->State.FeedbackFilteredFill);
+	AudioInterfaceInfo->State.FeedbackFilteredFill += (FillDelta / (1 << AUDIO_DEVICE_FEEDBACK_FILTER_SHIFT));
+
+	/* A FIFO below its target level means the device clock is consuming samples faster than the host sends them */
+	int32_t FillError  = ((int32_t)((uint32_t)(AUDIO_DEVICE_FIFO_SIZE / 2) << 8) - (int32_t)AudioInterfaceInfo->State.FeedbackFilteredFill);
+	int32_t Correction = (((FillError / AudioInterfaceInfo->Config.SampleFrameSize) << 8) / (1 << AUDIO_DEVICE_FEEDBACK_GAIN_SHIFT));
+
+	if (Correction > MaxCorrection)
+	  Correction = MaxCorrection;
+	else if (Correction < -MaxCorrection)
+	  Correction = -MaxCorrection;
+
+	AudioInterfaceInfo->State.FeedbackValue = (NominalFeedback + Correction);
+
+	Endpoint_SelectEndpoint(AudioInterfaceInfo->Config.FeedbackEndpointNumber);
+
+	if (Endpoint_IsINReady())
+	{
+		uint32_t FeedbackData = AudioInterfaceInfo->State.FeedbackValue;
+
+		/* Full speed feedback endpoints report the rate in the 10.14 format, in the lowest three bytes */
+		if (AudioInterfaceInfo->Config.FeedbackEndpointSize < sizeof(uint32_t))
+		  FeedbackData >>= 2;
+
+		Endpoint_write_buf((uint8_t*)&FeedbackData, MIN(AudioInterfaceInfo->Config.FeedbackEndpointSize, sizeof(uint32_t)));
+		Endpoint_ClearIN();
+	}
+}
+
+static void Audio_Device_ProcessEndpointRequest(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+{
+	uint8_t EndpointAddress = (USB_ControlRequest.wIndex & 0xFF);
+
+	if (!((AudioInterfaceInfo->Config.DataINEndpointNumber &&
+	       (EndpointAddress == (AudioInterfaceInfo->Config.DataINEndpointNumber | ENDPOINT_DESCRIPTOR_DIR_IN))) ||
+	      (AudioInterfaceInfo->Config.DataOUTEndpointNumber &&
+	       (EndpointAddress == AudioInterfaceInfo->Config.DataOUTEndpointNumber))))
+	{
+		return;
+	}
+
+	if ((USB_ControlRequest.wValue >> 8) != AUDIO_EPCONTROL_SamplingFreq)
+	  return;
+
+	uint8_t SampleRate[3];
+
+	switch (USB_ControlRequest.bRequest)
+	{
+		case AUDIO_REQ_SetCurrent:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_ENDPOINT))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_Read_Control_Stream_LE(SampleRate, sizeof(SampleRate));
+				Endpoint_ClearIN();
+
+				AudioInterfaceInfo->State.CurrentSampleRate = (((uint32_t)SampleRate[2] << 16) | ((uint32_t)SampleRate[1] << 8) |
+				                                               SampleRate[0]);
+				Audio_Device_ResetFIFOs(AudioInterfaceInfo);
+
+				EVENT_Audio_Device_SampleRateChanged(AudioInterfaceInfo);
+			}
+
+			break;
+		case AUDIO_REQ_GetCurrent:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_ENDPOINT))
+			{
+				SampleRate[0] = (AudioInterfaceInfo->State.CurrentSampleRate & 0xFF);
+				SampleRate[1] = ((AudioInterfaceInfo->State.CurrentSampleRate >> 8) & 0xFF);
+				SampleRate[2] = ((AudioInterfaceInfo->State.CurrentSampleRate >> 16) & 0xFF);
+
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(SampleRate, sizeof(SampleRate));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+	}
+}
+
+static void Audio_Device_CopyFromFIFO(const uint8_t* const FIFO,
+                                      const uint16_t ReadIndex,
+                                      uint8_t* const Buffer,
+                                      const uint16_t Length)
+{
+	uint16_t FIFOOffset   = (ReadIndex & (AUDIO_DEVICE_FIFO_SIZE - 1));
+	uint16_t FirstSegment = MIN(Length, (AUDIO_DEVICE_FIFO_SIZE - FIFOOffset));
+
+	memcpy(Buffer, &FIFO[FIFOOffset], FirstSegment);
+	memcpy(&Buffer[FirstSegment], FIFO, (Length - FirstSegment));
+}
+
+static void Audio_Device_CopyToFIFO(uint8_t* const FIFO,
+                                    const uint16_t WriteIndex,
+                                    const uint8_t* const Buffer,
+                                    const uint16_t Length)
+{
+	uint16_t FIFOOffset   = (WriteIndex & (AUDIO_DEVICE_FIFO_SIZE - 1));
+	uint16_t FirstSegment = MIN(Length, (AUDIO_DEVICE_FIFO_SIZE - FIFOOffset));
+
+	memcpy(&FIFO[FIFOOffset], Buffer, FirstSegment);
+	memcpy(FIFO, &Buffer[FirstSegment], (Length - FirstSegment));
+}
+
+static void Audio_Device_Unpack16(const uint8_t* Source,
+                                  void* const Destination,
+                                  uint16_t Samples,
+                                  const uint8_t Format)
+{
+	/* Q15 samples are identical to 16-bit little endian USB samples */
+	if (Format == AUDIO_SAMPLE_FORMAT_Q15)
+	{
+		memcpy(Destination, Source, (Samples * sizeof(int16_t)));
+		return;
+	}
+
+	const uint32_t* SourceWords = (const uint32_t*)Source;
+	int32_t*        Samples32   = (int32_t*)Destination;
+	uint8_t         Shift       = (Format == AUDIO_SAMPLE_FORMAT_Int32) ? 16 : 0;
+
+	while (Samples >= 4)
+	{
+		uint32_t Word0 = SourceWords[0];
+		uint32_t Word1 = SourceWords[1];
+
+		Samples32[0] = ((int32_t)(Word0 << 16) >> Shift);
+		Samples32[1] = ((int32_t)(Word0 & 0xFFFF0000) >> Shift);
+		Samples32[2] = ((int32_t)(Word1 << 16) >> Shift);
+		Samples32[3] = ((int32_t)(Word1 & 0xFFFF0000) >> Shift);
+
+		SourceWords += 2;
+		Samples32   += 4;
+		Samples     -= 4;
+	}
+
+	Source = (const uint8_t*)SourceWords;
+
+	while (Samples--)
+	{
+		*(Samples32++) = ((int32_t)(((uint32_t)Source[1] << 24) | ((uint32_t)Source[0] << 16)) >> Shift);
+		Source += 2;
+	}
+}
+
+static void Audio_Device_Unpack24(const uint8_t* Source,
+                                  void* const Destination,
+                                  uint16_t Samples,
+                                  const uint8_t Format)
+{
+	const uint32_t* SourceWords = (const uint32_t*)Source;
+	int16_t*        Samples16   = (int16_t*)Destination;
+	int32_t*        Samples32   = (int32_t*)Destination;
+	uint8_t         Shift       = (Format == AUDIO_SAMPLE_FORMAT_Int32) ? 8 : 0;
+
+	/* Every three words hold four packed samples, which are unpacked into left justified Q31 values */
+	while (Samples >= 4)
+	{
+		uint32_t Word0 = SourceWords[0];
+		uint32_t Word1 = SourceWords[1];
+		uint32_t Word2 = SourceWords[2];
+
+		int32_t Sample0 = (int32_t)(Word0 << 8);
+		int32_t Sample1 = (int32_t)(((Word0 >> 16) & 0x0000FF00) | (Word1 << 16));
+		int32_t Sample2 = (int32_t)(((Word1 >> 8)  & 0x00FFFF00) | (Word2 << 24));
+		int32_t Sample3 = (int32_t)(Word2 & 0xFFFFFF00);
+
+		if (Format == AUDIO_SAMPLE_FORMAT_Q15)
+		{
+			Samples16[0] = (Sample0 >> 16);
+			Samples16[1] = (Sample1 >> 16);
+			Samples16[2] = (Sample2 >> 16);
+			Samples16[3] = (Sample3 >> 16);
+			Samples16   += 4;
+		}
+		else
+		{
+			Samples32[0] = (Sample0 >> Shift);
+			Samples32[1] = (Sample1 >> Shift);
+			Samples32[2] = (Sample2 >> Shift);
+			Samples32[3] = (Sample3 >> Shift);
+			Samples32   += 4;
+		}
+
+		SourceWords += 3;
+		Samples     -= 4;
+	}
+
+	Source = (const uint8_t*)SourceWords;
+
+	while (Samples--)
+	{
+		int32_t Sample = (int32_t)(((uint32_t)Source[2] << 24) | ((uint32_t)Source[1] << 16) | ((uint32_t)Source[0] << 8));
+
+		if (Format == AUDIO_SAMPLE_FORMAT_Q15)
+		  *(Samples16++) = (Sample >> 16);
+		else
+		  *(Samples32++) = (Sample >> Shift);
+
+		Source += 3;
+	}
+}
+
+static void Audio_Device_Pack16(const void* const Source,
+                                uint8_t* Destination,
+                                uint16_t Samples,
+                                const uint8_t Format)
+{
+	/* Q15 samples are identical to 16-bit little endian USB samples */
+	if (Format == AUDIO_SAMPLE_FORMAT_Q15)
+	{
+		memcpy(Destination, Source, (Samples * sizeof(int16_t)));
+		return;
+	}
+
+	const uint32_t* Samples32        = (const uint32_t*)Source;
+	uint32_t*       DestinationWords = (uint32_t*)Destination;
+	uint8_t         Shift            = (Format == AUDIO_SAMPLE_FORMAT_Int32) ? 16 : 0;
+
+	while (Samples >= 4)
+	{
+		DestinationWords[0] = (((Samples32[0] << Shift) >> 16) | ((Samples32[1] << Shift) & 0xFFFF0000));
+		DestinationWords[1] = (((Samples32[2] << Shift) >> 16) | ((Samples32[3] << Shift) & 0xFFFF0000));
+
+		Samples32        += 4;
+		DestinationWords += 2;
+		Samples          -= 4;
+	}
+
+	Destination = (uint8_t*)DestinationWords;
+
+	while (Samples--)
+	{
+		uint32_t Sample = (*(Samples32++) << Shift);
+
+		Destination[0] = (Sample >> 16);
+		Destination[1] = (Sample >> 24);
+		Destination   += 2;
+	}
+}
+
+static void Audio_Device_Pack24(const void* const Source,
+                                uint8_t* Destination,
+                                uint16_t Samples,
+                                const uint8_t Format)
+{
+	const uint16_t* Samples16        = (const uint16_t*)Source;
+	const uint32_t* Samples32        = (const uint32_t*)Source;
+	uint32_t*       DestinationWords = (uint32_t*)Destination;
+	uint8_t         Shift            = (Format == AUDIO_SAMPLE_FORMAT_Int32) ? 8 : 0;
+
+	/* Samples are converted to left justified Q31 values, four of which are then packed into every three words */
+	while (Samples >= 4)
+	{
+		uint32_t Sample0, Sample1, Sample2, Sample3;
+
+		if (Format == AUDIO_SAMPLE_FORMAT_Q15)
+		{
+			Sample0 = ((uint32_t)Samples16[0] << 16);
+			Sample1 = ((uint32_t)Samples16[1] << 16);
+			Sample2 = ((uint32_t)Samples16[2] << 16);
+			Sample3 = ((uint32_t)Samples16[3] << 16);
+			Samples16 += 4;
+		}
+		else
+		{
+			Sample0 = (Samples32[0] << Shift);
+			Sample1 = (Samples32[1] << Shift);
+			Sample2 = (Samples32[2] << Shift);
+			Sample3 = (Samples32[3] << Shift);
+			Samples32 += 4;
+		}
+
+		DestinationWords[0] = ((Sample0 >> 8)  | ((Sample1 << 16) & 0xFF000000));
+		DestinationWords[1] = ((Sample1 >> 16) | ((Sample2 << 8)  & 0xFFFF0000));
+		DestinationWords[2] = ((Sample2 >> 24) | (Sample3 & 0xFFFFFF00));
+
+		DestinationWords += 3;
+		Samples          -= 4;
+	}
+
+	Destination = (uint8_t*)DestinationWords;
+
+	while (Samples--)
+	{
+		uint32_t Sample = (Format == AUDIO_SAMPLE_FORMAT_Q15) ? ((uint32_t)*(Samples16++) << 16) : (*(Samples32++) << Shift);
+
+		Destination[0] = (Sample >> 8);
+		Destination[1] = (Sample >> 16);
+		Destination[2] = (Sample >> 24);
+		Destination   += 3;
+	}
+}
+
+void Audio_Device_Event_Stub(void)
+{
+
+}
+
 #endif
@@ -68,6 +68,67 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(AUDIO_DEVICE_FIFO_SIZE) || defined(__DOXYGEN__)
+				/** Size in bytes of each of the IN and OUT sample FIFOs used by the SOF driven streaming engine, which must be a
+				 *  power of two. The FIFOs are supplied by the application through the interface's configuration. Each FIFO
+				 *  should hold several frames worth of samples to absorb the jitter between the USB frame timing and the
+				 *  application's audio processing. This may be overridden in the user project makefile by passing
+				 *  the \c AUDIO_DEVICE_FIFO_SIZE token to the compiler via the -D switch.
+				 */
+				#define AUDIO_DEVICE_FIFO_SIZE          1024
+			#endif
+
+			#if !defined(AUDIO_DEVICE_PACKET_BUFFER_SIZE) || defined(__DOXYGEN__)
+				/** Size in bytes of the application supplied buffer used by the SOF driven streaming engine to stage each
+				 *  isochronous packet, which must be a multiple of four no smaller than either of the interface's streaming
+				 *  endpoint sizes. This may be overridden in the user project makefile by passing the
+				 *  \c AUDIO_DEVICE_PACKET_BUFFER_SIZE token to the compiler via the -D switch.
+				 */
+				#define AUDIO_DEVICE_PACKET_BUFFER_SIZE 256
+			#endif
+
+			#if !defined(AUDIO_DEVICE_FEEDBACK_FILTER_SHIFT) || defined(__DOXYGEN__)
+				/** Strength of the low pass filter applied to the OUT FIFO fill level by the asynchronous rate feedback loop,
+				 *  as a power of two number of frames. Larger values reject more jitter at the expense of a slower response. This
+				 *  may be overridden in the user project makefile by passing the \c AUDIO_DEVICE_FEEDBACK_FILTER_SHIFT token to
+				 *  the compiler via the -D switch.
+				 */
+				#define AUDIO_DEVICE_FEEDBACK_FILTER_SHIFT  4
+			#endif
+
+			#if !defined(AUDIO_DEVICE_FEEDBACK_GAIN_SHIFT) || defined(__DOXYGEN__)
+				/** Inverse gain of the asynchronous rate feedback loop, as a power of two. The rate reported to the host is
+				 *  corrected by the filtered OUT FIFO fill level error in audio frames divided by two to the power of this value,
+				 *  in samples per frame. This may be overridden in the user project makefile by passing the
+				 *  \c AUDIO_DEVICE_FEEDBACK_GAIN_SHIFT token to the compiler via the -D switch.
+				 */
+				#define AUDIO_DEVICE_FEEDBACK_GAIN_SHIFT    6
+			#endif
+
+			#if (AUDIO_DEVICE_FIFO_SIZE & (AUDIO_DEVICE_FIFO_SIZE - 1)) || (AUDIO_DEVICE_FIFO_SIZE > 32768)
+				#error AUDIO_DEVICE_FIFO_SIZE must be a power of two no larger than 32768.
+			#endif
+
+			#if (AUDIO_DEVICE_PACKET_BUFFER_SIZE % 4)
+				#error AUDIO_DEVICE_PACKET_BUFFER_SIZE must be a multiple of four.
+			#endif
+
+		/* Enums: */
+			/** Enum for the application sample formats supported by the block sample transfer functions
+			 *  \ref Audio_Device_ReadFrames() and \ref Audio_Device_WriteFrames().
+			 */
+			enum Audio_Device_SampleFormats_t
+			{
+				AUDIO_SAMPLE_FORMAT_Int32 = 0, /**< Signed 32-bit integers holding the sample value at the resolution of the USB
+				                                *   streaming format, i.e. right justified and sign extended.
+				                                */
+				AUDIO_SAMPLE_FORMAT_Q15   = 1, /**< Signed 16-bit Q15 fixed point fractions, with the least significant bits of
+				                                *   24-bit USB samples truncated.
+				                                */
+				AUDIO_SAMPLE_FORMAT_Q31   = 2, /**< Signed 32-bit Q31 fixed point fractions, i.e. left justified samples. */
+			};
+
 		/* Type Defines: */
 			/** \brief Audio Class Device Mode Configuration and State Structure.
 			 *
@@ -96,6 +157,37 @@
 					uint16_t DataOUTEndpointSize; /**< Size in bytes of the outgoing Audio Streaming data endpoint, if available
 												   *   (zero if unused).
 												   */
+
+					uint32_t SampleRate; /**< Nominal sample rate of the streaming interface in Hz, used by the SOF driven streaming
+										  *   engine to determine the number of samples moved each frame (zero if the engine is unused).
+										  */
+					uint8_t  SampleFrameSize; /**< Size in bytes of a single audio frame, i.e. one sample of every channel, in the
+											   *   USB streaming format (zero if the SOF driven streaming engine is unused).
+											   */
+					uint8_t  SampleSubframeSize; /**< Size in bytes of a single sample of one channel in the USB streaming format,
+												  *   either 2 or 3, used by the block sample transfer functions (zero if unused).
+												  */
+
+					uint8_t  FeedbackEndpointNumber; /**< Endpoint number of the asynchronous rate feedback endpoint associated with the
+													  *   outgoing Audio Streaming data endpoint, if available (zero if unused).
+													  */
+					uint8_t  FeedbackEndpointSize; /**< Size in bytes of the feedback endpoint, which also selects the feedback format;
+													*   3 for the full speed 10.14 format, or 4 for the 16.16 format.
+													*/
+
+					uint8_t* INFIFO; /**< Pointer to a word aligned buffer of \ref AUDIO_DEVICE_FIFO_SIZE bytes, holding the samples
+									  *   queued by the application for transmission to the host (\c NULL if the SOF driven
+									  *   streaming engine does not send to the host).
+									  */
+					uint8_t* OUTFIFO; /**< Pointer to a word aligned buffer of \ref AUDIO_DEVICE_FIFO_SIZE bytes, holding the samples
+									   *   received from the host awaiting the application (\c NULL if the SOF driven streaming
+									   *   engine does not receive from the host).
+									   */
+					uint8_t* PacketBuffer; /**< Pointer to a word aligned buffer of \ref AUDIO_DEVICE_PACKET_BUFFER_SIZE bytes, used
+											*   to stage the isochronous packet of the current frame (\c NULL if the SOF driven
+											*   streaming engine is unused). This may be shared between interfaces whose
+											*   \ref Audio_Device_StartOfFrame() calls do not preempt one another.
+											*/
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
@@ -104,6 +196,23 @@
 					bool     InterfaceEnabled; /**< Set and cleared by the class driver to indicate if the host has enabled the streaming endpoints
 												*   of the Audio Streaming interface.
 												*/
+
+					volatile uint16_t INFIFOWriteIndex; /**< Free running write index of the IN FIFO, advanced by the application. */
+					volatile uint16_t INFIFOReadIndex; /**< Free running read index of the IN FIFO, advanced each frame. */
+					volatile uint16_t OUTFIFOWriteIndex; /**< Free running write index of the OUT FIFO, advanced each frame. */
+					volatile uint16_t OUTFIFOReadIndex; /**< Free running read index of the OUT FIFO, advanced by the application. */
+					uint32_t CurrentSampleRate; /**< Sample rate in Hz currently used to pace the SOF driven streaming engine. */
+					uint16_t SampleRateRemainder; /**< Fractional samples per frame carried over to the following frame, in
+					                               *   thousandths of a sample.
+					                               */
+					uint32_t INUnderruns; /**< Number of frames padded with silence due to insufficient samples in the IN FIFO. */
+					uint32_t INOverruns; /**< Number of times application samples were dropped due to a full IN FIFO. */
+					uint32_t OUTUnderruns; /**< Number of times the application's read was padded with silence due to an empty OUT FIFO. */
+					uint32_t OUTOverruns; /**< Number of frames whose samples were dropped due to a full OUT FIFO. */
+					uint32_t FeedbackValue; /**< Sample rate last reported to the host through the feedback endpoint, in samples per
+					                         *   frame as a 16.16 fixed point number.
+					                         */
+					uint32_t FeedbackFilteredFill; /**< Low pass filtered OUT FIFO fill level in bytes, as a 24.8 fixed point number. */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -131,6 +240,93 @@
 			 */
 			void Audio_Device_ProcessControlRequest(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Runs the SOF driven streaming engine of the given Audio class interface for one USB frame. Exactly one frame's
+			 *  worth of samples, as given by the interface's sample rate, is drained from the IN FIFO into the streaming IN
+			 *  endpoint, padding with silence on underrun, and any packet received on the streaming OUT endpoint is added to the
+			 *  OUT FIFO, dropping whole audio frames on overrun. This should be linked to the library
+			 *  \ref EVENT_USB_Device_StartOfFrame() event, once SOF events have been enabled via \ref USB_Device_EnableSOFEvents().
+			 *
+			 *  \note This function does nothing if the interface's \c SampleRate or \c SampleFrameSize configuration elements are
+			 *        zero, or if no \c PacketBuffer is supplied, in which case the per-sample functions should be used instead.
+			 *        Each direction is only streamed when its FIFO is supplied in the interface's configuration.
+			 *        \n\n
+			 *
+			 *  \note This function is called from the USB interrupt; the driver holds off the interrupt while the main program
+			 *        is part way through an endpoint packet and restores the main program's selected endpoint afterwards, so the
+			 *        streaming endpoints may still be used from the main program with the per-sample functions.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 */
+			void Audio_Device_StartOfFrame(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Converts and queues a block of interleaved application samples for transmission to the host through the SOF driven
+			 *  streaming engine, packing them into the USB streaming format given by the interface's \c SampleSubframeSize. Audio
+			 *  frames which do not fit in the IN FIFO are dropped and counted as an IN overrun.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[in]     Buffer              Pointer to the interleaved samples to queue, in the given application format.
+			 *  \param[in]     FrameCount          Number of audio frames, i.e. samples of every channel, to queue.
+			 *  \param[in]     Format              Format of the samples in the buffer, a value from the \ref Audio_Device_SampleFormats_t enum.
+			 *
+			 *  \return Number of audio frames queued into the IN FIFO.
+			 */
+			uint16_t Audio_Device_WriteFrames(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                  const void* const Buffer,
+			                                  const uint16_t FrameCount,
+			                                  const uint8_t Format) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Retrieves and converts a block of interleaved samples received from the host through the SOF driven streaming engine,
+			 *  unpacking them from the USB streaming format given by the interface's \c SampleSubframeSize. If fewer audio frames
+			 *  than requested are available in the OUT FIFO, the remainder of the buffer is padded with silence and counted as an
+			 *  OUT underrun.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[out]    Buffer              Pointer to the buffer where the interleaved samples are to be stored.
+			 *  \param[in]     FrameCount          Number of audio frames, i.e. samples of every channel, to retrieve.
+			 *  \param[in]     Format              Format of the samples in the buffer, a value from the \ref Audio_Device_SampleFormats_t enum.
+			 *
+			 *  \return Number of audio frames retrieved from the OUT FIFO, before any padding.
+			 */
+			uint16_t Audio_Device_ReadFrames(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                 void* const Buffer,
+			                                 const uint16_t FrameCount,
+			                                 const uint8_t Format) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Audio class driver event for a sampling frequency change on an Audio interface's streaming endpoint. This event fires
+			 *  each time the host sets a new sampling frequency, and may be hooked in the user program by declaring a handler function
+			 *  with the same name and parameters listed here. The new sampling frequency is available in the \c CurrentSampleRate
+			 *  element of the Audio interface structure passed as a parameter, and the sample FIFOs have been flushed.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 */
+			void EVENT_Audio_Device_SampleRateChanged(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Queues samples for transmission to the host through the SOF driven streaming engine. Whole audio frames which do
+			 *  not fit in the IN FIFO are dropped and counted as an IN overrun.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[in]     Buffer              Pointer to the samples to queue, in the USB streaming format.
+			 *  \param[in]     Length              Length in bytes of the samples to queue, a multiple of the audio frame size.
+			 *
+			 *  \return Number of bytes queued into the IN FIFO.
+			 */
+			uint16_t Audio_Device_WriteFIFO(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                                const void* const Buffer,
+			                                const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Retrieves samples received from the host through the SOF driven streaming engine. If fewer samples than requested
+			 *  are available in the OUT FIFO, the remainder of the buffer is padded with silence and counted as an OUT underrun.
+			 *
+			 *  \param[in,out] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *  \param[out]    Buffer              Pointer to the buffer where the samples are to be stored, in the USB streaming format.
+			 *  \param[in]     Length              Length in bytes of the samples to retrieve, a multiple of the audio frame size.
+			 *
+			 *  \return Number of bytes retrieved from the OUT FIFO, before any padding.
+			 */
+			uint16_t Audio_Device_ReadFIFO(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo,
+			                               void* const Buffer,
+			                               const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 		/* Inline Functions: */
 			/** General management task for a given Audio class interface, required for the correct operation of the interface. This should
 			 *  be called frequently in the main program loop, before the master USB management task \ref USB_USBTask().
@@ -144,6 +340,33 @@
 				(void)AudioInterfaceInfo;
 			}
 
+			/** Retrieves the number of bytes of received samples waiting in the OUT FIFO of the SOF driven streaming engine.
+			 *
+			 *  \param[in] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return Number of bytes in the OUT FIFO.
+			 */
+			static inline uint16_t Audio_Device_OUTFIFOCount(const USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                                 ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline uint16_t Audio_Device_OUTFIFOCount(const USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				return (uint16_t)(AudioInterfaceInfo->State.OUTFIFOWriteIndex - AudioInterfaceInfo->State.OUTFIFOReadIndex);
+			}
+
+			/** Retrieves the number of bytes of free space in the IN FIFO of the SOF driven streaming engine.
+			 *
+			 *  \param[in] AudioInterfaceInfo  Pointer to a structure containing an Audio Class configuration and state.
+			 *
+			 *  \return Number of free bytes in the IN FIFO.
+			 */
+			static inline uint16_t Audio_Device_INFIFOFree(const USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			                                               ATTR_NON_NULL_PTR_ARG(1) ATTR_ALWAYS_INLINE;
+			static inline uint16_t Audio_Device_INFIFOFree(const USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+			{
+				return (AUDIO_DEVICE_FIFO_SIZE -
+				        (uint16_t)(AudioInterfaceInfo->State.INFIFOWriteIndex - AudioInterfaceInfo->State.INFIFOReadIndex));
+			}
+
 			/** Determines if the given audio interface is ready for a sample to be read from it, and selects the streaming
 			 *  OUT endpoint ready for reading.
 			 *
@@ -319,6 +542,48 @@
 				  Endpoint_ClearIN();
 			}
 
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define AUDIO_DEVICE_CONVERT_CHUNK_SIZE   192
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_AUDIO_DEVICE_C)
+				static void Audio_Device_ResetFIFOs(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static void Audio_Device_UpdateFeedback(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static void Audio_Device_ProcessEndpointRequest(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+				static void Audio_Device_CopyFromFIFO(const uint8_t* const FIFO,
+				                                      const uint16_t ReadIndex,
+				                                      uint8_t* const Buffer,
+				                                      const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+				static void Audio_Device_CopyToFIFO(uint8_t* const FIFO,
+				                                    const uint16_t WriteIndex,
+				                                    const uint8_t* const Buffer,
+				                                    const uint16_t Length) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+				static void Audio_Device_Unpack16(const uint8_t* Source,
+				                                  void* const Destination,
+				                                  uint16_t Samples,
+				                                  const uint8_t Format) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static void Audio_Device_Unpack24(const uint8_t* Source,
+				                                  void* const Destination,
+				                                  uint16_t Samples,
+				                                  const uint8_t Format) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static void Audio_Device_Pack16(const void* const Source,
+				                                uint8_t* Destination,
+				                                uint16_t Samples,
+				                                const uint8_t Format) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+				static void Audio_Device_Pack24(const void* const Source,
+				                                uint8_t* Destination,
+				                                uint16_t Samples,
+				                                const uint8_t Format) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+				void Audio_Device_Event_Stub(void) ATTR_CONST;
+				void EVENT_Audio_Device_SampleRateChanged(USB_ClassInfo_Audio_Device_t* const AudioInterfaceInfo)
+				                                          ATTR_WEAK ATTR_NON_NULL_PTR_ARG(1) ATTR_ALIAS(Audio_Device_Event_Stub);
+			#endif
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -53,6 +53,23 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 				uint16_t ReportSize = 0;
 				uint8_t  ReportID   = (USB_ControlRequest.wValue & 0xFF);
 				uint8_t  ReportType = (USB_ControlRequest.wValue >> 8) - 1;
+
+				if (HID_DEVICE_IS_DOUBLE_BUFFERED(HIDInterfaceInfo) && (ReportType == HID_REPORT_ITEM_In))
+				{
+					void* ReportINData = HID_DEVICE_REPORT_IN_BUFFER(HIDInterfaceInfo, HIDInterfaceInfo->State.ReportINBufferIndex);
+
+					CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, ReportType, ReportINData, &ReportSize);
+					HID_Device_CommitReportIN(HIDInterfaceInfo, ReportID, ReportSize);
+
+					Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
+
+					Endpoint_ClearSETUP();
+					Endpoint_Write_Control_Stream_LE(ReportINData, ReportSize);
+					Endpoint_ClearOUT();
+
+					break;
+				}
+
 				uint8_t  ReportData[HIDInterfaceInfo->Config.PrevReportINBufferSize];
 
 				memset(ReportData, 0, sizeof(ReportData));
@@ -113,18 +130,38 @@ void HID_Device_ProcessControlRequest(USB_ClassInfo_HID_Device_t* const HIDInter
 		case HID_REQ_SetIdle:
 			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE))
 			{
+				uint8_t  ReportID  = (USB_ControlRequest.wValue & 0xFF);
+				uint16_t IdleCount = ((USB_ControlRequest.wValue & 0xFF00) >> 6);
+
 				Endpoint_ClearSETUP();
 				Endpoint_ClearStatusStage();
 
-				HIDInterfaceInfo->State.IdleCount = ((USB_ControlRequest.wValue & 0xFF00) >> 6);
+				/* A report ID of zero sets the idle period of all reports, otherwise only that of the given report - individual
+				   idle periods are only kept for report IDs the host has addressed, as only those are known to exist */
+				if (!(ReportID) || (ReportID > HID_DEVICE_IDLE_REPORT_IDS_MAX))
+				  HIDInterfaceInfo->State.IdleCount = IdleCount;
+				else
+				  HIDInterfaceInfo->State.ReportIdleSet[ReportID - 1] = true;
+
+				for (uint8_t ReportIndex = 0; ReportIndex < HID_DEVICE_IDLE_REPORT_IDS_MAX; ReportIndex++)
+				{
+					if ((!(ReportID) || (ReportID == (ReportIndex + 1))) && HIDInterfaceInfo->State.ReportIdleSet[ReportIndex])
+					  HIDInterfaceInfo->State.ReportIdleCount[ReportIndex] = IdleCount;
+				}
 			}
 
 			break;
 		case HID_REQ_GetIdle:
 			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
 			{
+				uint8_t  ReportID  = (USB_ControlRequest.wValue & 0xFF);
+				uint16_t IdleCount = HIDInterfaceInfo->State.IdleCount;
+
+				if (HID_DEVICE_HAS_REPORT_IDLE(HIDInterfaceInfo, ReportID))
+				  IdleCount = HIDInterfaceInfo->State.ReportIdleCount[ReportID - 1];
+
 				Endpoint_ClearSETUP();
-				Endpoint_Write_8(HIDInterfaceInfo->State.IdleCount >> 2);
+				Endpoint_Write_8(IdleCount >> 2);
 				Endpoint_ClearIN();
 				Endpoint_ClearStatusStage();
 			}
@@ -158,37 +195,201 @@ void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
 
 	if (Endpoint_IsReadWriteAllowed())
 	{
+		if (HIDInterfaceInfo->State.ReportINQueueCount)
+		{
+			HID_Device_QueuedReport_t* QueuedReport = &HIDInterfaceInfo->State.ReportINQueue[HIDInterfaceInfo->State.ReportINQueueHead];
+
+			HID_Device_WriteReportIN(HIDInterfaceInfo, QueuedReport->ReportID, QueuedReport->ReportData, QueuedReport->ReportSize);
+
+			HIDInterfaceInfo->State.ReportINQueueHead = ((HIDInterfaceInfo->State.ReportINQueueHead + 1) % HID_DEVICE_REPORT_QUEUE_SIZE);
+			HIDInterfaceInfo->State.ReportINQueueCount--;
+
+			/* The host's view of the report state now differs from the last created report, which must be resent */
+			HIDInterfaceInfo->State.ReportINDirty = true;
+			return;
+		}
+
+		if (HID_DEVICE_IS_DOUBLE_BUFFERED(HIDInterfaceInfo))
+		{
+			void*    ReportINData = HID_DEVICE_REPORT_IN_BUFFER(HIDInterfaceInfo, HIDInterfaceInfo->State.ReportINBufferIndex);
+			void*    PrevReportINData = HID_DEVICE_REPORT_IN_BUFFER(HIDInterfaceInfo, !(HIDInterfaceInfo->State.ReportINBufferIndex));
+			uint8_t  ReportID     = HID_Device_GetIdleElapsedReportID(HIDInterfaceInfo);
+			uint16_t ReportINSize = 0;
+
+			bool ForceSend         = CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, HID_REPORT_ITEM_In,
+			                                                             ReportINData, &ReportINSize);
+			bool StatesChanged     = (HIDInterfaceInfo->State.ReportINDirty ||
+			                          (ReportID     != HIDInterfaceInfo->State.PrevReportINID) ||
+			                          (ReportINSize != HIDInterfaceInfo->State.PrevReportINSize));
+			bool IdlePeriodElapsed = HID_Device_IsIdlePeriodElapsed(HIDInterfaceInfo, ReportID);
+
+			if (!(ForceSend || StatesChanged))
+			  StatesChanged = HID_Device_CompareReports(ReportINData, PrevReportINData, ReportINSize);
+
+			HID_Device_CommitReportIN(HIDInterfaceInfo, ReportID, ReportINSize);
+
+			if (ReportINSize && (ForceSend || StatesChanged || IdlePeriodElapsed))
+			  HID_Device_WriteReportIN(HIDInterfaceInfo, ReportID, ReportINData, ReportINSize);
+
+			return;
+		}
+
 		uint8_t  ReportINData[HIDInterfaceInfo->Config.PrevReportINBufferSize];
-		uint8_t  ReportID     = 0;
+		uint8_t  ReportID     = HID_Device_GetIdleElapsedReportID(HIDInterfaceInfo);
 		uint16_t ReportINSize = 0;
 
 		memset(ReportINData, 0, sizeof(ReportINData));
 
 		bool ForceSend         = CALLBACK_HID_Device_CreateHIDReport(HIDInterfaceInfo, &ReportID, HID_REPORT_ITEM_In,
 		                                                             ReportINData, &ReportINSize);
-		bool StatesChanged     = false;
-		bool IdlePeriodElapsed = (HIDInterfaceInfo->State.IdleCount && !(HIDInterfaceInfo->State.IdleMSRemaining));
+		bool StatesChanged     = HIDInterfaceInfo->State.ReportINDirty;
+		bool IdlePeriodElapsed = HID_Device_IsIdlePeriodElapsed(HIDInterfaceInfo, ReportID);
+
+		HIDInterfaceInfo->State.ReportINDirty = false;
 
 		if (HIDInterfaceInfo->Config.PrevReportINBuffer != NULL)
 		{
-			StatesChanged = (memcmp(ReportINData, HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINSize) != 0);
+			StatesChanged |= (memcmp(ReportINData, HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINSize) != 0);
 			memcpy(HIDInterfaceInfo->Config.PrevReportINBuffer, ReportINData, HIDInterfaceInfo->Config.PrevReportINBufferSize);
 		}
 
 		if (ReportINSize && (ForceSend || StatesChanged || IdlePeriodElapsed))
-		{
-			HIDInterfaceInfo->State.IdleMSRemaining = HIDInterfaceInfo->State.IdleCount;
+		  HID_Device_WriteReportIN(HIDInterfaceInfo, ReportID, ReportINData, ReportINSize);
+	}
+}
 
-			Endpoint_SelectEndpoint(HIDInterfaceInfo->Config.ReportINEndpointNumber);
+bool HID_Device_QueueReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                              const uint8_t ReportID,
+                              const void* ReportData,
+                              const uint16_t ReportSize)
+{
+	HID_Device_QueuedReport_t* QueuedReport = NULL;
 
-			if (ReportID)
-			  Endpoint_Write_8(ReportID);
+	if (ReportSize > HID_DEVICE_QUEUED_REPORT_SIZE_MAX)
+	{
+		HIDInterfaceInfo->State.ReportsLost++;
+		return false;
+	}
+
+	if (HIDInterfaceInfo->State.ReportINQueueCount < HID_DEVICE_REPORT_QUEUE_SIZE)
+	{
+		uint8_t QueueTail = ((HIDInterfaceInfo->State.ReportINQueueHead + HIDInterfaceInfo->State.ReportINQueueCount) % HID_DEVICE_REPORT_QUEUE_SIZE);
 
-			Endpoint_Write_Stream_LE(ReportINData, ReportINSize, NULL);
+		QueuedReport = &HIDInterfaceInfo->State.ReportINQueue[QueueTail];
+		HIDInterfaceInfo->State.ReportINQueueCount++;
+	}
+	else
+	{
+		/* Queue is full, search back from the newest entry for a report with the same ID to replace */
+		for (uint8_t QueueOffset = HID_DEVICE_REPORT_QUEUE_SIZE; QueueOffset > 0; QueueOffset--)
+		{
+			uint8_t QueueIndex = ((HIDInterfaceInfo->State.ReportINQueueHead + QueueOffset - 1) % HID_DEVICE_REPORT_QUEUE_SIZE);
 
-			Endpoint_ClearIN();
+			if (HIDInterfaceInfo->State.ReportINQueue[QueueIndex].ReportID == ReportID)
+			{
+				QueuedReport = &HIDInterfaceInfo->State.ReportINQueue[QueueIndex];
+				break;
+			}
 		}
+
+		if (QueuedReport == NULL)
+		{
+			HIDInterfaceInfo->State.ReportsLost++;
+			return false;
+		}
+
+		HIDInterfaceInfo->State.ReportsMerged++;
+	}
+
+	QueuedReport->ReportID   = ReportID;
+	QueuedReport->ReportSize = ReportSize;
+	memcpy(QueuedReport->ReportData, ReportData, ReportSize);
+
+	return true;
+}
+
+static bool HID_Device_IsIdlePeriodElapsed(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                           const uint8_t ReportID)
+{
+	if (HID_DEVICE_HAS_REPORT_IDLE(HIDInterfaceInfo, ReportID))
+	{
+		return (HIDInterfaceInfo->State.ReportIdleCount[ReportID - 1] &&
+		        !(HIDInterfaceInfo->State.ReportIdleMSRemaining[ReportID - 1]));
+	}
+
+	return (HIDInterfaceInfo->State.IdleCount && !(HIDInterfaceInfo->State.IdleMSRemaining));
+}
+
+static uint8_t HID_Device_GetIdleElapsedReportID(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+{
+	/* A report whose own idle period has expired is requested by ID, as the callback may otherwise never create it again;
+	   only IDs the host has set an idle period for are requested, so that no undeclared report ID is ever preset */
+	for (uint8_t ReportID = 1; ReportID <= HID_DEVICE_IDLE_REPORT_IDS_MAX; ReportID++)
+	{
+		if (HID_DEVICE_HAS_REPORT_IDLE(HIDInterfaceInfo, ReportID) && HID_Device_IsIdlePeriodElapsed(HIDInterfaceInfo, ReportID))
+		  return ReportID;
+	}
+
+	return 0;
+}
+
+static bool HID_Device_CompareReports(const void* CurrentReport,
+                                      const void* PreviousReport,
+                                      const uint16_t ReportSize)
+{
+	const uint32_t* CurrentWords  = (const uint32_t*)CurrentReport;
+	const uint32_t* PreviousWords = (const uint32_t*)PreviousReport;
+	uint16_t        BytesRemaining = ReportSize;
+
+	while (BytesRemaining >= sizeof(uint32_t))
+	{
+		if (*(CurrentWords++) != *(PreviousWords++))
+		  return true;
+
+		BytesRemaining -= sizeof(uint32_t);
 	}
+
+	const uint8_t* CurrentBytes  = (const uint8_t*)CurrentWords;
+	const uint8_t* PreviousBytes = (const uint8_t*)PreviousWords;
+
+	while (BytesRemaining--)
+	{
+		if (*(CurrentBytes++) != *(PreviousBytes++))
+		  return true;
+	}
+
+	return false;
+}
+
+static void HID_Device_CommitReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                      const uint8_t ReportID,
+                                      const uint16_t ReportSize)
+{
+	/* The newly created report becomes the comparison report, and the old comparison buffer receives the next report */
+	HIDInterfaceInfo->State.ReportINBufferIndex = !(HIDInterfaceInfo->State.ReportINBufferIndex);
+	HIDInterfaceInfo->State.PrevReportINID      = ReportID;
+	HIDInterfaceInfo->State.PrevReportINSize    = ReportSize;
+	HIDInterfaceInfo->State.ReportINDirty       = false;
+}
+
+static void HID_Device_WriteReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+                                     const uint8_t ReportID,
+                                     const void* ReportData,
+                                     const uint16_t ReportSize)
+{
+	if (HID_DEVICE_HAS_REPORT_IDLE(HIDInterfaceInfo, ReportID))
+	  HIDInterfaceInfo->State.ReportIdleMSRemaining[ReportID - 1] = HIDInterfaceInfo->State.ReportIdleCount[ReportID - 1];
+	else
+	  HIDInterfaceInfo->State.IdleMSRemaining = HIDInterfaceInfo->State.IdleCount;
+
+	Endpoint_SelectEndpoint(HIDInterfaceInfo->Config.ReportINEndpointNumber);
+
+	if (ReportID)
+	  Endpoint_Write_8(ReportID);
+
+	Endpoint_Write_Stream_LE(ReportData, ReportSize, NULL);
+
+	Endpoint_ClearIN();
 }
 
 #endif
@@ -68,7 +68,45 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(HID_DEVICE_IDLE_REPORT_IDS_MAX) || defined(__DOXYGEN__)
+				/** Number of report IDs, starting from report ID 1, which may be given their own idle period by the host. A report
+				 *  ID only receives its own idle period once the host has addressed it directly through a HID Set Idle request;
+				 *  until then, and for reports with an ID of zero or above this value, reports share the interface's \c IdleCount
+				 *  idle period. This may be overridden in the user project makefile by passing the
+				 *  \c HID_DEVICE_IDLE_REPORT_IDS_MAX token to the compiler via the -D switch.
+				 */
+				#define HID_DEVICE_IDLE_REPORT_IDS_MAX      4
+			#endif
+
+			#if !defined(HID_DEVICE_REPORT_QUEUE_SIZE) || defined(__DOXYGEN__)
+				/** Number of input reports which may be queued for transmission via \ref HID_Device_QueueReportIN(). This may
+				 *  be overridden in the user project makefile by passing the \c HID_DEVICE_REPORT_QUEUE_SIZE token to the
+				 *  compiler via the -D switch.
+				 */
+				#define HID_DEVICE_REPORT_QUEUE_SIZE        4
+			#endif
+
+			#if !defined(HID_DEVICE_QUEUED_REPORT_SIZE_MAX) || defined(__DOXYGEN__)
+				/** Maximum size in bytes of each input report queued via \ref HID_Device_QueueReportIN(), excluding the report
+				 *  ID. This may be overridden in the user project makefile by passing the \c HID_DEVICE_QUEUED_REPORT_SIZE_MAX
+				 *  token to the compiler via the -D switch.
+				 */
+				#define HID_DEVICE_QUEUED_REPORT_SIZE_MAX   8
+			#endif
+
 		/* Type Defines: */
+			/** \brief HID Class Device Mode Queued Report Structure.
+			 *
+			 *  Type define for an input report waiting in a HID interface's report queue for transmission to the host.
+			 */
+			typedef struct
+			{
+				uint8_t ReportID; /**< Report ID of the queued report, or zero if report IDs are not used. */
+				uint16_t ReportSize; /**< Size in bytes of the queued report data. */
+				uint8_t ReportData[HID_DEVICE_QUEUED_REPORT_SIZE_MAX]; /**< Queued report data, excluding the report ID. */
+			} HID_Device_QueuedReport_t;
+
 			/** \brief HID Class Device Mode Configuration and State Structure.
 			 *
 			 *  Class state structure. An instance of this structure should be made for each HID interface
@@ -107,15 +145,56 @@
 					                                  *  exclusively (i.e. \ref PrevReportINBuffer is \c NULL) this value must still be
 													  *  set to the size of the largest report the device can issue to the host.
 					                                  */
+					void*    ReportINBuffer; /**< Pointer to an optional second input report buffer, of the same size as
+					                          *  \ref PrevReportINBuffer. When both buffers are set the driver operates in double
+					                          *  buffered mode, alternating between the two buffers when creating reports so that
+					                          *  the previous report never needs to be copied, and only the bytes of the newly
+					                          *  created report are compared against it. Set to \c NULL to use the single
+					                          *  buffered behaviour described above.
+					                          *
+					                          *  \note Both buffers should be 32-bit aligned (see \ref ATTR_ALIGNED()) when this
+					                          *        mode is used, as the reports are compared a word at a time.
+					                          *
+					                          *  \note Unlike single buffered mode, the buffer is not zeroed before each report is
+					                          *        created, and still holds the report created before the previous one. The
+					                          *        \ref CALLBACK_HID_Device_CreateHIDReport() callback must therefore write all
+					                          *        of the returned report size's bytes in this mode.
+					                          */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
 				struct
 				{
 					bool     UsingReportProtocol; /**< Indicates if the HID interface is set to Boot or Report protocol mode. */
-					uint16_t IdleCount; /**< Report idle period, in milliseconds, set by the host. */
+					uint16_t IdleCount; /**< Report idle period, in milliseconds, set by the host for reports without an individual idle period. */
 					uint16_t IdleMSRemaining; /**< Total number of milliseconds remaining before the idle period elapsed - this
 											   *   should be decremented by the user application if non-zero each millisecond. */
+					bool     ReportINDirty; /**< Indicates that the application has changed the input report state, so that the
+					                         *   next created report is sent without being compared to the previous report. Set via
+					                         *   \ref HID_Device_MarkReportINDirty().
+					                         */
+					uint8_t  ReportINBufferIndex; /**< Index of the buffer the next input report is created in when double buffered. */
+					uint8_t  PrevReportINID; /**< Report ID of the previously created input report when double buffered. */
+					uint16_t PrevReportINSize; /**< Size in bytes of the previously created input report when double buffered. */
+					bool     ReportIdleSet[HID_DEVICE_IDLE_REPORT_IDS_MAX]; /**< Indicates for each of the individually timed report IDs
+					                                                         *   if the host has set its own idle period.
+					                                                         */
+					uint16_t ReportIdleCount[HID_DEVICE_IDLE_REPORT_IDS_MAX]; /**< Idle period, in milliseconds, set by the host for
+					                                                           *   each of the individually timed report IDs.
+					                                                           */
+					uint16_t ReportIdleMSRemaining[HID_DEVICE_IDLE_REPORT_IDS_MAX]; /**< Milliseconds remaining before the idle
+					                                                                 *   period of each individually timed report ID
+					                                                                 *   elapses, decremented by \ref HID_Device_MillisecondElapsed().
+					                                                                 */
+					HID_Device_QueuedReport_t ReportINQueue[HID_DEVICE_REPORT_QUEUE_SIZE]; /**< Input reports waiting to be sent. */
+					uint8_t  ReportINQueueHead; /**< Index of the next queued input report to be sent. */
+					uint8_t  ReportINQueueCount; /**< Number of input reports currently queued. */
+					uint16_t ReportsLost; /**< Number of input reports discarded because the report queue was full, or the report
+					                       *   was too large to be queued.
+					                       */
+					uint16_t ReportsMerged; /**< Number of queued input reports which were overwritten by a newer report with the same
+					                         *   report ID before they could be sent, because the report queue was full.
+					                         */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -150,16 +229,38 @@
 			 */
 			void HID_Device_USBTask(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
 
+			/** Queues an input report for transmission to the host on the given HID interface. Queued reports are sent in order
+			 *  ahead of any report created through \ref CALLBACK_HID_Device_CreateHIDReport(), one per call to
+			 *  \ref HID_Device_USBTask(), so that bursts of state changes are each delivered to the host rather than being
+			 *  coalesced into the latest state. If the queue is full, the newest queued report with the same report ID is
+			 *  replaced and \c ReportsMerged incremented; if there is no such report the new report is discarded and
+			 *  \c ReportsLost incremented instead.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state.
+			 *  \param[in]     ReportID          Report ID of the report to queue, or zero if report IDs are not used.
+			 *  \param[in]     ReportData        Pointer to the report data to queue, excluding the report ID.
+			 *  \param[in]     ReportSize        Size in bytes of the report data, no larger than \ref HID_DEVICE_QUEUED_REPORT_SIZE_MAX.
+			 *
+			 *  \return Boolean \c true if the report was queued or merged into a queued report, \c false if it was discarded.
+			 */
+			bool HID_Device_QueueReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                              const uint8_t ReportID,
+			                              const void* ReportData,
+			                              const uint16_t ReportSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
 			/** HID class driver callback for the user creation of a HID IN report. This callback may fire in response to either
 			 *  HID class control requests from the host, or by the normal HID endpoint polling procedure. Inside this callback the
 			 *  user is responsible for the creation of the next HID input report to be sent to the host.
 			 *
 			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state.
-			 *  \param[in,out] ReportID          If preset to a non-zero value, this is the report ID being requested by the host. If zero,
+			 *  \param[in,out] ReportID          If preset to a non-zero value, this is the report ID being requested by the host, or the
+			 *                                   ID of a report whose individual idle period, set by the host for that ID, has elapsed and
+			 *                                   which should be resent. If zero,
 			 *                                   this should be set to the report ID of the generated HID input report (if any). If multiple
 			 *                                   reports are not sent via the given HID interface, this parameter should be ignored.
 			 *  \param[in]     ReportType        Type of HID report to generate, either \ref HID_REPORT_ITEM_In or \ref HID_REPORT_ITEM_Feature.
-			 *  \param[out]    ReportData        Pointer to a buffer where the generated HID report should be stored.
+			 *  \param[out]    ReportData        Pointer to a buffer where the generated HID report should be stored. In double buffered
+			 *                                   mode the buffer is not cleared first, so every byte of the report must be written.
 			 *  \param[out]    ReportSize        Number of bytes in the generated input report, or zero if no report is to be sent.
 			 *
 			 *  \return Boolean \c true to force the sending of the report even if it is identical to the previous report and still within
@@ -202,8 +303,56 @@
 			{
 				if (HIDInterfaceInfo->State.IdleMSRemaining)
 				  HIDInterfaceInfo->State.IdleMSRemaining--;
+
+				for (uint8_t ReportIndex = 0; ReportIndex < HID_DEVICE_IDLE_REPORT_IDS_MAX; ReportIndex++)
+				{
+					if (HIDInterfaceInfo->State.ReportIdleMSRemaining[ReportIndex])
+					  HIDInterfaceInfo->State.ReportIdleMSRemaining[ReportIndex]--;
+				}
 			}
 
+			/** Indicates that the application's input report state has changed on the given HID interface, so that the next
+			 *  created report is sent to the host without first being compared against the previously created report.
+			 *  Applications which already track changes to their report data can use this to avoid the comparison entirely.
+			 *
+			 *  \param[in,out] HIDInterfaceInfo  Pointer to a structure containing a HID Class configuration and state.
+			 */
+			static inline void HID_Device_MarkReportINDirty(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo) ATTR_ALWAYS_INLINE ATTR_NON_NULL_PTR_ARG(1);
+			static inline void HID_Device_MarkReportINDirty(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+			{
+				HIDInterfaceInfo->State.ReportINDirty = true;
+			}
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define HID_DEVICE_IS_DOUBLE_BUFFERED(Info)        (((Info)->Config.PrevReportINBuffer != NULL) && \
+			                                                    ((Info)->Config.ReportINBuffer != NULL))
+			#define HID_DEVICE_REPORT_IN_BUFFER(Info, Index)   ((Index) ? (Info)->Config.ReportINBuffer : (Info)->Config.PrevReportINBuffer)
+			#define HID_DEVICE_HAS_REPORT_IDLE(Info, ReportID) ((ReportID) && ((ReportID) <= HID_DEVICE_IDLE_REPORT_IDS_MAX) && \
+			                                                    (Info)->State.ReportIdleSet[(ReportID) - 1])
+
+		/* Function Prototypes: */
+		#if defined(__INCLUDE_FROM_HID_DEVICE_C)
+			static bool HID_Device_CompareReports(const void* CurrentReport,
+			                                      const void* PreviousReport,
+			                                      const uint16_t ReportSize) ATTR_WARN_UNUSED_RESULT
+			                                      ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+			static void HID_Device_CommitReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                                      const uint8_t ReportID,
+			                                      const uint16_t ReportSize) ATTR_NON_NULL_PTR_ARG(1);
+			static bool HID_Device_IsIdlePeriodElapsed(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                                           const uint8_t ReportID) ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+			static uint8_t HID_Device_GetIdleElapsedReportID(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo)
+			                                                 ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(1);
+			static void HID_Device_WriteReportIN(USB_ClassInfo_HID_Device_t* const HIDInterfaceInfo,
+			                                     const uint8_t ReportID,
+			                                     const void* ReportData,
+			                                     const uint16_t ReportSize) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+		#endif
+
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -41,6 +41,8 @@ bool MIDI_Device_ConfigureEndpoints(USB_ClassInfo_MIDI_Device_t* const MIDIInter
 {
 	memset(&MIDIInterfaceInfo->State, 0x00, sizeof(MIDIInterfaceInfo->State));
 
+	MIDI_DEVICE_TIMESTAMP_INIT();
+
 	for (uint8_t EndpointNum = 1; EndpointNum < ENDPOINT_TOTAL_ENDPOINTS; EndpointNum++)
 	{
 		uint16_t Size;
@@ -106,6 +108,38 @@ uint8_t MIDI_Device_SendEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInter
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
+uint8_t MIDI_Device_SendEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                     const MIDI_EventPacket_t* const Events,
+                                     uint16_t EventCount)
+{
+	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return ENDPOINT_READYWAIT_DeviceDisconnected;
+
+	uint8_t  ErrorCode;
+	uint8_t  EventsPerPacket = MIN((MIDIInterfaceInfo->Config.DataINEndpointSize / sizeof(MIDI_EventPacket_t)),
+	                               MIDI_DEVICE_MAX_PACKET_EVENTS);
+	const MIDI_EventPacket_t* NextEvent = Events;
+
+	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataINEndpointNumber);
+
+	while (EventCount)
+	{
+		uint8_t PacketEvents = MIN(EventCount, EventsPerPacket);
+
+		if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+		  return ErrorCode;
+
+		/* Each event packet is a single word, so the whole endpoint packet is written in one word-wise transfer */
+		Endpoint_write_buf((const uint8_t*)NextEvent, (PacketEvents * sizeof(MIDI_EventPacket_t)));
+		Endpoint_ClearIN();
+
+		NextEvent  += PacketEvents;
+		EventCount -= PacketEvents;
+	}
+
+	return ENDPOINT_READYWAIT_NoError;
+}
+
 uint8_t MIDI_Device_Flush(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
 {
 	if (USB_DeviceState != DEVICE_STATE_Configured)
@@ -128,19 +162,141 @@ uint8_t MIDI_Device_Flush(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
 
 bool MIDI_Device_ReceiveEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
                                     MIDI_EventPacket_t* const Event)
+{
+	return (MIDI_Device_ReceiveEventPackets(MIDIInterfaceInfo, Event, 1) != 0);
+}
+
+uint8_t MIDI_Device_ReceiveEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                        MIDI_EventPacket_t* const Events,
+                                        const uint8_t MaxEvents)
 {
 	if (USB_DeviceState != DEVICE_STATE_Configured)
+	  return 0;
+
+	uint8_t EventsReceived = 0;
+
+	while (EventsReceived < MaxEvents)
+	{
+		if (MIDIInterfaceInfo->State.OUTEventIndex == MIDIInterfaceInfo->State.OUTEventCount)
+		{
+			if (!(MIDI_Device_ReceivePacket(MIDIInterfaceInfo)))
+			  break;
+
+			continue;
+		}
+
+		uint8_t EventsToCopy = MIN((uint8_t)(MaxEvents - EventsReceived),
+		                           (uint8_t)(MIDIInterfaceInfo->State.OUTEventCount - MIDIInterfaceInfo->State.OUTEventIndex));
+
+		memcpy(&Events[EventsReceived], &MIDIInterfaceInfo->State.OUTEvents[MIDIInterfaceInfo->State.OUTEventIndex],
+		       (EventsToCopy * sizeof(MIDI_EventPacket_t)));
+
+		MIDIInterfaceInfo->State.OUTEventIndex += EventsToCopy;
+		EventsReceived                         += EventsToCopy;
+	}
+
+	return EventsReceived;
+}
+
+void MIDI_Device_StartOfFrame(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
+{
+	MIDIInterfaceInfo->State.SOFTicks       = MIDI_DEVICE_TIMESTAMP_TICKS();
+	MIDIInterfaceInfo->State.SOFFrameNumber = USB_Device_GetFrameNumber();
+}
+
+void MIDI_Device_ProcessEndpointOUT(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                    const uint8_t EndpointNumber)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || (EndpointNumber != MIDIInterfaceInfo->Config.DataOUTEndpointNumber) ||
+	    !(MIDIInterfaceInfo->Config.RxQueues))
+	{
+		return;
+	}
+
+	/* Timestamp the packet before reading it, so that the time taken to drain the endpoint does not skew the events */
+	uint32_t FrameTicks  = (MIDI_DEVICE_TIMESTAMP_TICKS() - MIDIInterfaceInfo->State.SOFTicks);
+	uint16_t FrameNumber = MIDIInterfaceInfo->State.SOFFrameNumber;
+
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
+	Endpoint_SelectEndpoint(EndpointNumber);
+
+	MIDI_EventPacket_t PacketEvents[MIDI_DEVICE_MAX_PACKET_EVENTS] ATTR_ALIGNED(4);
+	uint16_t PacketSize = MIN(Endpoint_Read_buf((uint8_t*)PacketEvents, sizeof(PacketEvents)), sizeof(PacketEvents));
+	Endpoint_ClearOUT();
+
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+
+	uint8_t TotalEvents = (PacketSize / sizeof(MIDI_EventPacket_t));
+
+	for (uint8_t EventIndex = 0; EventIndex < TotalEvents; EventIndex++)
+	{
+		MIDI_EventPacket_t* Event = &PacketEvents[EventIndex];
+
+		/* Skip the empty events some hosts use to pad out their packets */
+		if (*((uint32_t*)Event) == 0)
+		  continue;
+
+		uint8_t CableNumber = Event->CableNumber;
+
+		if ((CableNumber >= MIDI_DEVICE_RX_CABLES) ||
+		    (MIDI_Device_TimestampedEventCount(MIDIInterfaceInfo, CableNumber) == MIDI_DEVICE_RX_QUEUE_SIZE))
+		{
+			MIDIInterfaceInfo->State.RxDroppedEvents++;
+			continue;
+		}
+
+		uint8_t WriteIndex = MIDIInterfaceInfo->State.RxWriteIndex[CableNumber];
+
+		MIDI_TimestampedEvent_t* QueuedEvent =
+		        &MIDIInterfaceInfo->Config.RxQueues[MIDI_DEVICE_RX_QUEUE_INDEX(CableNumber, WriteIndex)];
+
+		QueuedEvent->Event       = *Event;
+		QueuedEvent->FrameNumber = FrameNumber;
+		QueuedEvent->FrameTicks  = FrameTicks;
+
+		MIDIInterfaceInfo->State.RxWriteIndex[CableNumber] = (WriteIndex + 1);
+	}
+}
+
+bool MIDI_Device_ReceiveTimestampedEvent(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+                                         const uint8_t CableNumber,
+                                         MIDI_TimestampedEvent_t* const Event)
+{
+	uint8_t ReadIndex = MIDIInterfaceInfo->State.RxReadIndex[CableNumber];
+
+	if (!(MIDIInterfaceInfo->Config.RxQueues) || (ReadIndex == MIDIInterfaceInfo->State.RxWriteIndex[CableNumber]))
 	  return false;
 
+	*Event = MIDIInterfaceInfo->Config.RxQueues[MIDI_DEVICE_RX_QUEUE_INDEX(CableNumber, ReadIndex)];
+	MIDIInterfaceInfo->State.RxReadIndex[CableNumber] = (ReadIndex + 1);
+
+	return true;
+}
+
+static bool MIDI_Device_ReceivePacket(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo)
+{
 	Endpoint_SelectEndpoint(MIDIInterfaceInfo->Config.DataOUTEndpointNumber);
 
-	if (!(Endpoint_IsReadWriteAllowed()))
+	if (!(Endpoint_IsOUTReceived()))
 	  return false;
 
-	Endpoint_Read_Stream_LE(Event, sizeof(MIDI_EventPacket_t), NULL);
+	uint32_t* PacketEvents = (uint32_t*)MIDIInterfaceInfo->State.OUTEvents;
+	uint16_t  PacketSize   = MIN(Endpoint_Read_buf((uint8_t*)PacketEvents, sizeof(MIDIInterfaceInfo->State.OUTEvents)),
+	                             sizeof(MIDIInterfaceInfo->State.OUTEvents));
+	Endpoint_ClearOUT();
 
-	if (!(Endpoint_IsReadWriteAllowed()))
-	  Endpoint_ClearOUT();
+	uint8_t TotalEvents = (PacketSize / sizeof(MIDI_EventPacket_t));
+	uint8_t EventCount  = 0;
+
+	/* Compact the received events in place, dropping the empty events some hosts use to pad out their packets */
+	for (uint8_t EventIndex = 0; EventIndex < TotalEvents; EventIndex++)
+	{
+		if (PacketEvents[EventIndex])
+		  PacketEvents[EventCount++] = PacketEvents[EventIndex];
+	}
+
+	MIDIInterfaceInfo->State.OUTEventCount = EventCount;
+	MIDIInterfaceInfo->State.OUTEventIndex = 0;
 
 	return true;
 }
@@ -68,7 +68,66 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			/** Maximum number of MIDI event packets which can be transferred in a single full speed bulk endpoint packet. */
+			#define MIDI_DEVICE_MAX_PACKET_EVENTS   (64 / sizeof(MIDI_EventPacket_t))
+
+			#if !defined(MIDI_DEVICE_RX_CABLES) || defined(__DOXYGEN__)
+				/** Number of virtual cables, starting from cable zero, for which the interrupt driven receive ring keeps a
+				 *  separate queue of timestamped events. Events received on higher numbered cables are discarded. This may be
+				 *  overridden in the user project makefile by passing the \c MIDI_DEVICE_RX_CABLES token to the compiler via
+				 *  the -D switch.
+				 */
+				#define MIDI_DEVICE_RX_CABLES           4
+			#endif
+
+			#if !defined(MIDI_DEVICE_RX_QUEUE_SIZE) || defined(__DOXYGEN__)
+				/** Number of timestamped events held by the receive queue of each virtual cable, which must be a power of two
+				 *  no larger than 128. This may be overridden in the user project makefile by passing the
+				 *  \c MIDI_DEVICE_RX_QUEUE_SIZE token to the compiler via the -D switch.
+				 */
+				#define MIDI_DEVICE_RX_QUEUE_SIZE       8
+			#endif
+
+			#if !defined(MIDI_DEVICE_TIMESTAMP_TICKS) || defined(__DOXYGEN__)
+				/** Expression returning a free running, up counting 32-bit tick count, used to timestamp received events within
+				 *  the current USB frame. By default this is the device tick source of the USB driver, \ref USB_DEVICE_TICKS().
+				 *  This may be overridden in the user project makefile by passing the \c MIDI_DEVICE_TIMESTAMP_TICKS()
+				 *  token to the compiler via the -D switch, along with \ref MIDI_DEVICE_TIMESTAMP_INIT(), to use an application
+				 *  timer instead.
+				 */
+				#define MIDI_DEVICE_TIMESTAMP_TICKS()   USB_DEVICE_TICKS()
+
+				/** Statement starting the tick source of \ref MIDI_DEVICE_TIMESTAMP_TICKS(), executed by
+				 *  \ref MIDI_Device_ConfigureEndpoints(). By default this restarts the device tick source of the USB driver
+				 *  via \ref USB_DEVICE_TICKS_INIT().
+				 */
+				#define MIDI_DEVICE_TIMESTAMP_INIT()    USB_DEVICE_TICKS_INIT()
+			#endif
+
+			#if (MIDI_DEVICE_RX_QUEUE_SIZE & (MIDI_DEVICE_RX_QUEUE_SIZE - 1)) || (MIDI_DEVICE_RX_QUEUE_SIZE > 128)
+				#error MIDI_DEVICE_RX_QUEUE_SIZE must be a power of two no larger than 128.
+			#endif
+
+			#if (MIDI_DEVICE_RX_CABLES < 1) || (MIDI_DEVICE_RX_CABLES > 16)
+				#error MIDI_DEVICE_RX_CABLES must be between 1 and 16.
+			#endif
+
 		/* Type Define: */
+			/** \brief Timestamped MIDI Event Packet.
+			 *
+			 *  Type define for a MIDI event packet received from the host by the interrupt driven receive ring, along with the
+			 *  time at which the endpoint packet containing it arrived.
+			 */
+			typedef struct
+			{
+				MIDI_EventPacket_t Event; /**< MIDI event packet received from the host. */
+				uint16_t FrameNumber; /**< USB frame number of the frame in which the event was received. */
+				uint32_t FrameTicks; /**< Ticks of \ref MIDI_DEVICE_TIMESTAMP_TICKS() elapsed between the start of the frame and the
+				                      *   reception of the event.
+				                      */
+			} MIDI_TimestampedEvent_t;
+
 			/** \brief MIDI Class Device Mode Configuration and State Structure.
 			 *
 			 *  Class state structure. An instance of this structure should be made for each MIDI interface
@@ -88,13 +147,33 @@
 					uint8_t  DataOUTEndpointNumber; /**< Endpoint number of the outgoing MIDI data, if available (zero if unused). */
 					uint16_t DataOUTEndpointSize; /**< Size in bytes of the outgoing MIDI data endpoint, if available (zero if unused). */
 					bool     DataOUTEndpointDoubleBank; /**< Indicates if the MIDI interface's IN data endpoint should use double banking. */
+
+					MIDI_TimestampedEvent_t* RxQueues; /**< Pointer to an application supplied array of \ref MIDI_DEVICE_RX_CABLES
+					                                    *   consecutive queues of \ref MIDI_DEVICE_RX_QUEUE_SIZE timestamped events each,
+					                                    *   filled by the interrupt driven receive ring (\c NULL if the ring is unused).
+					                                    */
 				} Config; /**< Config data for the USB class interface within the device. All elements in this section
 				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
 				           */
 				
 				struct
 				{
-					// No state information for this class
+					MIDI_EventPacket_t OUTEvents[MIDI_DEVICE_MAX_PACKET_EVENTS] ATTR_ALIGNED(4); /**< Events unpacked from the last packet
+					                                                                             *   received from the host, managed by
+					                                                                             *   the class driver.
+					                                                                             */
+					uint8_t OUTEventCount; /**< Number of events unpacked from the last packet received from the host. */
+					uint8_t OUTEventIndex; /**< Index of the next unread event in the \c OUTEvents array. */
+
+					volatile uint8_t RxWriteIndex[MIDI_DEVICE_RX_CABLES]; /**< Free running write index of each cable's queue,
+					                                                      *   advanced from the endpoint interrupt.
+					                                                      */
+					volatile uint8_t RxReadIndex[MIDI_DEVICE_RX_CABLES]; /**< Free running read index of each cable's queue,
+					                                                     *   advanced by the application.
+					                                                     */
+					uint16_t RxDroppedEvents; /**< Count of received events discarded due to a full queue or an unqueued cable. */
+					uint16_t SOFFrameNumber; /**< USB frame number latched at the most recent Start Of Frame. */
+					uint32_t SOFTicks; /**< Value of \ref MIDI_DEVICE_TIMESTAMP_TICKS() latched at the most recent Start Of Frame. */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -138,6 +217,25 @@
 			                                    const MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
 
+			/** Sends an array of MIDI event packets to the host. Events are packed into as few endpoint packets as possible, each
+			 *  holding up to a full endpoint's worth of events, with each packet written to the endpoint in a single transfer.
+			 *
+			 *  \note Any events previously queued into the endpoint bank by \ref MIDI_Device_SendEventPacket() should be sent via
+			 *        \ref MIDI_Device_Flush() before this function is called.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[in]     Events             Pointer to an array of populated \ref MIDI_EventPacket_t structures to send.
+			 *  \param[in]     EventCount         Number of events in the array to send.
+			 *
+			 *  \return A value from the \ref Endpoint_WaitUntilReady_ErrorCodes_t enum.
+			 */
+			uint8_t MIDI_Device_SendEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+			                                     const MIDI_EventPacket_t* const Events,
+			                                     uint16_t EventCount) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
 			/** Flushes the MIDI send buffer, sending any queued MIDI events to the host. This should be called to override the
 			 *  \ref MIDI_Device_SendEventPacket() function's packing behaviour, to flush queued events.
 			 *
@@ -161,7 +259,77 @@
 			bool MIDI_Device_ReceiveEventPacket(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
 			                                    MIDI_EventPacket_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 
+			/** Receives multiple MIDI event packets from the host. Each endpoint packet received from the host is unpacked in a single
+			 *  pass into the interface's state, from which events are returned until it is exhausted; empty padding events are
+			 *  discarded. Events not returned by one call are returned by the next call to this function or to
+			 *  \ref MIDI_Device_ReceiveEventPacket().
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[out]    Events             Pointer to an array of \ref MIDI_EventPacket_t structures where the received events are
+			 *                                    to be placed.
+			 *  \param[in]     MaxEvents          Maximum number of events to place into the array.
+			 *
+			 *  \return Number of MIDI event packets received.
+			 */
+			uint8_t MIDI_Device_ReceiveEventPackets(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+			                                        MIDI_EventPacket_t* const Events,
+			                                        const uint8_t MaxEvents) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+
+			/** Start Of Frame handler for the interrupt driven receive ring of a given MIDI class interface, latching the frame
+			 *  number and tick count against which received events are timestamped. This should be linked to the library
+			 *  \ref EVENT_USB_Device_StartOfFrame() event, with SOF events enabled via \ref USB_Device_EnableSOFEvents().
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 */
+			void MIDI_Device_StartOfFrame(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** OUT endpoint interrupt handler for the interrupt driven receive ring of a given MIDI class interface. When the
+			 *  given endpoint is the interface's OUT data endpoint, the received packet is read immediately and each of its events
+			 *  is timestamped and queued on its virtual cable's receive queue. This should be linked to the library
+			 *  \ref EVENT_USB_Device_EndpointOUTReceived() event. Packets are left untouched if the interface has no
+			 *  \c RxQueues buffer.
+			 *
+			 *  \note When this handler is in use, events must be retrieved with \ref MIDI_Device_ReceiveTimestampedEvent() rather
+			 *        than \ref MIDI_Device_ReceiveEventPacket() or \ref MIDI_Device_ReceiveEventPackets().
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[in]     EndpointNumber     Number of the OUT endpoint which has received a packet.
+			 */
+			void MIDI_Device_ProcessEndpointOUT(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+			                                    const uint8_t EndpointNumber) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the oldest event queued on the given virtual cable by the interrupt driven receive ring. Each cable's
+			 *  queue is drained independently of the others.
+			 *
+			 *  \param[in,out] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[in]     CableNumber        Virtual cable whose queue is to be read, less than \ref MIDI_DEVICE_RX_CABLES.
+			 *  \param[out]    Event              Pointer to a \ref MIDI_TimestampedEvent_t structure where the event is to be placed.
+			 *
+			 *  \return Boolean \c true if an event was retrieved, \c false if the cable's queue was empty.
+			 */
+			bool MIDI_Device_ReceiveTimestampedEvent(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+			                                         const uint8_t CableNumber,
+			                                         MIDI_TimestampedEvent_t* const Event) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
 		/* Inline Functions: */
+			/** Retrieves the number of events waiting in the given virtual cable's receive queue.
+			 *
+			 *  \param[in] MIDIInterfaceInfo  Pointer to a structure containing a MIDI Class configuration and state.
+			 *  \param[in] CableNumber        Virtual cable whose queue is to be checked, less than \ref MIDI_DEVICE_RX_CABLES.
+			 *
+			 *  \return Number of events queued on the given cable.
+			 */
+			static inline uint8_t MIDI_Device_TimestampedEventCount(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+			                                                        const uint8_t CableNumber) ATTR_NON_NULL_PTR_ARG(1);
+			static inline uint8_t MIDI_Device_TimestampedEventCount(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo,
+			                                                        const uint8_t CableNumber)
+			{
+				return (uint8_t)(MIDIInterfaceInfo->State.RxWriteIndex[CableNumber] - MIDIInterfaceInfo->State.RxReadIndex[CableNumber]);
+			}
+
 			/** Processes incoming control requests from the host, that are directed to the given MIDI class interface. This should be
 			 *  linked to the library \ref EVENT_USB_Device_ControlRequest() event.
 			 *
@@ -173,6 +341,17 @@
 				(void)MIDIInterfaceInfo;
 			}
 
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define MIDI_DEVICE_RX_QUEUE_INDEX(Cable, Index)   (((Cable) * MIDI_DEVICE_RX_QUEUE_SIZE) + ((Index) & (MIDI_DEVICE_RX_QUEUE_SIZE - 1)))
+
+		/* Function Prototypes: */
+			#if defined(__INCLUDE_FROM_MIDI_DEVICE_C)
+				static bool MIDI_Device_ReceivePacket(USB_ClassInfo_MIDI_Device_t* const MIDIInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			#endif
+	#endif
+
 	/* Disable C linkage for C++ Compilers: */
 		#if defined(__cplusplus)
 			}
@@ -0,0 +1,586 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+#define  __INCLUDE_FROM_USB_DRIVER
+#include "../../Core/USBMode.h"
+
+#if defined(USB_CAN_BE_DEVICE)
+
+#define  __INCLUDE_FROM_NCM_DRIVER
+#define  __INCLUDE_FROM_NCM_DEVICE_C
+#include "NCM.h"
+
+void NCM_Device_ProcessControlRequest(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	if (!(Endpoint_IsSETUPReceived()))
+	  return;
+
+	if (USB_ControlRequest.wIndex == NCMInterfaceInfo->Config.DataInterfaceNumber)
+	{
+		if ((USB_ControlRequest.bRequest == REQ_SetInterface) &&
+		    (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_INTERFACE)))
+		{
+			Endpoint_ClearSETUP();
+			Endpoint_ClearStatusStage();
+
+			NCMInterfaceInfo->State.InterfaceEnabled  = ((USB_ControlRequest.wValue & 0xFF) != 0);
+			NCMInterfaceInfo->State.NotificationsSent = 0;
+
+			/* Selecting the data interface's zero bandwidth setting returns the function to its default NTB parameters */
+			if (!(NCMInterfaceInfo->State.InterfaceEnabled))
+			{
+				NCMInterfaceInfo->State.NTBInMaxSize    = NCM_NTB_IN_MAX_SIZE;
+				NCMInterfaceInfo->State.MaxDatagramSize = NCM_DATAGRAM_SIZE_MAX;
+			}
+
+			NCM_Device_ResetNTBs(NCMInterfaceInfo);
+		}
+
+		return;
+	}
+
+	if (USB_ControlRequest.wIndex != NCMInterfaceInfo->Config.ControlInterfaceNumber)
+	  return;
+
+	switch (USB_ControlRequest.bRequest)
+	{
+		case NCM_REQ_GetNTBParameters:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				NCM_NTB_Parameters_t NTBParameters = (NCM_NTB_Parameters_t)
+					{
+						.Length                 = sizeof(NCM_NTB_Parameters_t),
+						.NTBFormatsSupported    = NCM_NTB_FORMAT_SUPPORTED_16BIT,
+						.NTBInMaxSize           = NCM_NTB_IN_MAX_SIZE,
+						.NDPInDivisor           = NCM_NTB_ALIGNMENT,
+						.NDPInPayloadRemainder  = 0,
+						.NDPInAlignment         = NCM_NTB_ALIGNMENT,
+						.Reserved               = 0,
+						.NTBOutMaxSize          = NCM_NTB_OUT_MAX_SIZE,
+						.NDPOutDivisor          = NCM_NTB_ALIGNMENT,
+						.NDPOutPayloadRemainder = 0,
+						.NDPOutAlignment        = NCM_NTB_ALIGNMENT,
+						.NTBOutMaxDatagrams     = 0,
+					};
+
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(&NTBParameters, sizeof(NCM_NTB_Parameters_t));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+		case NCM_REQ_GetNetAddress:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(&NCMInterfaceInfo->State.CurrentMACAddress, sizeof(MAC_Address_t));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+		case NCM_REQ_SetNetAddress:
+			/* The network address may only be changed while the data interface is in its zero bandwidth setting */
+			if ((USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) &&
+			    (USB_ControlRequest.wLength == sizeof(MAC_Address_t)) && !(NCMInterfaceInfo->State.InterfaceEnabled))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_Read_Control_Stream_LE(&NCMInterfaceInfo->State.CurrentMACAddress, sizeof(MAC_Address_t));
+				Endpoint_ClearIN();
+			}
+
+			break;
+		case NCM_REQ_GetNTBFormat:
+		case NCM_REQ_GetCRCMode:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				/* Only 16-bit NTBs without datagram CRCs are supported, both encoded as a value of zero */
+				uint16_t CurrentMode = 0;
+
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(&CurrentMode, sizeof(uint16_t));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+		case NCM_REQ_SetNTBFormat:
+		case NCM_REQ_SetCRCMode:
+			if ((USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) &&
+			    (USB_ControlRequest.wValue == 0))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_ClearStatusStage();
+			}
+
+			break;
+		case NCM_REQ_GetNTBInputSize:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				uint32_t NTBInputSize = NCMInterfaceInfo->State.NTBInMaxSize;
+
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(&NTBInputSize, sizeof(uint32_t));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+		case NCM_REQ_SetNTBInputSize:
+			if ((USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) &&
+			    (USB_ControlRequest.wLength == sizeof(uint32_t)))
+			{
+				uint32_t NTBInputSize;
+
+				Endpoint_ClearSETUP();
+				Endpoint_Read_Control_Stream_LE(&NTBInputSize, sizeof(uint32_t));
+
+				/* Sizes which cannot hold an NTB of one maximum sized datagram are refused, as full sized frames could then
+				   never be sent */
+				if (NTBInputSize < NCM_NTB_SIZE_MIN)
+				{
+					Endpoint_StallTransaction();
+					break;
+				}
+
+				Endpoint_ClearIN();
+
+				NCMInterfaceInfo->State.NTBInMaxSize = MIN(NTBInputSize, NCM_NTB_IN_MAX_SIZE);
+			}
+
+			break;
+		case NCM_REQ_GetMaxDatagramSize:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(&NCMInterfaceInfo->State.MaxDatagramSize, sizeof(uint16_t));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+		case NCM_REQ_SetMaxDatagramSize:
+			if ((USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) &&
+			    (USB_ControlRequest.wLength == sizeof(uint16_t)))
+			{
+				uint16_t MaxDatagramSize;
+
+				Endpoint_ClearSETUP();
+				Endpoint_Read_Control_Stream_LE(&MaxDatagramSize, sizeof(uint16_t));
+				Endpoint_ClearIN();
+
+				NCMInterfaceInfo->State.MaxDatagramSize = MIN(MaxDatagramSize, NCM_DATAGRAM_SIZE_MAX);
+			}
+
+			break;
+		case NCM_REQ_SetEthernetPacketFilter:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_ClearStatusStage();
+
+				NCMInterfaceInfo->State.PacketFilter = USB_ControlRequest.wValue;
+			}
+
+			break;
+	}
+}
+
+bool NCM_Device_ConfigureEndpoints(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	memset(&NCMInterfaceInfo->State, 0x00, sizeof(NCMInterfaceInfo->State));
+
+	NCMInterfaceInfo->State.NTBInMaxSize      = NCM_NTB_IN_MAX_SIZE;
+	NCMInterfaceInfo->State.MaxDatagramSize   = NCM_DATAGRAM_SIZE_MAX;
+	NCMInterfaceInfo->State.PacketFilter      = (NCM_PACKET_TYPE_DIRECTED | NCM_PACKET_TYPE_BROADCAST | NCM_PACKET_TYPE_ALL_MULTICAST);
+	NCMInterfaceInfo->State.CurrentMACAddress = NCMInterfaceInfo->Config.AdapterMACAddress;
+
+	NCM_Device_ResetNTBs(NCMInterfaceInfo);
+
+	for (uint8_t EndpointNum = 1; EndpointNum < ENDPOINT_TOTAL_ENDPOINTS; EndpointNum++)
+	{
+		uint16_t Size;
+		uint8_t  Type;
+		uint8_t  Direction;
+		bool     DoubleBanked;
+
+		if (EndpointNum == NCMInterfaceInfo->Config.DataINEndpointNumber)
+		{
+			Size         = NCMInterfaceInfo->Config.DataINEndpointSize;
+			Direction    = ENDPOINT_DIR_IN;
+			Type         = EP_TYPE_BULK;
+			DoubleBanked = NCMInterfaceInfo->Config.DataINEndpointDoubleBank;
+		}
+		else if (EndpointNum == NCMInterfaceInfo->Config.DataOUTEndpointNumber)
+		{
+			Size         = NCMInterfaceInfo->Config.DataOUTEndpointSize;
+			Direction    = ENDPOINT_DIR_OUT;
+			Type         = EP_TYPE_BULK;
+			DoubleBanked = NCMInterfaceInfo->Config.DataOUTEndpointDoubleBank;
+		}
+		else if (EndpointNum == NCMInterfaceInfo->Config.NotificationEndpointNumber)
+		{
+			Size         = NCMInterfaceInfo->Config.NotificationEndpointSize;
+			Direction    = ENDPOINT_DIR_IN;
+			Type         = EP_TYPE_INTERRUPT;
+			DoubleBanked = NCMInterfaceInfo->Config.NotificationEndpointDoubleBank;
+		}
+		else
+		{
+			continue;
+		}
+
+		if (!(Endpoint_ConfigureEndpoint(EndpointNum, Type, Direction, Size,
+		                                 DoubleBanked ? ENDPOINT_BANK_DOUBLE : ENDPOINT_BANK_SINGLE)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void NCM_Device_USBTask(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(NCMInterfaceInfo->State.InterfaceEnabled))
+	  return;
+
+	Endpoint_SelectEndpoint(NCMInterfaceInfo->Config.NotificationEndpointNumber);
+
+	if ((NCMInterfaceInfo->State.NotificationsSent < 2) && Endpoint_IsINReady())
+	{
+		if (!(NCMInterfaceInfo->State.NotificationsSent))
+		{
+			NCM_ConnectionSpeed_t ConnectionSpeed = (NCM_ConnectionSpeed_t)
+				{
+					.DownlinkBitRate = NCMInterfaceInfo->Config.LinkSpeed,
+					.UplinkBitRate   = NCMInterfaceInfo->Config.LinkSpeed,
+				};
+
+			NCM_Device_SendNotification(NCMInterfaceInfo, NCM_NOTIF_ConnectionSpeedChange, 0,
+			                            &ConnectionSpeed, sizeof(NCM_ConnectionSpeed_t));
+		}
+		else
+		{
+			NCM_Device_SendNotification(NCMInterfaceInfo, NCM_NOTIF_NetworkConnection, 1, NULL, 0);
+		}
+
+		NCMInterfaceInfo->State.NotificationsSent++;
+	}
+
+	if (NCMInterfaceInfo->State.NTBInDatagramCount)
+	{
+		uint16_t FramesElapsed = ((USB_Device_GetFrameNumber() - NCMInterfaceInfo->State.NTBInStartFrame) & NCM_FRAME_NUMBER_MASK);
+
+		if (FramesElapsed >= NCMInterfaceInfo->Config.AggregationTimeoutMS)
+		  NCM_Device_Flush(NCMInterfaceInfo);
+	}
+}
+
+bool NCM_Device_IsPacketReceived(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(NCMInterfaceInfo->State.InterfaceEnabled))
+	  return false;
+
+	if (NCMInterfaceInfo->State.NTBOutLength)
+	  return true;
+
+	Endpoint_SelectEndpoint(NCMInterfaceInfo->Config.DataOUTEndpointNumber);
+	return Endpoint_IsOUTReceived();
+}
+
+uint8_t NCM_Device_ReadPacket(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+                              void* Buffer,
+                              uint16_t* const PacketLength)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(NCMInterfaceInfo->State.InterfaceEnabled))
+	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
+
+	*PacketLength = 0;
+
+	if (!(NCMInterfaceInfo->State.NTBOutLength))
+	{
+		Endpoint_SelectEndpoint(NCMInterfaceInfo->Config.DataOUTEndpointNumber);
+
+		if (!(Endpoint_IsOUTReceived()))
+		  return ENDPOINT_RWSTREAM_NoError;
+
+		if (NCMInterfaceInfo->State.NTBOutZLPPending)
+		{
+			NCMInterfaceInfo->State.NTBOutZLPPending = false;
+
+			Endpoint_ClearOUT();
+			return ENDPOINT_RWSTREAM_NoError;
+		}
+
+		if (!(NCM_Device_ReceiveNTB(NCMInterfaceInfo)))
+		  return NCM_ERROR_LOGICAL_CMD_FAILED;
+	}
+
+	uint8_t* NTB = NCMInterfaceInfo->State.NTBOutBuffer;
+
+	for (;;)
+	{
+		uint16_t DatagramIndex = NCMInterfaceInfo->State.NTBOutDatagramIndex;
+		NCM_DatagramPointer16_t* DatagramPointer = (NCM_DatagramPointer16_t*)&NTB[DatagramIndex];
+
+		if (((DatagramIndex + sizeof(NCM_DatagramPointer16_t)) > NCMInterfaceInfo->State.NTBOutLength) ||
+		    !(DatagramPointer->DatagramIndex) || !(DatagramPointer->DatagramLength))
+		{
+			NCM_NDP16_t* NDP = (NCM_NDP16_t*)&NTB[NCMInterfaceInfo->State.NTBOutNDPIndex];
+
+			/* End of the current datagram table, continue with the next table in the NTB if one is present */
+			if (!(NDP->NextNDPIndex) || !(NCM_Device_SelectNDP(NCMInterfaceInfo, NDP->NextNDPIndex)))
+			{
+				NCMInterfaceInfo->State.NTBOutLength = 0;
+				return ENDPOINT_RWSTREAM_NoError;
+			}
+
+			continue;
+		}
+
+		NCMInterfaceInfo->State.NTBOutDatagramIndex += sizeof(NCM_DatagramPointer16_t);
+
+		if (((uint32_t)DatagramPointer->DatagramIndex + DatagramPointer->DatagramLength > NCMInterfaceInfo->State.NTBOutLength) ||
+		    (DatagramPointer->DatagramLength > NCMInterfaceInfo->State.MaxDatagramSize) ||
+		    (DatagramPointer->DatagramLength < sizeof(MAC_Address_t)))
+		{
+			continue;
+		}
+
+		if (!(NCM_Device_IsFrameAccepted(NCMInterfaceInfo, (MAC_Address_t*)&NTB[DatagramPointer->DatagramIndex])))
+		  continue;
+
+		memcpy(Buffer, &NTB[DatagramPointer->DatagramIndex], DatagramPointer->DatagramLength);
+		*PacketLength = DatagramPointer->DatagramLength;
+
+		return ENDPOINT_RWSTREAM_NoError;
+	}
+}
+
+static bool NCM_Device_IsFrameAccepted(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+                                       const MAC_Address_t* const DestinationAddress)
+{
+	uint16_t PacketFilter = NCMInterfaceInfo->State.PacketFilter;
+
+	if (PacketFilter & NCM_PACKET_TYPE_PROMISCUOUS)
+	  return true;
+
+	/* Individual (unicast) addresses have the group bit of the first octet cleared */
+	if (!(DestinationAddress->Octets[0] & 0x01))
+	{
+		return ((PacketFilter & NCM_PACKET_TYPE_DIRECTED) &&
+		        !(memcmp(DestinationAddress, &NCMInterfaceInfo->State.CurrentMACAddress, sizeof(MAC_Address_t))));
+	}
+
+	static const MAC_Address_t PROGMEM BroadcastAddress = {{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+
+	if (!(memcmp_P(DestinationAddress, &BroadcastAddress, sizeof(MAC_Address_t))))
+	  return (PacketFilter & NCM_PACKET_TYPE_BROADCAST);
+
+	/* The driver does not handle the Ethernet multicast filter list request, so no address list is kept; the multicast
+	   filter passes every multicast frame and leaves the exact match to the application's network stack */
+	return (PacketFilter & (NCM_PACKET_TYPE_ALL_MULTICAST | NCM_PACKET_TYPE_MULTICAST));
+}
+
+uint8_t NCM_Device_SendPacket(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+                              const void* Buffer,
+                              const uint16_t PacketLength)
+{
+	uint8_t ErrorCode;
+
+	if ((USB_DeviceState != DEVICE_STATE_Configured) || !(NCMInterfaceInfo->State.InterfaceEnabled))
+	  return ENDPOINT_RWSTREAM_DeviceDisconnected;
+
+	if (!(PacketLength) || (PacketLength > NCMInterfaceInfo->State.MaxDatagramSize))
+	  return NCM_ERROR_LOGICAL_CMD_FAILED;
+
+	uint16_t DatagramIndex = NCM_NTB_ALIGN(NCMInterfaceInfo->State.NTBInLength);
+	uint8_t  DatagramCount = NCMInterfaceInfo->State.NTBInDatagramCount;
+
+	/* Send the current NTB first if the new datagram and the enlarged datagram table will not fit within it */
+	if (DatagramCount &&
+	    ((NCM_NTB_ALIGN(DatagramIndex + PacketLength) + NCM_NDP16_SIZE(DatagramCount + 1)) > NCMInterfaceInfo->State.NTBInMaxSize))
+	{
+		if ((ErrorCode = NCM_Device_Flush(NCMInterfaceInfo)) != ENDPOINT_RWSTREAM_NoError)
+		  return ErrorCode;
+
+		DatagramIndex = NCM_NTB_ALIGN(NCMInterfaceInfo->State.NTBInLength);
+		DatagramCount = 0;
+	}
+
+	if ((NCM_NTB_ALIGN(DatagramIndex + PacketLength) + NCM_NDP16_SIZE(1)) > NCMInterfaceInfo->State.NTBInMaxSize)
+	  return NCM_ERROR_LOGICAL_CMD_FAILED;
+
+	if (!(DatagramCount))
+	  NCMInterfaceInfo->State.NTBInStartFrame = USB_Device_GetFrameNumber();
+
+	memcpy(&NCMInterfaceInfo->State.NTBInBuffer[DatagramIndex], Buffer, PacketLength);
+
+	NCMInterfaceInfo->State.NTBInDatagrams[DatagramCount].DatagramIndex  = DatagramIndex;
+	NCMInterfaceInfo->State.NTBInDatagrams[DatagramCount].DatagramLength = PacketLength;
+
+	NCMInterfaceInfo->State.NTBInDatagramCount = (DatagramCount + 1);
+	NCMInterfaceInfo->State.NTBInLength        = (DatagramIndex + PacketLength);
+
+	if (NCMInterfaceInfo->State.NTBInDatagramCount == NCM_NTB_IN_MAX_DATAGRAMS)
+	  return NCM_Device_Flush(NCMInterfaceInfo);
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t NCM_Device_Flush(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	uint8_t ErrorCode;
+	uint8_t DatagramCount = NCMInterfaceInfo->State.NTBInDatagramCount;
+
+	if (!(DatagramCount))
+	  return ENDPOINT_RWSTREAM_NoError;
+
+	Endpoint_SelectEndpoint(NCMInterfaceInfo->Config.DataINEndpointNumber);
+
+	if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
+	  return ErrorCode;
+
+	uint8_t* NTB         = NCMInterfaceInfo->State.NTBInBuffer;
+	uint16_t NDPIndex    = NCM_NTB_ALIGN(NCMInterfaceInfo->State.NTBInLength);
+	uint16_t BlockLength = (NDPIndex + NCM_NDP16_SIZE(DatagramCount));
+
+	/* The datagram table is placed after the last datagram, so that datagrams can be copied in as they are sent */
+	NCM_NDP16_t* NDP = (NCM_NDP16_t*)&NTB[NDPIndex];
+	NDP->Signature    = NCM_NDP16_SIGNATURE_NOCRC;
+	NDP->Length       = NCM_NDP16_SIZE(DatagramCount);
+	NDP->NextNDPIndex = 0;
+
+	NCM_DatagramPointer16_t* DatagramPointers = (NCM_DatagramPointer16_t*)&NTB[NDPIndex + sizeof(NCM_NDP16_t)];
+	memcpy(DatagramPointers, NCMInterfaceInfo->State.NTBInDatagrams, (DatagramCount * sizeof(NCM_DatagramPointer16_t)));
+	memset(&DatagramPointers[DatagramCount], 0x00, sizeof(NCM_DatagramPointer16_t));
+
+	NCM_NTH16_t* NTH = (NCM_NTH16_t*)NTB;
+	NTH->Signature    = NCM_NTH16_SIGNATURE;
+	NTH->HeaderLength = sizeof(NCM_NTH16_t);
+	NTH->Sequence     = NCMInterfaceInfo->State.NTBInSequence++;
+	NTH->BlockLength  = BlockLength;
+	NTH->NDPIndex     = NDPIndex;
+
+	Endpoint_Write_Stream_LE(NTB, BlockLength, NULL);
+	Endpoint_ClearIN();
+
+	/* NTBs shorter than the host's maximum which end on a packet boundary must be terminated with a zero length packet */
+	if (!(BlockLength % NCMInterfaceInfo->Config.DataINEndpointSize) && (BlockLength < NCMInterfaceInfo->State.NTBInMaxSize))
+	{
+		if ((ErrorCode = Endpoint_WaitUntilReady()) == ENDPOINT_READYWAIT_NoError)
+		  Endpoint_ClearIN();
+	}
+
+	NCMInterfaceInfo->State.NTBInDatagramCount = 0;
+	NCMInterfaceInfo->State.NTBInLength        = sizeof(NCM_NTH16_t);
+
+	return ErrorCode;
+}
+
+static void NCM_Device_ResetNTBs(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	NCMInterfaceInfo->State.NTBInDatagramCount = 0;
+	NCMInterfaceInfo->State.NTBInLength        = sizeof(NCM_NTH16_t);
+	NCMInterfaceInfo->State.NTBInSequence      = 0;
+	NCMInterfaceInfo->State.NTBOutLength       = 0;
+	NCMInterfaceInfo->State.NTBOutZLPPending   = false;
+}
+
+static bool NCM_Device_ReceiveNTB(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo)
+{
+	NCM_NTH16_t* NTH = (NCM_NTH16_t*)NCMInterfaceInfo->State.NTBOutBuffer;
+
+	Endpoint_Read_Stream_LE(NTH, sizeof(NCM_NTH16_t), NULL);
+
+	if ((NTH->Signature != NCM_NTH16_SIGNATURE) || (NTH->HeaderLength != sizeof(NCM_NTH16_t)) ||
+	    (NTH->BlockLength < sizeof(NCM_NTH16_t)) || (NTH->BlockLength > NCM_NTB_OUT_MAX_SIZE))
+	{
+		Endpoint_ClearOUT();
+		return false;
+	}
+
+	Endpoint_Read_Stream_LE(&NCMInterfaceInfo->State.NTBOutBuffer[sizeof(NCM_NTH16_t)],
+	                        (NTH->BlockLength - sizeof(NCM_NTH16_t)), NULL);
+	Endpoint_ClearOUT();
+
+	NCMInterfaceInfo->State.NTBOutZLPPending = (!(NTH->BlockLength % NCMInterfaceInfo->Config.DataOUTEndpointSize) &&
+	                                            (NTH->BlockLength < NCM_NTB_OUT_MAX_SIZE));
+	NCMInterfaceInfo->State.NTBOutLength     = NTH->BlockLength;
+
+	if (!(NCM_Device_SelectNDP(NCMInterfaceInfo, NTH->NDPIndex)))
+	{
+		NCMInterfaceInfo->State.NTBOutLength = 0;
+		return false;
+	}
+
+	return true;
+}
+
+static bool NCM_Device_SelectNDP(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+                                 const uint16_t NDPIndex)
+{
+	NCM_NDP16_t* NDP = (NCM_NDP16_t*)&NCMInterfaceInfo->State.NTBOutBuffer[NDPIndex];
+
+	if ((NDPIndex < sizeof(NCM_NTH16_t)) || (NDPIndex % NCM_NTB_ALIGNMENT) ||
+	    ((NDPIndex + sizeof(NCM_NDP16_t)) > NCMInterfaceInfo->State.NTBOutLength) ||
+	    (NDP->Signature != NCM_NDP16_SIGNATURE_NOCRC))
+	{
+		return false;
+	}
+
+	NCMInterfaceInfo->State.NTBOutNDPIndex      = NDPIndex;
+	NCMInterfaceInfo->State.NTBOutDatagramIndex = (NDPIndex + sizeof(NCM_NDP16_t));
+
+	return true;
+}
+
+static void NCM_Device_SendNotification(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+                                        const uint8_t Notification,
+                                        const uint16_t Value,
+                                        const void* const Data,
+                                        const uint16_t DataLength)
+{
+	USB_Request_Header_t NotificationHeader = (USB_Request_Header_t)
+		{
+			.bmRequestType = (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE),
+			.bRequest      = Notification,
+			.wValue        = Value,
+			.wIndex        = NCMInterfaceInfo->Config.ControlInterfaceNumber,
+			.wLength       = DataLength,
+		};
+
+	Endpoint_Write_Stream_LE(&NotificationHeader, sizeof(USB_Request_Header_t), NULL);
+
+	if (DataLength)
+	  Endpoint_Write_Stream_LE(Data, DataLength, NULL);
+
+	Endpoint_ClearIN();
+}
+
+#endif
+
@@ -0,0 +1,299 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *  \brief Device mode driver for the library USB CDC-NCM Class driver.
+ *
+ *  Device mode driver for the library USB CDC-NCM Class driver.
+ *
+ *  \note This file should not be included directly. It is automatically included as needed by the USB module driver
+ *        dispatch header located in LUFA/Drivers/USB.h.
+ */
+
+/** \ingroup Group_USBClassNCM
+ *  \defgroup Group_USBClassNCMDevice CDC-NCM Class Device Mode Driver
+ *
+ *  \section Sec_Dependencies Module Source Dependencies
+ *  The following files must be built with any user project that uses this module:
+ *    - LUFA/Drivers/USB/Class/Device/NCM.c <i>(Makefile source module name: LUFA_SRC_USBCLASS)</i>
+ *
+ *  \section Sec_ModDescription Module Description
+ *  Device Mode USB Class driver framework interface, for the CDC Network Control Model USB Class driver.
+ *
+ *  Ethernet frames sent by the application are aggregated into a single Network Transfer Block (NTB) until the
+ *  block is full, the host's maximum datagram count is reached or the configured aggregation timeout elapses. OUT
+ *  NTBs from the host are read in one transfer and their datagrams handed to the application one at a time.
+ *
+ *  @{
+ */
+
+#ifndef _NCM_CLASS_DEVICE_H_
+#define _NCM_CLASS_DEVICE_H_
+
+	/* Includes: */
+		#include "../../USB.h"
+		#include "../Common/NCM.h"
+
+	/* Enable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			extern "C" {
+		#endif
+
+	/* Preprocessor Checks: */
+		#if !defined(__INCLUDE_FROM_NCM_DRIVER)
+			#error Do not include this file directly. Include LUFA/Drivers/USB.h instead.
+		#endif
+
+	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if !defined(NCM_NTB_IN_MAX_SIZE) || defined(__DOXYGEN__)
+				/** Size in bytes of the buffer used to aggregate datagrams into IN NTBs sent to the host. The host may
+				 *  lower the size actually used through the \ref NCM_REQ_SetNTBInputSize request. This may be overridden
+				 *  in the user project makefile by passing the \c NCM_NTB_IN_MAX_SIZE token to the compiler via the -D switch.
+				 *
+				 *  The default of 2048 bytes is the minimum IN NTB size required by the CDC-NCM specification, which hosts
+				 *  rely on - Linux for example warns that smaller sizes are too small and uses 2048 bytes regardless. Small RAM
+				 *  builds may lower this to 1544 bytes, the smallest NTB holding one maximum sized datagram (a 12 byte NTH16
+				 *  header, the datagram rounded up to the NTB alignment and a 16 byte NDP16), at the cost of compatibility
+				 *  with such hosts and of aggregating fewer datagrams per transfer. Larger values raise throughput at the
+				 *  cost of one byte of RAM per byte of buffer.
+				 */
+				#define NCM_NTB_IN_MAX_SIZE        2048
+			#endif
+
+			#if !defined(NCM_NTB_OUT_MAX_SIZE) || defined(__DOXYGEN__)
+				/** Size in bytes of the buffer used to receive OUT NTBs from the host. This may be overridden in the user
+				 *  project makefile by passing the \c NCM_NTB_OUT_MAX_SIZE token to the compiler via the -D switch.
+				 *
+				 *  The host never sends NTBs larger than this size, so it may be lowered to 1544 bytes in small RAM builds,
+				 *  leaving room for a single maximum sized datagram per transfer, or raised to let the host aggregate more
+				 *  full sized datagrams into each transfer, trading RAM for throughput.
+				 */
+				#define NCM_NTB_OUT_MAX_SIZE       2048
+			#endif
+
+			#if !defined(NCM_NTB_IN_MAX_DATAGRAMS) || defined(__DOXYGEN__)
+				/** Maximum number of datagrams aggregated into a single IN NTB. Each datagram pointer costs four bytes of
+				 *  RAM, so this should be scaled together with \ref NCM_NTB_IN_MAX_SIZE. This may be overridden in the user
+				 *  project makefile by passing the \c NCM_NTB_IN_MAX_DATAGRAMS token to the compiler via the -D switch.
+				 */
+				#define NCM_NTB_IN_MAX_DATAGRAMS   8
+			#endif
+
+		/* Type Defines: */
+			/** \brief CDC-NCM Class Device Mode Configuration and State Structure.
+			 *
+			 *  Class state structure. An instance of this structure should be made for each NCM interface
+			 *  within the user application, and passed to each of the NCM class driver functions as the
+			 *  \c NCMInterfaceInfo parameter. This stores each NCM interface's configuration and state information.
+			 */
+			typedef struct
+			{
+				const struct
+				{
+					uint8_t  ControlInterfaceNumber; /**< Interface number of the NCM control interface within the device. */
+					uint8_t  DataInterfaceNumber; /**< Interface number of the NCM data interface within the device. */
+
+					uint8_t  DataINEndpointNumber; /**< Endpoint number of the NCM interface's IN data endpoint. */
+					uint16_t DataINEndpointSize; /**< Size in bytes of the NCM interface's IN data endpoint. */
+					bool     DataINEndpointDoubleBank; /**< Indicates if the NCM interface's IN data endpoint should use double banking. */
+
+					uint8_t  DataOUTEndpointNumber; /**< Endpoint number of the NCM interface's OUT data endpoint. */
+					uint16_t DataOUTEndpointSize;  /**< Size in bytes of the NCM interface's OUT data endpoint. */
+					bool     DataOUTEndpointDoubleBank; /**< Indicates if the NCM interface's OUT data endpoint should use double banking. */
+
+					uint8_t  NotificationEndpointNumber; /**< Endpoint number of the NCM interface's IN notification endpoint. */
+					uint16_t NotificationEndpointSize;  /**< Size in bytes of the NCM interface's IN notification endpoint. */
+					bool     NotificationEndpointDoubleBank; /**< Indicates if the NCM interface's notification endpoint should use double banking. */
+
+					MAC_Address_t AdapterMACAddress; /**< MAC address of the adapter, reported to the host as its default network address. */
+					uint32_t      LinkSpeed; /**< Speed of the network link reported to the host, in bits per second. */
+					uint8_t       AggregationTimeoutMS; /**< Maximum time in milliseconds a datagram may wait in the IN NTB for further
+					                                     *   datagrams to aggregate with, zero to send the NTB on every call to
+					                                     *   \ref NCM_Device_USBTask().
+					                                     */
+				} Config; /**< Config data for the USB class interface within the device. All elements in this section
+				           *   <b>must</b> be set or the interface will fail to enumerate and operate correctly.
+				           */
+				struct
+				{
+					uint8_t  NTBInBuffer[NCM_NTB_IN_MAX_SIZE] ATTR_ALIGNED(4); /**< Buffer used to aggregate datagrams into the
+					                                                           *   next IN NTB, managed by the class driver.
+					                                                           */
+					uint8_t  NTBOutBuffer[NCM_NTB_OUT_MAX_SIZE] ATTR_ALIGNED(4); /**< Buffer holding the last OUT NTB received
+					                                                             *   from the host, managed by the class driver.
+					                                                             */
+					NCM_DatagramPointer16_t NTBInDatagrams[NCM_NTB_IN_MAX_DATAGRAMS]; /**< Datagram pointers of the IN NTB under
+					                                                                    *   construction, written out as its NDP.
+					                                                                    */
+					uint8_t  NTBInDatagramCount; /**< Number of datagrams currently aggregated into the IN NTB. */
+					uint16_t NTBInLength; /**< Offset of the next free byte in the IN NTB buffer. */
+					uint16_t NTBInMaxSize; /**< Maximum IN NTB size currently accepted by the host. */
+					uint16_t NTBInSequence; /**< Sequence number of the next IN NTB. */
+					uint16_t NTBInStartFrame; /**< USB frame number when the first datagram was added to the IN NTB. */
+					uint16_t NTBOutLength; /**< Length of the buffered OUT NTB, zero if no NTB is buffered. */
+					uint16_t NTBOutNDPIndex; /**< Offset of the NDP currently being processed in the buffered OUT NTB. */
+					uint16_t NTBOutDatagramIndex; /**< Offset of the next datagram pointer to process in the buffered OUT NTB. */
+					uint16_t MaxDatagramSize; /**< Maximum datagram size currently set by the host. */
+					uint16_t PacketFilter; /**< Ethernet packet filter set by the host, a mask of \c NCM_PACKET_TYPE_* masks. */
+					MAC_Address_t CurrentMACAddress; /**< Network address currently set by the host. */
+					bool     InterfaceEnabled; /**< Indicates if the host has selected the data interface's alternate setting. */
+					bool     NTBOutZLPPending; /**< Indicates if the host will terminate the last OUT NTB with a zero length packet. */
+					uint8_t  NotificationsSent; /**< Number of link state notifications sent to the host for the current link. */
+				} State; /**< State data for the USB class interface within the device. All elements in this section
+				          *   are reset to their defaults when the interface is enumerated.
+				          */
+			} USB_ClassInfo_NCM_Device_t;
+
+		/* Function Prototypes: */
+			/** Configures the endpoints of a given NCM interface, ready for use. This should be linked to the library
+			 *  \ref EVENT_USB_Device_ConfigurationChanged() event so that the endpoints are configured when the configuration
+			 *  containing the given NCM interface is selected.
+			 *
+			 *  \note The endpoint index numbers as given in the interface's configuration structure must not overlap with any other
+			 *        interface, or endpoint bank corruption will occur. Gaps in the allocated endpoint numbers or non-sequential indexes
+			 *        within a single interface is allowed, but no two interfaces of any type have have interleaved endpoint indexes.
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 *
+			 *  \return Boolean \c true if the endpoints were successfully configured, \c false otherwise.
+			 */
+			bool NCM_Device_ConfigureEndpoints(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Processes incoming control requests from the host, that are directed to the given NCM class interface. This should be
+			 *  linked to the library \ref EVENT_USB_Device_ControlRequest() event.
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 */
+			void NCM_Device_ProcessControlRequest(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** General management task for a given NCM class interface, required for the correct operation of the interface. This
+			 *  sends the link state notifications to the host and transmits the pending IN NTB once its aggregation timeout has
+			 *  elapsed. This should be called frequently in the main program loop, before the master USB management task
+			 *  \ref USB_USBTask().
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 */
+			void NCM_Device_USBTask(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Determines if a packet is currently waiting for the device to read in and process, either in the buffered
+			 *  OUT NTB or in the OUT endpoint.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 *
+			 *  \return Boolean \c true if a packet is waiting to be read in by the device, \c false otherwise.
+			 */
+			bool NCM_Device_IsPacketReceived(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Retrieves the next pending datagram from the host. When the current OUT NTB has no datagrams left, the next NTB
+			 *  is read in from the OUT endpoint in a single transfer. Datagrams rejected by the Ethernet packet filter set by
+			 *  the host are skipped.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 *  \param[out]    Buffer            Pointer to a buffer of at least \ref NCM_DATAGRAM_SIZE_MAX bytes where the packet
+			 *                                   data is to be written to.
+			 *  \param[out]    PacketLength      Pointer to where the length in bytes of the read packet is to be stored, zero if
+			 *                                   no packet was available.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum, or \ref NCM_ERROR_LOGICAL_CMD_FAILED if
+			 *          the received NTB was malformed and has been discarded.
+			 */
+			uint8_t NCM_Device_ReadPacket(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+			                              void* Buffer,
+			                              uint16_t* const PacketLength) ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(3);
+
+			/** Adds the given packet to the IN NTB under construction for transmission to the host. If the packet does not fit
+			 *  in the current NTB, the NTB is first sent to the host and a new NTB started.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 *  \param[in]     Buffer            Pointer to a buffer where the packet data is to be read from.
+			 *  \param[in]     PacketLength      Length in bytes of the packet to send.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum, or \ref NCM_ERROR_LOGICAL_CMD_FAILED if
+			 *          the packet is larger than the maximum datagram size.
+			 */
+			uint8_t NCM_Device_SendPacket(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+			                              const void* Buffer,
+			                              const uint16_t PacketLength) ATTR_NON_NULL_PTR_ARG(1);
+
+			/** Sends the IN NTB under construction to the host immediately, regardless of the aggregation timeout. This
+			 *  has no effect if no datagrams are waiting to be sent.
+			 *
+			 *  \param[in,out] NCMInterfaceInfo  Pointer to a structure containing a NCM Class configuration and state.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t NCM_Device_Flush(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
+	/* Private Interface - For use in library only: */
+	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define NCM_NTB_ALIGNMENT               4
+			#define NCM_NTB_ALIGN(Offset)           (((Offset) + (NCM_NTB_ALIGNMENT - 1)) & ~(NCM_NTB_ALIGNMENT - 1))
+			#define NCM_NDP16_SIZE(Datagrams)       (sizeof(NCM_NDP16_t) + (((Datagrams) + 1) * sizeof(NCM_DatagramPointer16_t)))
+			#define NCM_NTB_SIZE_MIN                (NCM_NTB_ALIGN(sizeof(NCM_NTH16_t) + NCM_DATAGRAM_SIZE_MAX) + NCM_NDP16_SIZE(1))
+			#define NCM_FRAME_NUMBER_MASK           0x07FF
+
+		/* Function Prototypes: */
+		#if defined(__INCLUDE_FROM_NCM_DEVICE_C)
+			static void NCM_Device_ResetNTBs(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			static bool NCM_Device_ReceiveNTB(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+			static bool NCM_Device_SelectNDP(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+			                                 const uint16_t NDPIndex) ATTR_NON_NULL_PTR_ARG(1);
+			static bool NCM_Device_IsFrameAccepted(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+			                                       const MAC_Address_t* const DestinationAddress) ATTR_WARN_UNUSED_RESULT
+			                                       ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
+			static void NCM_Device_SendNotification(USB_ClassInfo_NCM_Device_t* const NCMInterfaceInfo,
+			                                        const uint8_t Notification,
+			                                        const uint16_t Value,
+			                                        const void* const Data,
+			                                        const uint16_t DataLength) ATTR_NON_NULL_PTR_ARG(1);
+		#endif
+
+	#endif
+
+	/* Disable C linkage for C++ Compilers: */
+		#if defined(__cplusplus)
+			}
+		#endif
+
+#endif
+
+/** @} */
+
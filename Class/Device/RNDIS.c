@@ -59,6 +59,9 @@ static const uint32_t PROGMEM AdapterSupportedOIDList[]  =
 		OID_GEN_XMIT_ERROR,
 		OID_GEN_RCV_ERROR,
 		OID_GEN_RCV_NO_BUFFER,
+		OID_GEN_BYTES_XMIT,
+		OID_GEN_BYTES_RCV,
+		OID_GEN_RCV_DISCARDS,
 		OID_802_3_PERMANENT_ADDRESS,
 		OID_802_3_CURRENT_ADDRESS,
 		OID_802_3_MULTICAST_LIST,
@@ -387,8 +390,8 @@ static bool RNDIS_Device_ProcessNDISQuery(USB_ClassInfo_RNDIS_Device_t* const RN
 		case OID_802_3_MAXIMUM_LIST_SIZE:
 			*ResponseSize = sizeof(uint32_t);
 
-			/* Indicate only one multicast address supported */
-			*((uint32_t*)ResponseData) = 1;
+			/* Indicate the number of multicast addresses the hash filter will accept */
+			*((uint32_t*)ResponseData) = RNDIS_MULTICAST_LIST_SIZE_MAX;
 
 			return true;
 		case OID_GEN_CURRENT_PACKET_FILTER:
@@ -398,10 +401,56 @@ static bool RNDIS_Device_ProcessNDISQuery(USB_ClassInfo_RNDIS_Device_t* const RN
 
 			return true;
 		case OID_GEN_XMIT_OK:
+			*ResponseSize = sizeof(uint32_t);
+
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.FramesTransmitted;
+
+			return true;
 		case OID_GEN_RCV_OK:
+			*ResponseSize = sizeof(uint32_t);
+
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.FramesReceived;
+
+			return true;
 		case OID_GEN_XMIT_ERROR:
+			*ResponseSize = sizeof(uint32_t);
+
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.TransmitErrors;
+
+			return true;
 		case OID_GEN_RCV_ERROR:
+			*ResponseSize = sizeof(uint32_t);
+
+			/* Frames dropped for an invalid length, either oversize or runt */
+			*((uint32_t*)ResponseData) = (RNDISInterfaceInfo->State.Statistics.OversizeFrames +
+			                              RNDISInterfaceInfo->State.Statistics.RuntFrames);
+
+			return true;
 		case OID_GEN_RCV_NO_BUFFER:
+			*ResponseSize = sizeof(uint32_t);
+
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.NoBufferDrops;
+
+			return true;
+		case OID_GEN_RCV_DISCARDS:
+			*ResponseSize = sizeof(uint32_t);
+
+			/* Frames dropped by the receive packet filter */
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.FilterRejects;
+
+			return true;
+		case OID_GEN_BYTES_XMIT:
+			*ResponseSize = sizeof(uint32_t);
+
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.BytesTransmitted;
+
+			return true;
+		case OID_GEN_BYTES_RCV:
+			*ResponseSize = sizeof(uint32_t);
+
+			*((uint32_t*)ResponseData) = RNDISInterfaceInfo->State.Statistics.BytesReceived;
+
+			return true;
 		case OID_802_3_RCV_ERROR_ALIGNMENT:
 		case OID_802_3_XMIT_ONE_COLLISION:
 		case OID_802_3_XMIT_MORE_COLLISIONS:
@@ -428,18 +477,34 @@ static bool RNDIS_Device_ProcessNDISSet(USB_ClassInfo_RNDIS_Device_t* const RNDI
                                         const void* SetData,
                                         const uint16_t SetSize)
 {
-	(void)SetSize;
-
 	switch (OId)
 	{
 		case OID_GEN_CURRENT_PACKET_FILTER:
+			if (SetSize < sizeof(uint32_t))
+			  return false;
+
 			RNDISInterfaceInfo->State.CurrPacketFilter = *((uint32_t*)SetData);
 			RNDISInterfaceInfo->State.CurrRNDISState = ((RNDISInterfaceInfo->State.CurrPacketFilter) ?
 			                                      RNDIS_Data_Initialized : RNDIS_Data_Initialized);
 
 			return true;
 		case OID_802_3_MULTICAST_LIST:
-			/* Do nothing - throw away the value from the host as it is unused */
+			if ((SetSize % sizeof(MAC_Address_t)) ||
+			    ((SetSize / sizeof(MAC_Address_t)) > RNDIS_MULTICAST_LIST_SIZE_MAX))
+			{
+				return false;
+			}
+
+			RNDISInterfaceInfo->State.MulticastHashTable[0] = 0;
+			RNDISInterfaceInfo->State.MulticastHashTable[1] = 0;
+
+			for (const MAC_Address_t* Address = (const MAC_Address_t*)SetData;
+			     Address < (const MAC_Address_t*)((const uint8_t*)SetData + SetSize); Address++)
+			{
+				uint8_t HashIndex = RNDIS_Device_GetMulticastHash(Address);
+
+				RNDISInterfaceInfo->State.MulticastHashTable[HashIndex >> 5] |= (1UL << (HashIndex & 0x1F));
+			}
 
 			return true;
 		default:
@@ -447,6 +512,51 @@ static bool RNDIS_Device_ProcessNDISSet(USB_ClassInfo_RNDIS_Device_t* const RNDI
 	}
 }
 
+static uint8_t RNDIS_Device_GetMulticastHash(const MAC_Address_t* const Address)
+{
+	uint32_t CRC32 = 0xFFFFFFFF;
+
+	for (uint8_t OctetIndex = 0; OctetIndex < sizeof(MAC_Address_t); OctetIndex++)
+	{
+		CRC32 ^= Address->Octets[OctetIndex];
+
+		for (uint8_t Bit = 0; Bit < 8; Bit++)
+		  CRC32 = (CRC32 >> 1) ^ ((CRC32 & 0x01) ? RNDIS_CRC32_POLYNOMIAL : 0);
+	}
+
+	/* Hash index is the six most significant bits of the address's Ethernet CRC32, as used by most MAC filters */
+	return (uint8_t)((~CRC32) >> (32 - RNDIS_MULTICAST_HASH_BITS));
+}
+
+static bool RNDIS_Device_IsFrameAccepted(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+                                         const MAC_Address_t* const DestinationAddress)
+{
+	uint32_t PacketFilter = RNDISInterfaceInfo->State.CurrPacketFilter;
+
+	if (PacketFilter & REMOTE_NDIS_PACKET_PROMISCUOUS)
+	  return true;
+
+	/* Individual (unicast) addresses have the group bit of the first octet cleared; on the point-to-point RNDIS link
+	   every directed frame from the host is intended for the device */
+	if (!(DestinationAddress->Octets[0] & 0x01))
+	  return (PacketFilter & REMOTE_NDIS_PACKET_DIRECTED);
+
+	static const MAC_Address_t PROGMEM BroadcastAddress = {{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+
+	if (!(memcmp_P(DestinationAddress, &BroadcastAddress, sizeof(MAC_Address_t))))
+	  return (PacketFilter & REMOTE_NDIS_PACKET_BROADCAST);
+
+	if (PacketFilter & REMOTE_NDIS_PACKET_ALL_MULTICAST)
+	  return true;
+
+	if (!(PacketFilter & REMOTE_NDIS_PACKET_MULTICAST))
+	  return false;
+
+	uint8_t HashIndex = RNDIS_Device_GetMulticastHash(DestinationAddress);
+
+	return (RNDISInterfaceInfo->State.MulticastHashTable[HashIndex >> 5] & (1UL << (HashIndex & 0x1F)));
+}
+
 bool RNDIS_Device_IsPacketReceived(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
 {
 	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
@@ -481,16 +591,78 @@ uint8_t RNDIS_Device_ReadPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfa
 
 	if (RNDISPacketHeader.DataLength > ETHERNET_FRAME_SIZE_MAX)
 	{
+		RNDISInterfaceInfo->State.Statistics.OversizeFrames++;
+
 		Endpoint_StallTransaction();
 
 		return RNDIS_ERROR_LOGICAL_CMD_FAILED;
 	}
 	
+	if (RNDISPacketHeader.DataLength < sizeof(MAC_Address_t))
+	{
+		RNDISInterfaceInfo->State.Statistics.RuntFrames++;
+
+		Endpoint_Discard_Stream(RNDISPacketHeader.DataLength, NULL);
+		Endpoint_ClearOUT();
+
+		return ENDPOINT_RWSTREAM_NoError;
+	}
+
+	/* Read only the destination address into the frame buffer, so that filtered frames are dropped without their payload
+	   being copied out of the endpoint */
+	Endpoint_Read_Stream_LE(Buffer, sizeof(MAC_Address_t), NULL);
+
+	if (!(RNDIS_Device_IsFrameAccepted(RNDISInterfaceInfo, (MAC_Address_t*)Buffer)))
+	{
+		RNDISInterfaceInfo->State.Statistics.FilterRejects++;
+
+		Endpoint_Discard_Stream(RNDISPacketHeader.DataLength - sizeof(MAC_Address_t), NULL);
+		Endpoint_ClearOUT();
+
+		return ENDPOINT_RWSTREAM_NoError;
+	}
+
 	*PacketLength = (uint16_t)RNDISPacketHeader.DataLength;
 
-	Endpoint_Read_Stream_LE(Buffer, RNDISPacketHeader.DataLength, NULL);
+	Endpoint_Read_Stream_LE((uint8_t*)Buffer + sizeof(MAC_Address_t), RNDISPacketHeader.DataLength - sizeof(MAC_Address_t), NULL);
 	Endpoint_ClearOUT();
-	
+
+	RNDISInterfaceInfo->State.Statistics.FramesReceived++;
+	RNDISInterfaceInfo->State.Statistics.BytesReceived += RNDISPacketHeader.DataLength;
+
+	return ENDPOINT_RWSTREAM_NoError;
+}
+
+uint8_t RNDIS_Device_DiscardPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
+{
+	if ((USB_DeviceState != DEVICE_STATE_Configured) ||
+	    (RNDISInterfaceInfo->State.CurrRNDISState != RNDIS_Data_Initialized))
+	{
+		return ENDPOINT_RWSTREAM_DeviceDisconnected;
+	}
+
+	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataOUTEndpointNumber);
+
+	if (!(Endpoint_IsOUTReceived()))
+		return ENDPOINT_RWSTREAM_NoError;
+
+	RNDIS_Packet_Message_t RNDISPacketHeader;
+	Endpoint_Read_Stream_LE(&RNDISPacketHeader, sizeof(RNDIS_Packet_Message_t), NULL);
+
+	if (RNDISPacketHeader.DataLength > ETHERNET_FRAME_SIZE_MAX)
+	{
+		RNDISInterfaceInfo->State.Statistics.OversizeFrames++;
+
+		Endpoint_StallTransaction();
+
+		return RNDIS_ERROR_LOGICAL_CMD_FAILED;
+	}
+
+	Endpoint_Discard_Stream(RNDISPacketHeader.DataLength, NULL);
+	Endpoint_ClearOUT();
+
+	RNDISInterfaceInfo->State.Statistics.NoBufferDrops++;
+
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
@@ -506,10 +678,21 @@ uint8_t RNDIS_Device_SendPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfa
 		return ENDPOINT_RWSTREAM_DeviceDisconnected;
 	}
 	
+	if (PacketLength > ETHERNET_FRAME_SIZE_MAX)
+	{
+		RNDISInterfaceInfo->State.Statistics.TransmitErrors++;
+
+		return RNDIS_ERROR_LOGICAL_CMD_FAILED;
+	}
+
 	Endpoint_SelectEndpoint(RNDISInterfaceInfo->Config.DataINEndpointNumber);
 
 	if ((ErrorCode = Endpoint_WaitUntilReady()) != ENDPOINT_READYWAIT_NoError)
-	  return ErrorCode;
+	{
+		RNDISInterfaceInfo->State.Statistics.TransmitErrors++;
+
+		return ErrorCode;
+	}
 
 	RNDIS_Packet_Message_t RNDISPacketHeader;
 
@@ -524,6 +707,9 @@ uint8_t RNDIS_Device_SendPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfa
 	Endpoint_Write_Stream_LE(Buffer, PacketLength, NULL);
 	Endpoint_ClearIN();
 
+	RNDISInterfaceInfo->State.Statistics.FramesTransmitted++;
+	RNDISInterfaceInfo->State.Statistics.BytesTransmitted += PacketLength;
+
 	return ENDPOINT_RWSTREAM_NoError;
 }
 
@@ -69,6 +69,26 @@
 
 	/* Public Interface - May be used in end-application: */
 		/* Type Defines: */
+			/** \brief RNDIS Class Device Mode Statistics Structure.
+			 *
+			 *  Data path counters maintained by the RNDIS device class driver, and reported to the host through the NDIS
+			 *  statistics OIDs. All counters are reset when the interface is enumerated.
+			 */
+			typedef struct
+			{
+				uint32_t FramesTransmitted; /**< Number of frames successfully sent to the host. */
+				uint32_t FramesReceived; /**< Number of frames received from the host and passed to the application. */
+				uint32_t BytesTransmitted; /**< Number of Ethernet frame bytes successfully sent to the host. */
+				uint32_t BytesReceived; /**< Number of Ethernet frame bytes received from the host and passed to the application. */
+				uint32_t TransmitErrors; /**< Number of frames which could not be sent to the host. */
+				uint32_t OversizeFrames; /**< Number of received frames dropped for being larger than \ref ETHERNET_FRAME_SIZE_MAX. */
+				uint32_t RuntFrames; /**< Number of received frames dropped for being too short to hold an Ethernet address. */
+				uint32_t FilterRejects; /**< Number of received frames discarded by the host's packet filter. */
+				uint32_t NoBufferDrops; /**< Number of received frames discarded by the application via
+				                         *   \ref RNDIS_Device_DiscardPacket() due to lack of buffer space.
+				                         */
+			} RNDIS_Device_Statistics_t;
+
 			/** \brief RNDIS Class Device Mode Configuration and State Structure.
 			 *
 			 *  Class state structure. An instance of this structure should be made for each RNDIS interface
@@ -106,6 +126,12 @@
 					bool     ResponseReady; /**< Internal flag indicating if a RNDIS message is waiting to be returned to the host. */
 					uint8_t  CurrRNDISState; /**< Current RNDIS state of the adapter, a value from the \ref RNDIS_States_t enum. */
 					uint32_t CurrPacketFilter; /**< Current packet filter mode, used internally by the class driver. */
+					uint32_t MulticastHashTable[2]; /**< 64-bit hash table of the multicast addresses accepted by the adapter,
+					                                 *   indexed by the upper six bits of each address' Ethernet CRC32.
+					                                 */
+					RNDIS_Device_Statistics_t Statistics; /**< Data path counters of the adapter, reported to the host through
+					                                       *   the NDIS statistics OIDs.
+					                                       */
 				} State; /**< State data for the USB class interface within the device. All elements in this section
 				          *   are reset to their defaults when the interface is enumerated.
 				          */
@@ -154,6 +180,10 @@
 			/** Retrieves the next pending packet from the device, discarding the remainder of the RNDIS packet header to leave
 			 *  only the packet contents for processing by the device in the nominated buffer.
 			 *
+			 *  The destination address of each frame is checked against the packet filter and multicast list set by the host
+			 *  before the frame payload is read from the endpoint. Frames rejected by the filter are discarded in their entirety
+			 *  and reported as a successful read with a \c PacketLength of zero.
+			 *
 			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
 			 *       call will fail.
 			 *
@@ -167,6 +197,19 @@
 											void* Buffer,
 											uint16_t* const PacketLength);
 
+			/** Discards the next pending packet from the host without reading its contents, for use when the application
+			 *  has no free buffer to store the packet. Packets discarded through this function are counted in the interface's
+			 *  \c RCV_NO_BUFFER statistic.
+			 *
+			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
+			 *       call will fail.
+			 *
+			 *  \param[in,out] RNDISInterfaceInfo  Pointer to a structure containing an RNDIS Class configuration and state.
+			 *
+			 *  \return A value from the \ref Endpoint_Stream_RW_ErrorCodes_t enum.
+			 */
+			uint8_t RNDIS_Device_DiscardPacket(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo) ATTR_NON_NULL_PTR_ARG(1);
+
 			/** Sends the given packet to the attached RNDIS device, after adding a RNDIS packet message header.
 			 *
 			 *  \pre This function must only be called when the Device state machine is in the \ref DEVICE_STATE_Configured state or the
@@ -184,6 +227,10 @@
 
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
+		/* Macros: */
+			#define RNDIS_MULTICAST_HASH_BITS       6
+			#define RNDIS_CRC32_POLYNOMIAL          0xEDB88320UL
+
 		/* Function Prototypes: */
 		#if defined(__INCLUDE_FROM_RNDIS_DEVICE_C)
 			static void RNDIS_Device_ProcessRNDISControlMessage(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo)
@@ -200,6 +247,11 @@
 			                                        const void* SetData,
                                                     const uint16_t SetSize) ATTR_NON_NULL_PTR_ARG(1)
 			                                        ATTR_NON_NULL_PTR_ARG(3);
+			static uint8_t RNDIS_Device_GetMulticastHash(const MAC_Address_t* const Address) ATTR_WARN_UNUSED_RESULT
+			                                             ATTR_NON_NULL_PTR_ARG(1);
+			static bool RNDIS_Device_IsFrameAccepted(USB_ClassInfo_RNDIS_Device_t* const RNDISInterfaceInfo,
+			                                         const MAC_Address_t* const DestinationAddress) ATTR_WARN_UNUSED_RESULT
+			                                         ATTR_NON_NULL_PTR_ARG(1) ATTR_NON_NULL_PTR_ARG(2);
 		#endif
 
 	#endif
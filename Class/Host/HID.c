@@ -210,7 +210,7 @@ uint8_t HID_Host_ReceiveReportByID(USB_ClassInfo_HID_Host_t* const HIDInterfaceI
 		.bRequest      = HID_REQ_SetReport,
 		.wValue        = ((HID_REPORT_ITEM_In + 1) << 8) | ReportID,
 		.wIndex        = HIDInterfaceInfo->State.InterfaceNumber,
-		.wLength       = USB_GetHIDReportSize(HIDInterfaceInfo->Config.HIDParserData, ReportID, HID_REPORT_ITEM_In),
+		.wLength       = USB_GetHIDReportSize(&HIDInterfaceInfo->Config.HIDParserData->View, ReportID, HID_REPORT_ITEM_In),
 	};
 
 	Pipe_SelectPipe(PIPE_CONTROLPIPE);
@@ -244,7 +244,7 @@ uint8_t HID_Host_ReceiveReport(USB_ClassInfo_HID_Host_t* const HIDInterfaceInfo,
 			*(BufferPos++) = ReportID;
 		}
 
-		ReportSize = USB_GetHIDReportSize(HIDInterfaceInfo->Config.HIDParserData, ReportID, HID_REPORT_ITEM_In);
+		ReportSize = USB_GetHIDReportSize(&HIDInterfaceInfo->Config.HIDParserData->View, ReportID, HID_REPORT_ITEM_In);
 	}
 	else
 #endif
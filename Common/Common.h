@@ -120,6 +120,11 @@
 			#define ARCH_LITTLE_ENDIAN
 
 			#include "Endianness.h"
+
+			/* Host builds of the USB driver run against a simulated controller, which also supplies the interrupt mask */
+			#if defined(LPC13XX_HOST_SIMULATION)
+				#include "lpc134x.h"
+			#endif
 		#else
 			#error Unknown device architecture specified.
 		#endif
@@ -335,8 +340,12 @@
 				return SREG;
 				#elif (ARCH == ARCH_UC3)
 				return __builtin_mfsr(AVR32_SR);
+				#elif (ARCH == ARCH_LPC13xx) && defined(LPC13XX_HOST_SIMULATION)
+				return __get_PRIMASK();
 				#elif (ARCH == ARCH_LPC13xx)
-				return 0;
+				uint_reg_t PriMask;
+				__asm__ __volatile__ ("mrs %0, primask" : "=r" (PriMask) :: "memory");
+				return PriMask;
 				#endif
 
 				GCC_MEMORY_BARRIER();
@@ -362,6 +371,10 @@
 				  __builtin_ssrf(AVR32_SR_GM_OFFSET);
 				else
 				  __builtin_csrf(AVR32_SR_GM_OFFSET);
+				#elif (ARCH == ARCH_LPC13xx) && defined(LPC13XX_HOST_SIMULATION)
+				__set_PRIMASK(GlobalIntState);
+				#elif (ARCH == ARCH_LPC13xx)
+				__asm__ __volatile__ ("msr primask, %0" :: "r" (GlobalIntState) : "memory");
 				#endif
 				
 				GCC_MEMORY_BARRIER();
@@ -380,6 +393,10 @@
 				sei();
 				#elif (ARCH == ARCH_UC3)
 				__builtin_csrf(AVR32_SR_GM_OFFSET);
+				#elif (ARCH == ARCH_LPC13xx) && defined(LPC13XX_HOST_SIMULATION)
+				__enable_irq();
+				#elif (ARCH == ARCH_LPC13xx)
+				__asm__ __volatile__ ("cpsie i" ::: "memory");
 				#endif
 
 				GCC_MEMORY_BARRIER();
@@ -398,6 +415,10 @@
 				cli();
 				#elif (ARCH == ARCH_UC3)
 				__builtin_ssrf(AVR32_SR_GM_OFFSET);
+				#elif (ARCH == ARCH_LPC13xx) && defined(LPC13XX_HOST_SIMULATION)
+				__disable_irq();
+				#elif (ARCH == ARCH_LPC13xx)
+				__asm__ __volatile__ ("cpsid i" ::: "memory");
 				#endif
 
 				GCC_MEMORY_BARRIER();
@@ -46,6 +46,110 @@ bool    USB_CurrentlySelfPowered;
 bool    USB_RemoteWakeupEnabled;
 #endif
 
+#if defined(USB_DEVICE_PROFILE)
+USB_Device_Profile_t USB_Device_Profile;
+
+void USB_Device_ResetProfile(void)
+{
+	memset(&USB_Device_Profile, 0x00, sizeof(USB_Device_Profile));
+}
+
+void USB_Device_RecordProfile(const uint8_t Phase,
+                              const uint32_t StartTicks,
+                              const uint32_t StartSIECommands)
+{
+	USB_Device_ProfilePhase_t* ProfilePhase = &USB_Device_Profile.Phases[Phase];
+	uint32_t ElapsedTicks = (USB_DEVICE_PROFILE_TICKS() - StartTicks);
+
+	ProfilePhase->Calls++;
+	ProfilePhase->TotalTicks  += ElapsedTicks;
+	ProfilePhase->SIECommands += (USB_Device_SIECommands - StartSIECommands);
+
+	if (ElapsedTicks > ProfilePhase->MaxTicks)
+	  ProfilePhase->MaxTicks = ElapsedTicks;
+}
+#endif
+
+#if !defined(NO_INTERNAL_SERIAL) && (USE_INTERNAL_SERIAL != NO_DESCRIPTOR)
+static struct
+{
+	USB_Descriptor_Header_t Header;
+	uint16_t                UnicodeString[INTERNAL_SERIAL_LENGTH_BITS / 4];
+} USB_Device_InternalSerialDescriptor ATTR_ALIGNED(4);
+
+void USB_Device_LoadInternalSerial(void)
+{
+	USB_Device_InternalSerialDescriptor.Header.Type = DTYPE_String;
+	USB_Device_InternalSerialDescriptor.Header.Size = USB_STRING_LEN(INTERNAL_SERIAL_LENGTH_BITS / 4);
+
+	USB_Device_GetSerialString(USB_Device_InternalSerialDescriptor.UnicodeString);
+}
+#endif
+
+#if defined(USE_DESCRIPTOR_TABLE)
+static const USB_Descriptor_Table_t* USB_Device_DescriptorTable;
+
+void USB_Device_RegisterDescriptorTable(const USB_Descriptor_Table_t* const Table)
+{
+	USB_Device_DescriptorTable = Table;
+
+	#if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
+	if ((Table != NULL) && (Table->Device.Address != NULL))
+	  USB_ControlEndpointSize = ((const USB_Descriptor_Device_t*)Table->Device.Address)->Endpoint0Size;
+	#endif
+}
+
+uint16_t USB_Device_FindDescriptor(const uint16_t wValue,
+                                   const uint16_t wIndex,
+                                   const void** const DescriptorAddress)
+{
+	const USB_Descriptor_Table_t*      Table = USB_Device_DescriptorTable;
+	const USB_Descriptor_TableEntry_t* Entry = NULL;
+	uint8_t DescriptorIndex = (wValue & 0xFF);
+
+	if (Table != NULL)
+	{
+		switch (wValue >> 8)
+		{
+			case DTYPE_Device:
+				Entry = &Table->Device;
+				break;
+			case DTYPE_Configuration:
+				if (DescriptorIndex < Table->TotalConfigurations)
+				  Entry = &Table->Configurations[DescriptorIndex];
+
+				break;
+			case DTYPE_String:
+				if (DescriptorIndex >= Table->TotalStrings)
+				  break;
+
+				if (DescriptorIndex == 0)
+				{
+					Entry = &Table->Strings[0];
+					break;
+				}
+
+				for (uint8_t LanguageIndex = 0; LanguageIndex < Table->TotalLanguages; LanguageIndex++)
+				{
+					if (Table->LanguageIDs[LanguageIndex] == wIndex)
+					{
+						Entry = &Table->Strings[(LanguageIndex * Table->TotalStrings) + DescriptorIndex];
+						break;
+					}
+				}
+
+				break;
+		}
+	}
+
+	if ((Entry == NULL) || (Entry->Address == NULL))
+	  return CALLBACK_USB_GetDescriptor(wValue, wIndex, DescriptorAddress);
+
+	*DescriptorAddress = Entry->Address;
+	return Entry->Size;
+}
+#endif
+
 void USB_Device_ProcessControlRequest(void)
 {
 
@@ -57,16 +161,21 @@ void USB_Device_ProcessControlRequest(void)
 	USB_ControlRequest.wLength       = Endpoint_Read_16_LE();
 #else
 	Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
-	Endpoint_prepare_read();
 	Endpoint_Read_buf(&USB_ControlRequest, sizeof(USB_ControlRequest));
 #endif
 
+	USB_DEVICE_PROFILE_DECLARE();
+
+	USB_DEVICE_PROFILE_START();
 	EVENT_USB_Device_ControlRequest();
+	USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_ControlRequestEvent);
 
 	if (Endpoint_IsSETUPReceived())
 	{
 		uint8_t bmRequestType = USB_ControlRequest.bmRequestType;
 
+		USB_DEVICE_PROFILE_START();
+
 		switch (USB_ControlRequest.bRequest)
 		{
 			case REQ_GetStatus:
@@ -74,6 +183,7 @@ void USB_Device_ProcessControlRequest(void)
 					(bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_ENDPOINT)))
 				{
 					USB_Device_GetStatus();
+					USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_OtherStandardRequest);
 				}
 
 				break;
@@ -83,12 +193,16 @@ void USB_Device_ProcessControlRequest(void)
 					(bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_ENDPOINT)))
 				{
 					USB_Device_ClearSetFeature();
+					USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_OtherStandardRequest);
 				}
 
 				break;
 			case REQ_SetAddress:
 				if (bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE))
-				  USB_Device_SetAddress();
+				{
+					USB_Device_SetAddress();
+					USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_SetAddress);
+				}
 
 				break;
 			case REQ_GetDescriptor:
@@ -96,17 +210,24 @@ void USB_Device_ProcessControlRequest(void)
 					(bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_INTERFACE)))
 				{
 					USB_Device_GetDescriptor();
+					USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_GetDescriptor);
 				}
 
 				break;
 			case REQ_GetConfiguration:
 				if (bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE))
-				  USB_Device_GetConfiguration();
+				{
+					USB_Device_GetConfiguration();
+					USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_OtherStandardRequest);
+				}
 
 				break;
 			case REQ_SetConfiguration:
 				if (bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE))
-				  USB_Device_SetConfiguration();
+				{
+					USB_Device_SetConfiguration();
+					USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_SetConfiguration);
+				}
 
 				break;
 		}
@@ -127,7 +248,6 @@ static void USB_Device_SetAddress(void)
 				
 	Endpoint_ClearSETUP();
 	
-	Endpoint_prepare_write(0);
 	Endpoint_complete_write();
 	//Endpoint_ClearStatusStage();
 
@@ -159,6 +279,10 @@ static void USB_Device_SetConfiguration(void)
 		#endif
 	#endif
 	
+	#if defined(USE_DESCRIPTOR_TABLE)
+	if (USB_Device_FindDescriptor((DTYPE_Device << 8), 0, (void*)&DevDescriptorPtr) == NO_DESCRIPTOR)
+	  return;
+	#else
 	if (CALLBACK_USB_GetDescriptor((DTYPE_Device << 8), 0, (void*)&DevDescriptorPtr
 	#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) && \
 	    !(defined(USE_FLASH_DESCRIPTORS) || defined(USE_EEPROM_DESCRIPTORS) || defined(USE_RAM_DESCRIPTORS))
@@ -168,6 +292,7 @@ static void USB_Device_SetConfiguration(void)
 	{
 		return;
 	}
+	#endif
 
 	#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE)
 	if (MemoryAddressSpace == MEMSPACE_FLASH)
@@ -196,7 +321,6 @@ static void USB_Device_SetConfiguration(void)
 	USB_ConfigurationNumber = (uint8_t)USB_ControlRequest.wValue;
 
 	//Endpoint_ClearStatusStage();
-	Endpoint_prepare_write(0);
 	Endpoint_complete_write();
 	WriteCommandData(CMD_CFG_DEV, DAT_WR_BYTE(1));
 
@@ -205,6 +329,11 @@ static void USB_Device_SetConfiguration(void)
 	else
 	  USB_DeviceState = (USB_Device_IsAddressSet()) ? DEVICE_STATE_Configured : DEVICE_STATE_Powered;
 
+	#if defined(USB_DEVICE_PROFILE)
+	if (USB_ConfigurationNumber)
+	  USB_Device_Profile.EnumerationTicks = (USB_DEVICE_PROFILE_TICKS() - USB_Device_Profile.BusResetTicks);
+	#endif
+
 	EVENT_USB_Device_ConfigurationChanged();
 }
 
@@ -221,20 +350,14 @@ static void USB_Device_GetConfiguration(void)
 #if !defined(NO_INTERNAL_SERIAL) && (USE_INTERNAL_SERIAL != NO_DESCRIPTOR)
 static void USB_Device_GetInternalSerialDescriptor(void)
 {
-	struct
-	{
-		USB_Descriptor_Header_t Header;
-		uint16_t                UnicodeString[INTERNAL_SERIAL_LENGTH_BITS / 4];
-	} SignatureDescriptor;
-
-	SignatureDescriptor.Header.Type = DTYPE_String;
-	SignatureDescriptor.Header.Size = USB_STRING_LEN(INTERNAL_SERIAL_LENGTH_BITS / 4);
-	
-	USB_Device_GetSerialString(SignatureDescriptor.UnicodeString);
-
 	Endpoint_ClearSETUP();
 
-	Endpoint_Write_Control_Stream_LE(&SignatureDescriptor, sizeof(SignatureDescriptor));
+	/* Served from the descriptor built once at initialization, which outlives any interrupt driven data stage */
+	#if defined(INTERRUPT_CONTROL_ENDPOINT)
+	Endpoint_StartControlWrite(&USB_Device_InternalSerialDescriptor, sizeof(USB_Device_InternalSerialDescriptor));
+	#else
+	Endpoint_Write_Control_Stream_LE(&USB_Device_InternalSerialDescriptor, sizeof(USB_Device_InternalSerialDescriptor));
+	#endif
 	Endpoint_ClearOUT();
 }
 #endif
@@ -257,6 +380,13 @@ static void USB_Device_GetDescriptor(void)
 	}
 	#endif
 
+	#if defined(USE_DESCRIPTOR_TABLE)
+	if ((DescriptorSize = USB_Device_FindDescriptor(USB_ControlRequest.wValue, USB_ControlRequest.wIndex,
+	                                                &DescriptorPointer)) == NO_DESCRIPTOR)
+	{
+		return;
+	}
+	#else
 	if ((DescriptorSize = CALLBACK_USB_GetDescriptor(USB_ControlRequest.wValue, USB_ControlRequest.wIndex,
 	                                                 &DescriptorPointer
 	#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) && \
@@ -267,17 +397,18 @@ static void USB_Device_GetDescriptor(void)
 	{
 		return;
 	}
+	#endif
 
 	Endpoint_ClearSETUP();
 	
 	if (DescriptorSize > USB_ControlRequest.wLength)
 	  DescriptorSize = USB_ControlRequest.wLength;
 	
-	Endpoint_prepare_write(DescriptorSize);
-	Endpoint_write_buf(DescriptorPointer, DescriptorSize);
-
-	#if defined(USE_RAM_DESCRIPTORS) || !defined(ARCH_HAS_MULTI_ADDRESS_SPACE)
-	//Endpoint_Write_Control_Stream_LE(DescriptorPointer, DescriptorSize);
+	#if defined(INTERRUPT_CONTROL_ENDPOINT)
+	/* Descriptors are constant for the life of the device, so are sent in place rather than copied */
+	Endpoint_StartControlWrite(DescriptorPointer, DescriptorSize);
+	#elif defined(USE_RAM_DESCRIPTORS) || !defined(ARCH_HAS_MULTI_ADDRESS_SPACE)
+	Endpoint_Write_Control_Stream_LE(DescriptorPointer, DescriptorSize);
 	#elif defined(USE_EEPROM_DESCRIPTORS)
 	Endpoint_Write_Control_EStream_LE(DescriptorPointer, DescriptorSize);
 	#elif defined(USE_FLASH_DESCRIPTORS)
@@ -291,7 +422,7 @@ static void USB_Device_GetDescriptor(void)
 	  Endpoint_Write_Control_Stream_LE(DescriptorPointer, DescriptorSize);
 	#endif
 
-	Endpoint_ClearIN();
+	Endpoint_ClearOUT();
 }
 
 static void USB_Device_GetStatus(void)
@@ -61,7 +61,52 @@
 		#endif
 
 	/* Public Interface - May be used in end-application: */
+		/* Macros: */
+			#if defined(USB_DEVICE_PROFILE) || defined(__DOXYGEN__)
+				#if !defined(USB_DEVICE_PROFILE_TICKS) || defined(__DOXYGEN__)
+					/** Expression returning a free running, up counting 32-bit tick count, used to time each phase of device
+					 *  bring-up and control request processing when the \c USB_DEVICE_PROFILE token is defined. By default
+					 *  this is the architecture's device tick source, \ref USB_DEVICE_TICKS(). This may be overridden
+					 *  in the user project makefile by passing the \c USB_DEVICE_PROFILE_TICKS() token to the compiler via the
+					 *  -D switch, along with \ref USB_DEVICE_PROFILE_INIT(), to use an application timer instead.
+					 *
+					 *  \ingroup Group_Device
+					 */
+					#define USB_DEVICE_PROFILE_TICKS()   USB_DEVICE_TICKS()
+
+					/** Statement starting the tick source of \ref USB_DEVICE_PROFILE_TICKS(), executed at the start of
+					 *  \ref USB_Init(). By default this starts the architecture's device tick source via
+					 *  \ref USB_DEVICE_TICKS_INIT().
+					 *
+					 *  \ingroup Group_Device
+					 */
+					#define USB_DEVICE_PROFILE_INIT()    USB_DEVICE_TICKS_INIT()
+				#endif
+			#endif
+
 		/* Enums: */
+			#if defined(USB_DEVICE_PROFILE) || defined(__DOXYGEN__)
+				/** Enum for the phases of device bring-up timed by the \c USB_DEVICE_PROFILE build option, used to index
+				 *  the \c Phases array of \ref USB_Device_Profile.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				enum USB_Device_ProfilePhases_t
+				{
+					USB_DEVICE_PROFILE_InitDevice           = 0, /**< Device mode initialization within \ref USB_Init(). */
+					USB_DEVICE_PROFILE_ControlRequestEvent  = 1, /**< The application's \ref EVENT_USB_Device_ControlRequest()
+					                                              *   event, including any class driver request handlers.
+					                                              */
+					USB_DEVICE_PROFILE_SetAddress           = 2, /**< Standard SET_ADDRESS request processing. */
+					USB_DEVICE_PROFILE_GetDescriptor        = 3, /**< Standard GET_DESCRIPTOR request processing. */
+					USB_DEVICE_PROFILE_SetConfiguration     = 4, /**< Standard SET_CONFIGURATION request processing, including
+					                                              *   the \ref EVENT_USB_Device_ConfigurationChanged() event.
+					                                              */
+					USB_DEVICE_PROFILE_OtherStandardRequest = 5, /**< All other standard request processing. */
+					USB_DEVICE_PROFILE_TOTAL_PHASES         = 6, /**< Total number of profiled phases. */
+				};
+			#endif
+
 			#if defined(ARCH_HAS_MULTI_ADDRESS_SPACE) || defined(__DOXYGEN__)
 				/** Enum for the possible descriptor memory spaces, for the \c MemoryAddressSpace parameter of the
 				 *  \ref CALLBACK_USB_GetDescriptor() function. This can be used when none of the \c USE_*_DESCRIPTORS
@@ -81,6 +126,79 @@
 				};
 			#endif
 
+		/* Type Defines: */
+			#if defined(USE_DESCRIPTOR_TABLE) || defined(__DOXYGEN__)
+				/** \brief Descriptor Table Entry.
+				 *
+				 *  Type define for a single descriptor within a \ref USB_Descriptor_Table_t descriptor table.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				typedef struct
+				{
+					const void* Address; /**< Pointer to the descriptor in memory, or \c NULL if the descriptor is not present. */
+					uint16_t    Size; /**< Size of the descriptor in bytes. */
+				} USB_Descriptor_TableEntry_t;
+
+				/** \brief Static Descriptor Table.
+				 *
+				 *  Type define for a table of the device's standard descriptors, registered with the library via
+				 *  \ref USB_Device_RegisterDescriptorTable() so that GET_DESCRIPTOR requests for them are served by direct
+				 *  indexing rather than by calls to \ref CALLBACK_USB_GetDescriptor(). String descriptors are stored as one
+				 *  row of \c TotalStrings entries per language, in the order of the \c LanguageIDs array; string index zero,
+				 *  the supported language list, is always taken from the first row.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				typedef struct
+				{
+					USB_Descriptor_TableEntry_t        Device; /**< Device descriptor. */
+					const USB_Descriptor_TableEntry_t* Configurations; /**< Configuration descriptors, indexed by descriptor index. */
+					uint8_t                            TotalConfigurations; /**< Number of entries in the \c Configurations array. */
+					const USB_Descriptor_TableEntry_t* Strings; /**< String descriptors, one row per language, indexed by
+					                                             *   string index within each row.
+					                                             */
+					uint8_t                            TotalStrings; /**< Number of string descriptors in each language row. */
+					const uint16_t*                    LanguageIDs; /**< Language ID of each row of the \c Strings array. */
+					uint8_t                            TotalLanguages; /**< Number of entries in the \c LanguageIDs array. */
+				} USB_Descriptor_Table_t;
+			#endif
+
+			#if defined(USB_DEVICE_PROFILE) || defined(__DOXYGEN__)
+				/** \brief Device Bring-Up Profile Phase.
+				 *
+				 *  Type define for the accumulated cost of one phase of device bring-up, as recorded by the
+				 *  \c USB_DEVICE_PROFILE build option.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				typedef struct
+				{
+					uint32_t Calls; /**< Number of times the phase has run. */
+					uint32_t TotalTicks; /**< Total \ref USB_DEVICE_PROFILE_TICKS() ticks spent in the phase. */
+					uint32_t MaxTicks; /**< Longest single run of the phase, in ticks. */
+					uint32_t SIECommands; /**< Total number of USB controller SIE commands issued during the phase. */
+				} USB_Device_ProfilePhase_t;
+
+				/** \brief Device Bring-Up Profile.
+				 *
+				 *  Type define for the enumeration latency profile recorded by the \c USB_DEVICE_PROFILE build option. Builds
+				 *  using different configurations, such as \c USE_DESCRIPTOR_TABLE or \c FIXED_CONTROL_ENDPOINT_SIZE, can be
+				 *  compared by enumerating each against the same host and reading back this profile.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				typedef struct
+				{
+					USB_Device_ProfilePhase_t Phases[USB_DEVICE_PROFILE_TOTAL_PHASES]; /**< Cost of each phase, indexed by a value
+					                                                                   *   from the \ref USB_Device_ProfilePhases_t
+					                                                                   *   enum.
+					                                                                   */
+					uint32_t BusResetTicks; /**< Tick count latched at the most recent USB bus reset. */
+					uint32_t EnumerationTicks; /**< Ticks from the most recent bus reset until the device was configured. */
+				} USB_Device_Profile_t;
+			#endif
+
 		/* Global Variables: */
 			/** Indicates the currently set configuration number of the device. USB devices may have several
 			 *  different configurations which the host can select between; this indicates the currently selected
@@ -121,6 +239,56 @@
 				extern bool USB_CurrentlySelfPowered;
 			#endif
 
+			#if defined(USB_DEVICE_PROFILE) || defined(__DOXYGEN__)
+				/** Enumeration latency profile of the device, accumulated since start-up or the last call to
+				 *  \ref USB_Device_ResetProfile(). This is only available when the \c USB_DEVICE_PROFILE token is defined
+				 *  in the project makefile and passed to the compiler via the -D switch.
+				 *
+				 *  \note This variable should be treated as read-only in the user application, and never manually
+				 *        changed in value.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				extern USB_Device_Profile_t USB_Device_Profile;
+
+				/** Running count of the SIE commands issued to the USB controller, used to attribute controller accesses to
+				 *  each profiled phase. This is only available when the \c USB_DEVICE_PROFILE token is defined.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				extern volatile uint32_t USB_Device_SIECommands;
+			#endif
+
+		/* Function Prototypes: */
+			#if defined(USE_DESCRIPTOR_TABLE) || defined(__DOXYGEN__)
+				/** Registers a static table of the device's standard descriptors with the library. Once registered, requests
+				 *  for the device, configuration and string descriptors held in the table are answered in constant time
+				 *  without calling \ref CALLBACK_USB_GetDescriptor(), which is then only consulted for descriptors absent
+				 *  from the table, such as class specific descriptors. The control endpoint size is taken from the table's
+				 *  device descriptor at registration, so this should be called before \ref USB_Init().
+				 *
+				 *  \note This function is only available when the \c USE_DESCRIPTOR_TABLE token is defined in the project
+				 *        makefile and passed to the compiler via the -D switch. The table, and the descriptors it points
+				 *        to, must remain valid for as long as the USB interface is in use.
+				 *
+				 *  \param[in] Table  Pointer to the descriptor table to register, or \c NULL to revert to the descriptor callback.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				void USB_Device_RegisterDescriptorTable(const USB_Descriptor_Table_t* const Table);
+			#endif
+
+			#if defined(USB_DEVICE_PROFILE) || defined(__DOXYGEN__)
+				/** Clears the accumulated \ref USB_Device_Profile, so that a subsequent enumeration can be measured on its own.
+				 *
+				 *  \note This function is only available when the \c USB_DEVICE_PROFILE token is defined in the project
+				 *        makefile and passed to the compiler via the -D switch.
+				 *
+				 *  \ingroup Group_Device
+				 */
+				void USB_Device_ResetProfile(void);
+			#endif
+
 	/* Private Interface - For use in library only: */
 	#if !defined(__DOXYGEN__)
 		#if defined(USE_RAM_DESCRIPTORS) && defined(USE_EEPROM_DESCRIPTORS)
@@ -133,9 +301,41 @@
 			#error Only one of the USE_*_DESCRIPTORS modes should be selected.
 		#endif
 
+		#if defined(USE_DESCRIPTOR_TABLE) && defined(ARCH_HAS_MULTI_ADDRESS_SPACE)
+			#error USE_DESCRIPTOR_TABLE is only supported on architectures with a unified address space.
+		#endif
+
+		/* Macros: */
+			#if defined(USB_DEVICE_PROFILE)
+				#define USB_DEVICE_PROFILE_DECLARE()    uint32_t ProfileStartTicks, ProfileStartSIECommands
+				#define USB_DEVICE_PROFILE_START()      MACROS{ ProfileStartTicks       = USB_DEVICE_PROFILE_TICKS(); \
+				                                                ProfileStartSIECommands = USB_Device_SIECommands;     }MACROE
+				#define USB_DEVICE_PROFILE_STOP(Phase)  USB_Device_RecordProfile((Phase), ProfileStartTicks, ProfileStartSIECommands)
+			#else
+				#define USB_DEVICE_PROFILE_DECLARE()
+				#define USB_DEVICE_PROFILE_START()
+				#define USB_DEVICE_PROFILE_STOP(Phase)
+			#endif
+
 		/* Function Prototypes: */
 			void USB_Device_ProcessControlRequest(void);
 
+			#if defined(USB_DEVICE_PROFILE)
+				void USB_Device_RecordProfile(const uint8_t Phase,
+				                              const uint32_t StartTicks,
+				                              const uint32_t StartSIECommands);
+			#endif
+
+			#if !defined(NO_INTERNAL_SERIAL) && (USE_INTERNAL_SERIAL != NO_DESCRIPTOR)
+				void USB_Device_LoadInternalSerial(void);
+			#endif
+
+			#if defined(USE_DESCRIPTOR_TABLE)
+				uint16_t USB_Device_FindDescriptor(const uint16_t wValue,
+				                                   const uint16_t wIndex,
+				                                   const void** const DescriptorAddress) ATTR_NON_NULL_PTR_ARG(3);
+			#endif
+
 			#if defined(__INCLUDE_FROM_DEVICESTDREQ_C)
 				static void USB_Device_SetAddress(void);
 				static void USB_Device_SetConfiguration(void);
@@ -200,41 +200,62 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 
 #endif
 
+#if defined(INTERRUPT_CONTROL_ENDPOINT)
+static uint8_t Endpoint_Write_Control_Stream_LE_Polled(const void* const Buffer,
+                                                       uint16_t Length);
+
+uint8_t Endpoint_Write_Control_Stream_LE(const void* const Buffer,
+                                         uint16_t Length)
+{
+	/* Data stages too long for the driver's copy are sent before returning, as the caller's buffer may not outlive them */
+	if (!(Endpoint_StartBufferedControlWrite(Buffer, Length)))
+	  return Endpoint_Write_Control_Stream_LE_Polled(Buffer, Length);
+
+	return ENDPOINT_RWCSTREAM_NoError;
+}
+
+#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_LE_Polled
+#define  TEMPLATE_BUFFER_OFFSET(Length)            0
+#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
+#define  TEMPLATE_TRANSFER_PACKET(BufferPtr, Size) Endpoint_write_buf(BufferPtr, Size)
+#include "Template/Template_Endpoint_Control_W.c"
+#else
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_LE
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
-#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(*BufferPtr)
+#define  TEMPLATE_TRANSFER_PACKET(BufferPtr, Size) Endpoint_write_buf(BufferPtr, Size)
 #include "Template/Template_Endpoint_Control_W.c"
+#endif
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_Stream_BE
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr -= Amount
-#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(*BufferPtr)
+#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *BufferPtr
 #include "Template/Template_Endpoint_Control_W.c"
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Control_Stream_LE
 #define  TEMPLATE_BUFFER_OFFSET(Length)            0
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
-#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *BufferPtr = Endpoint_Read_8()
+#define  TEMPLATE_TRANSFER_BYTE(BufferPtr, Byte)   *BufferPtr = Byte
 #include "Template/Template_Endpoint_Control_R.c"
 
 #define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Control_Stream_BE
 #define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 #define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr -= Amount
-#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         *BufferPtr = Endpoint_Read_8()
+#define  TEMPLATE_TRANSFER_BYTE(BufferPtr, Byte)   *BufferPtr = Byte
 #include "Template/Template_Endpoint_Control_R.c"
 
 #if defined(ARCH_HAS_FLASH_ADDRESS_SPACE)
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_PStream_LE
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            0
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
-	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(pgm_read_byte(BufferPtr))
+	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         pgm_read_byte(BufferPtr)
 	#include "Template/Template_Endpoint_Control_W.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_PStream_BE
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr -= Amount
-	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(pgm_read_byte(BufferPtr))
+	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         pgm_read_byte(BufferPtr)
 	#include "Template/Template_Endpoint_Control_W.c"
 #endif
 
@@ -242,26 +263,26 @@ uint8_t Endpoint_Null_Stream(uint16_t Length,
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_EStream_LE
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            0
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
-	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(eeprom_read_byte(BufferPtr))
+	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_read_byte(BufferPtr)
 	#include "Template/Template_Endpoint_Control_W.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Write_Control_EStream_BE
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr -= Amount
-	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         Endpoint_Write_8(eeprom_read_byte(BufferPtr))
+	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_read_byte(BufferPtr)
 	#include "Template/Template_Endpoint_Control_W.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Control_EStream_LE
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            0
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr += Amount
-	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_update_byte(BufferPtr, Endpoint_Read_8())
+	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr, Byte)   eeprom_update_byte(BufferPtr, Byte)
 	#include "Template/Template_Endpoint_Control_R.c"
 
 	#define  TEMPLATE_FUNC_NAME                        Endpoint_Read_Control_EStream_BE
 	#define  TEMPLATE_BUFFER_OFFSET(Length)            (Length - 1)
 	#define  TEMPLATE_BUFFER_MOVE(BufferPtr, Amount)   BufferPtr -= Amount
-	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr)         eeprom_update_byte(BufferPtr, Endpoint_Read_8())
+	#define  TEMPLATE_TRANSFER_BYTE(BufferPtr, Byte)   eeprom_update_byte(BufferPtr, Byte)
 	#include "Template/Template_Endpoint_Control_R.c"
 #endif
 
-#endif
+#endif
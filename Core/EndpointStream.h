@@ -385,6 +385,13 @@
 			 *        \n\n
 			 *
 			 *  \note This routine should only be used on CONTROL type endpoints.
+			 *        \n\n
+			 *
+			 *  \note When the \c INTERRUPT_CONTROL_ENDPOINT token is defined, this function sends only the first packet and
+			 *        returns immediately; the remaining packets are sent from the control endpoint interrupt as the host
+			 *        acknowledges each one, out of a driver owned copy of the data. Data longer than
+			 *        \ref INTERRUPT_CONTROL_BUFFER_SIZE is instead sent in full before returning, so the buffer may safely
+			 *        be local to the caller in either case.
 			 *
 			 *  \warning Unlike the standard stream read/write commands, the control stream commands cannot be chained
 			 *           together; i.e. the entire stream data must be read or written at the one time.
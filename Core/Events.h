@@ -319,6 +319,34 @@
 			 *        \ref Group_USBManagement documentation).
 			 */
 			void EVENT_USB_Device_StartOfFrame(void);
+
+			/** Event for a packet received on a device OUT endpoint other than the control endpoint. This event fires from the
+			 *  USB interrupt as soon as the packet has arrived, and may be used to read the packet immediately rather than
+			 *  waiting for the main program loop to poll the endpoint. The driver holds off the USB interrupt while the main
+			 *  program is part way through reading or writing a packet, and restores the main program's selected endpoint
+			 *  once the interrupt's events have run, so handlers may freely select and transfer on other endpoints.
+			 *
+			 *  This event is time-critical; it is run from within the USB interrupt and thus long handlers will significantly
+			 *  degrade device performance.
+			 *
+			 *  \param[in] EndpointNumber  Number of the OUT endpoint which has received a packet.
+			 *
+			 *  \note This event does not exist if the \c USB_HOST_ONLY token is supplied to the compiler (see
+			 *        \ref Group_USBManagement documentation).
+			 */
+			void EVENT_USB_Device_EndpointOUTReceived(const uint8_t EndpointNumber);
+
+			/** Event for the delivery of a wake event queued by \ref USB_Device_QueueWakeEvent(). This event fires from the
+			 *  caller of \ref USB_Device_QueueWakeEvent() when the bus is active, or from the USB interrupt straight after
+			 *  \ref EVENT_USB_Device_WakeUp() for events queued while the bus was suspended, so that the host is sent the
+			 *  input which woke it as soon as possible.
+			 *
+			 *  \param[in] WakeEvent  Application defined event code passed to \ref USB_Device_QueueWakeEvent().
+			 *
+			 *  \note This event does not exist if the \c USB_HOST_ONLY or \c NO_DEVICE_REMOTE_WAKEUP tokens are supplied
+			 *        to the compiler (see \ref Group_USBManagement documentation).
+			 */
+			void EVENT_USB_Device_WakeEvent(const uint8_t WakeEvent);
 		#endif
 
 	/* Private Interface - For use in library only: */
@@ -351,6 +379,11 @@
 					void EVENT_USB_Device_WakeUp(void) ATTR_WEAK ATTR_ALIAS(USB_Event_Stub);
 					void EVENT_USB_Device_Reset(void) ATTR_WEAK ATTR_ALIAS(USB_Event_Stub);
 					void EVENT_USB_Device_StartOfFrame(void) ATTR_WEAK ATTR_ALIAS(USB_Event_Stub);
+					void EVENT_USB_Device_EndpointOUTReceived(const uint8_t EndpointNumber) ATTR_WEAK ATTR_ALIAS(USB_Event_Stub);
+
+					#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+						void EVENT_USB_Device_WakeEvent(const uint8_t WakeEvent) ATTR_WEAK ATTR_ALIAS(USB_Event_Stub);
+					#endif
 				#endif
 			#endif
 	#endif
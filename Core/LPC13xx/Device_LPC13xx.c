@@ -29,6 +29,7 @@
 */
 
 #define  __INCLUDE_FROM_USB_DRIVER
+#define  __INCLUDE_FROM_DEVICE_LPC13XX_C
 #include "../USBMode.h"
 
 #if defined(USB_CAN_BE_DEVICE)
@@ -37,10 +38,160 @@
 
 uint8_t USB_address;
 
+#if defined(USB_DEVICE_PROFILE)
+volatile uint32_t USB_Device_SIECommands;
+#endif
+
+#if !defined(NO_INTERNAL_SERIAL)
+void USB_Device_GetSerialString(uint16_t* const UnicodeString)
+{
+	uint32_t   IAPCommand[5] = {IAP_CMD_READ_UID};
+	uint32_t   IAPResult[5];
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+
+	GlobalInterruptDisable();
+	((IAP_Entry_t)IAP_LOCATION)(IAPCommand, IAPResult);
+	SetGlobalInterruptMask(CurrentGlobalInt);
+
+	/* The unique ID words follow the status word, and are formatted most significant digit first */
+	for (uint8_t DigitIndex = 0; DigitIndex < (INTERNAL_SERIAL_LENGTH_BITS / 4); DigitIndex++)
+	{
+		uint8_t  UIDDigit = ((128 - INTERNAL_SERIAL_LENGTH_BITS) / 4) + DigitIndex;
+		uint8_t  Nibble   = ((IAPResult[1 + (UIDDigit / 8)] >> (28 - ((UIDDigit % 8) * 4))) & 0x0F);
+
+		#if defined(INTERNAL_SERIAL_LOWERCASE)
+		UnicodeString[DigitIndex] = ((Nibble >= 10) ? ('a' - 10) : '0') + Nibble;
+		#else
+		UnicodeString[DigitIndex] = ((Nibble >= 10) ? ('A' - 10) : '0') + Nibble;
+		#endif
+	}
+}
+#endif
+
+#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+volatile uint32_t USB_Device_SuspendTicks;
+volatile bool     USB_Device_RemoteWakeupSent;
+
+static uint8_t          USB_Device_WakeEvents[REMOTE_WAKEUP_QUEUE_SIZE];
+static volatile uint8_t USB_Device_WakeEventWriteIndex;
+static volatile uint8_t USB_Device_WakeEventReadIndex;
+
 void USB_Device_SendRemoteWakeup(void)
 {
-	//TODO: unimplemented
+	if (!(USB_RemoteWakeupEnabled) || (USB_DeviceState != DEVICE_STATE_Suspended))
+	  return;
+
+	/* Suspend is flagged after 3ms of bus idle, but resume signalling may only start after 5ms */
+	while ((USB_DEVICE_TICKS() - USB_Device_SuspendTicks) < (REMOTE_WAKEUP_SUSPEND_DELAY_MS * USB_DEVICE_TICKS_PER_MS));
+
+	/* Clearing the suspend bit while the bus is suspended makes the controller drive resume signalling */
+	WriteCommandData(CMD_SET_DEV_STAT, DAT_WR_BYTE(DEV_CON));
+	USB_Device_RemoteWakeupSent = true;
 }
 
+bool USB_Device_QueueWakeEvent(const uint8_t WakeEvent)
+{
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	if (USB_DeviceState != DEVICE_STATE_Suspended)
+	{
+		SetGlobalInterruptMask(CurrentGlobalInt);
+
+		EVENT_USB_Device_WakeEvent(WakeEvent);
+		return true;
+	}
+
+	uint8_t QueuedEvents = (uint8_t)(USB_Device_WakeEventWriteIndex - USB_Device_WakeEventReadIndex);
+
+	if (QueuedEvents == REMOTE_WAKEUP_QUEUE_SIZE)
+	{
+		SetGlobalInterruptMask(CurrentGlobalInt);
+		return false;
+	}
+
+	USB_Device_WakeEvents[USB_Device_WakeEventWriteIndex & (REMOTE_WAKEUP_QUEUE_SIZE - 1)] = WakeEvent;
+	USB_Device_WakeEventWriteIndex++;
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+
+	if (!(QueuedEvents))
+	  USB_Device_SendRemoteWakeup();
+
+	return true;
+}
+
+void USB_Device_DeliverWakeEvents(void)
+{
+	USB_Device_RemoteWakeupSent = false;
+
+	while (USB_Device_WakeEventReadIndex != USB_Device_WakeEventWriteIndex)
+	{
+		EVENT_USB_Device_WakeEvent(USB_Device_WakeEvents[USB_Device_WakeEventReadIndex & (REMOTE_WAKEUP_QUEUE_SIZE - 1)]);
+		USB_Device_WakeEventReadIndex++;
+	}
+}
+
+void USB_Device_DiscardWakeEvents(void)
+{
+	USB_Device_RemoteWakeupSent   = false;
+	USB_Device_WakeEventReadIndex = USB_Device_WakeEventWriteIndex;
+}
+#endif
+
+#if defined(USB_SUSPEND_POWER_MANAGER)
+USB_Device_SuspendStats_t USB_Device_SuspendStats;
+
+void USB_Device_SuspendSleep(void)
+{
+	uint_reg_t CurrentGlobalInt = GetGlobalInterruptMask();
+	GlobalInterruptDisable();
+
+	#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+	if ((USB_DeviceState != DEVICE_STATE_Suspended) || USB_Device_RemoteWakeupSent)
+	#else
+	if (USB_DeviceState != DEVICE_STATE_Suspended)
+	#endif
+	{
+		SetGlobalInterruptMask(CurrentGlobalInt);
+		return;
+	}
+
+	SCB_PDRUNCFG |= USB_SUSPEND_POWERDOWN_MASK;
+
+	#if defined(USB_SUSPEND_DEEP_SLEEP)
+	SCB_PDAWAKECFG = SCB_PDRUNCFG;
+	CM3_SCR |=  CM3_SCR_SLEEPDEEP;
+	#else
+	CM3_SCR &= ~CM3_SCR_SLEEPDEEP;
+	#endif
+
+	/* Interrupts stay masked so that the wake-up interrupt, normally the controller's own resume interrupt on
+	 * USB_IRQn, is only serviced once any gated USB clocks are back */
+	__asm__ __volatile__ ("wfi");
+
+	uint32_t WakeTicks = USB_DEVICE_TICKS();
+
+	CM3_SCR &= ~CM3_SCR_SLEEPDEEP;
+
+	/* The USB PLL keeps its configuration while powered down, so only the lock needs to be waited for */
+	SCB_PDRUNCFG &= ~(USB_SUSPEND_POWERDOWN_MASK);
+	while (!(SCB_USBPLLSTAT & SCB_USBPLLSTAT_LOCK));
+
+	SetGlobalInterruptMask(CurrentGlobalInt);
+
+	WakeTicks = (USB_DEVICE_TICKS() - WakeTicks);
+
+	USB_Device_SuspendStats.Sleeps++;
+	USB_Device_SuspendStats.LastWakeTicks = WakeTicks;
+
+	if (WakeTicks > USB_Device_SuspendStats.MaxWakeTicks)
+	  USB_Device_SuspendStats.MaxWakeTicks = WakeTicks;
+
+	if (USB_DeviceState != DEVICE_STATE_Suspended)
+	  USB_Device_SuspendStats.Resumes++;
+}
+#endif
+
 #endif
 
@@ -77,30 +77,194 @@
 			 */
 			#define USB_DEVICE_OPT_FULLSPEED               (0 << 0)
 			//@}
+
+			#if (!defined(NO_INTERNAL_SERIAL) || defined(__DOXYGEN__))
+				/** String descriptor index for the device's unique serial number string descriptor within the device.
+				 *  This unique serial number is derived from the 128-bit unique ID of the LPC13xx, read once through the
+				 *  IAP Read UID service when \ref USB_Init() is called, and served from a ready to send descriptor
+				 *  thereafter. It may be used in the device descriptor's \c SerialNumStrIndex field.
+				 *
+				 *  \note This index and the internal serial may be disabled by defining the \c NO_INTERNAL_SERIAL token in
+				 *        the project makefile and passing it to the compiler via the -D switch.
+				 */
+				#define USE_INTERNAL_SERIAL            0xDC
+
+				#if !defined(INTERNAL_SERIAL_LENGTH_BITS) || defined(__DOXYGEN__)
+					/** Length of the device's unique internal serial number, in bits, which must be a multiple of four no
+					 *  larger than 128. Each four bits become one hexadecimal digit of the serial string; when fewer than 128
+					 *  bits are used, the least significant digits of the unique ID are kept. This may be overridden in the
+					 *  user project makefile by passing the \c INTERNAL_SERIAL_LENGTH_BITS token to the compiler via the -D
+					 *  switch, and the \c INTERNAL_SERIAL_LOWERCASE token may also be defined to format the serial with lower
+					 *  case hexadecimal digits.
+					 */
+					#define INTERNAL_SERIAL_LENGTH_BITS    128
+				#endif
+
+				#if (INTERNAL_SERIAL_LENGTH_BITS % 4) || (INTERNAL_SERIAL_LENGTH_BITS > 128) || (INTERNAL_SERIAL_LENGTH_BITS == 0)
+					#error INTERNAL_SERIAL_LENGTH_BITS must be a non-zero multiple of four no larger than 128.
+				#endif
+			#else
+				#define USE_INTERNAL_SERIAL            NO_DESCRIPTOR
+				#define INTERNAL_SERIAL_LENGTH_BITS    0
+			#endif
+
+			#if !defined(USB_DEVICE_TICKS) || defined(__DOXYGEN__)
+				/** Expression returning a free running, up counting 32-bit tick count, used by the device mode driver to time
+				 *  bus suspend and resume events, and the default tick source of the other timing features of the library.
+				 *  By default this is the Cortex-M3 DWT cycle counter, which does not advance while the core is asleep, so
+				 *  intervals timed with it are never shorter than the real elapsed time. This may be overridden in the user
+				 *  project makefile by passing the \c USB_DEVICE_TICKS() token to the compiler via the -D switch, along with
+				 *  \ref USB_DEVICE_TICKS_INIT(), to use an application timer instead.
+				 */
+				#define USB_DEVICE_TICKS()             (CM3_DWT_CYCCNT)
+
+				/** Statement starting the tick source of \ref USB_DEVICE_TICKS(), executed by \ref USB_Init(). By default
+				 *  this enables the Cortex-M3 trace unit and its DWT cycle counter.
+				 */
+				#define USB_DEVICE_TICKS_INIT()        MACROS{ CM3_DEMCR    |= CM3_DEMCR_TRCENA;       \
+				                                               CM3_DWT_CTRL |= CM3_DWT_CTRL_CYCCNTENA; }MACROE
+			#endif
+
+			#if !defined(USB_DEVICE_TICKS_PER_MS) || defined(__DOXYGEN__)
+				/** Number of \ref USB_DEVICE_TICKS() ticks in one millisecond. By default this is the core clock of a LPC13xx
+				 *  running at its maximum 72MHz, which errs on the side of longer delays at lower clock speeds. This may be
+				 *  overridden in the user project makefile by passing the \c USB_DEVICE_TICKS_PER_MS token to the compiler via
+				 *  the -D switch.
+				 */
+				#define USB_DEVICE_TICKS_PER_MS        72000UL
+			#endif
+
+			#if !defined(NO_DEVICE_REMOTE_WAKEUP) || defined(__DOXYGEN__)
+				#if !defined(REMOTE_WAKEUP_QUEUE_SIZE) || defined(__DOXYGEN__)
+					/** Number of wake events which may be held by \ref USB_Device_QueueWakeEvent() while the bus is
+					 *  suspended, until they are delivered on resume. This must be a power of two no larger than 128, and
+					 *  may be overridden in the user project makefile by passing the \c REMOTE_WAKEUP_QUEUE_SIZE token to
+					 *  the compiler via the -D switch.
+					 *
+					 *  \note Not available when the \c NO_DEVICE_REMOTE_WAKEUP compile time token is defined.
+					 */
+					#define REMOTE_WAKEUP_QUEUE_SIZE       4
+				#endif
+
+				#if (REMOTE_WAKEUP_QUEUE_SIZE & (REMOTE_WAKEUP_QUEUE_SIZE - 1)) || (REMOTE_WAKEUP_QUEUE_SIZE > 128)
+					#error REMOTE_WAKEUP_QUEUE_SIZE must be a power of two no larger than 128.
+				#endif
+			#endif
+
+			#if defined(USB_SUSPEND_POWER_MANAGER) || defined(__DOXYGEN__)
+				#if !defined(USB_SUSPEND_POWERDOWN_MASK) || defined(__DOXYGEN__)
+					/** Mask of \c SCB_PDRUNCFG power-down bits set by \ref USB_Device_SuspendSleep() while the bus is suspended,
+					 *  and cleared again on wake before any interrupt is serviced. By default nothing is powered down, as the
+					 *  LPC134x USB controller can only report resume signalling from the host through \c USB_IRQn while its USB
+					 *  PLL clock is running, and has no separate clock independent USB activity wake-up. Boards which route bus
+					 *  activity to a start logic pin, configured by the application, may add \c SCB_PDSLEEPCFG_USBPLL_PD and
+					 *  \c SCB_PDSLEEPCFG_USBPAD_PD by passing the \c USB_SUSPEND_POWERDOWN_MASK token to the compiler via the
+					 *  -D switch.
+					 *
+					 *  \note Only available when the \c USB_SUSPEND_POWER_MANAGER compile time token is defined.
+					 */
+					#define USB_SUSPEND_POWERDOWN_MASK     0
+				#endif
+			#endif
 			
 			
 						
 		/* Function Prototypes: */
-			/** Sends a Remote Wakeup request to the host. This signals to the host that the device should
-			 *  be taken out of suspended mode, and communications should resume.
-			 *
-			 *  Typically, this is implemented so that HID devices (mice, keyboards, etc.) can wake up the
-			 *  host computer when the host has suspended all USB devices to enter a low power state.
-			 *
-			 *  \note This macro should only be used if the device has indicated to the host that it
-			 *        supports the Remote Wakeup feature in the device descriptors, and should only be
-			 *        issued if the host is currently allowing remote wakeup events from the device (i.e.,
-			 *        the \ref USB_RemoteWakeupEnabled flag is set). When the \c NO_DEVICE_REMOTE_WAKEUP compile
-			 *        time option is used, this macro is unavailable.
-			 *        \n\n
-			 *
-			 *  \note The USB clock must be running for this function to operate. If the stack is initialized with
-			 *        the \ref USB_OPT_MANUAL_PLL option enabled, the user must ensure that the PLL is running
-			 *        before attempting to call this function.
-			 *
-			 *  \see \ref Group_StdDescriptors for more information on the RMWAKEUP feature and device descriptors.
-			 */
-			void USB_Device_SendRemoteWakeup(void);
+			#if !defined(NO_DEVICE_REMOTE_WAKEUP) || defined(__DOXYGEN__)
+				/** Sends a Remote Wakeup request to the host. This signals to the host that the device should
+				 *  be taken out of suspended mode, and communications should resume.
+				 *
+				 *  Typically, this is implemented so that HID devices (mice, keyboards, etc.) can wake up the
+				 *  host computer when the host has suspended all USB devices to enter a low power state.
+				 *
+				 *  The request is ignored unless the bus is suspended and the host has enabled remote wakeup (i.e.,
+				 *  the \ref USB_RemoteWakeupEnabled flag is set). As the bus must have been idle for at least 5ms
+				 *  before resume signalling may start, this blocks for up to the remaining 2ms after suspend was
+				 *  detected. Resume signalling is then generated by the controller, and the \ref EVENT_USB_Device_WakeUp()
+				 *  event fires from the USB interrupt once the bus has resumed.
+				 *
+				 *  \note This function should only be used if the device has indicated to the host that it
+				 *        supports the Remote Wakeup feature in the device descriptors. When the \c NO_DEVICE_REMOTE_WAKEUP
+				 *        compile time option is used, this function is unavailable.
+				 *        \n\n
+				 *
+				 *  \note The USB clock must be running for this function to operate. If the stack is initialized with
+				 *        the \ref USB_OPT_MANUAL_PLL option enabled, the user must ensure that the PLL is running
+				 *        before attempting to call this function.
+				 *
+				 *  \see \ref Group_StdDescriptors for more information on the RMWAKEUP feature and device descriptors.
+				 */
+				void USB_Device_SendRemoteWakeup(void);
+
+				/** Queues an application defined event which should wake the host, such as a key press. If the bus is not
+				 *  suspended the event is delivered at once through \ref EVENT_USB_Device_WakeEvent(). Otherwise it is held
+				 *  until the bus resumes, when it is delivered from the USB interrupt immediately after
+				 *  \ref EVENT_USB_Device_WakeUp(), and a remote wakeup is sent via \ref USB_Device_SendRemoteWakeup() if
+				 *  the event is the first one queued. Events still queued when the bus is reset are discarded.
+				 *
+				 *  \param[in] WakeEvent  Application defined event code to deliver on resume.
+				 *
+				 *  \return Boolean \c true if the event was delivered or queued, \c false if the queue of
+				 *          \ref REMOTE_WAKEUP_QUEUE_SIZE events is full.
+				 *
+				 *  \note When the \c NO_DEVICE_REMOTE_WAKEUP compile time option is used, this function is unavailable.
+				 */
+				bool USB_Device_QueueWakeEvent(const uint8_t WakeEvent);
+			#endif
+
+			#if defined(USB_SUSPEND_POWER_MANAGER) || defined(__DOXYGEN__)
+				/** Puts the microcontroller to sleep while the USB bus is suspended, to meet the bus suspend current limit.
+				 *  The USB clocks given by \ref USB_SUSPEND_POWERDOWN_MASK are powered down and the core enters sleep, or
+				 *  deep-sleep when the \c USB_SUSPEND_DEEP_SLEEP token is defined, until an interrupt is raised. With
+				 *  the default mask the USB clock keeps running, so that the controller's resume interrupt on \c USB_IRQn
+				 *  wakes the core. Gating the USB PLL also stops that interrupt, so any other enabled interrupt, such as
+				 *  an application configured start logic input, must then serve as the wake-up source. On wake the USB PLL
+				 *  is powered back up with its existing configuration, rather than through a full \ref USB_ResetInterface(),
+				 *  before the pending interrupt is serviced and this function returns. The time from waking to the pending
+				 *  interrupt being serviced is recorded in \ref USB_Device_SuspendStats.
+				 *
+				 *  This is called automatically from \ref USB_USBTask() while the bus is suspended, and returns at once if
+				 *  the bus is not suspended or a remote wakeup is in progress. Each call sleeps at most once, so that the
+				 *  application main loop can handle its own wake-up events.
+				 *
+				 *  \note In deep-sleep the application must configure the start logic and \c SCB_PDSLEEPCFG for its wake-up
+				 *        sources, as only start logic inputs can end deep-sleep.
+				 *        \n\n
+				 *
+				 *  \note Only available when the \c USB_SUSPEND_POWER_MANAGER compile time token is defined.
+				 */
+				void USB_Device_SuspendSleep(void);
+			#endif
+
+		/* Type Defines: */
+			#if defined(USB_SUSPEND_POWER_MANAGER) || defined(__DOXYGEN__)
+				/** \brief Suspend Power Manager Statistics.
+				 *
+				 *  Type define for the statistics kept by \ref USB_Device_SuspendSleep(), in \ref USB_DEVICE_TICKS() ticks.
+				 *
+				 *  \note Only available when the \c USB_SUSPEND_POWER_MANAGER compile time token is defined.
+				 */
+				typedef struct
+				{
+					uint32_t Sleeps; /**< Number of times the microcontroller has slept while the bus was suspended. */
+					uint32_t Resumes; /**< Number of bus resumes detected on waking from sleep. */
+					uint32_t LastWakeTicks; /**< Time from the core waking to its wake-up interrupt being serviced, including
+					                         *   the USB PLL relock, on the most recent wake. The core's own start-up from
+					                         *   sleep is not included, as the tick source is halted until it completes.
+					                         */
+					uint32_t MaxWakeTicks; /**< Longest time from the core waking to its wake-up interrupt being serviced. */
+				} USB_Device_SuspendStats_t;
+			#endif
+
+		/* Global Variables: */
+			#if defined(USB_SUSPEND_POWER_MANAGER) || defined(__DOXYGEN__)
+				/** Statistics of the suspend power manager, updated by \ref USB_Device_SuspendSleep(). This may be cleared
+				 *  by the application at any time.
+				 *
+				 *  \note Only available when the \c USB_SUSPEND_POWER_MANAGER compile time token is defined.
+				 */
+				extern USB_Device_SuspendStats_t USB_Device_SuspendStats;
+			#endif
 
 		/* Inline Functions: */
 			/** Returns the current USB frame number, when in device mode. Every millisecond the USB bus is active (i.e. enumerated to a host)
@@ -159,6 +323,36 @@
 			{
 				return USB_address;
 			}
+
+		#if !defined(NO_INTERNAL_SERIAL)
+		/* Macros: */
+			#define IAP_LOCATION                   0x1FFF1FF1
+			#define IAP_CMD_READ_UID               58
+
+		/* Type Defines: */
+			typedef void (*IAP_Entry_t)(uint32_t* Command, uint32_t* Result);
+
+		/* Function Prototypes: */
+			/* Weakly defined by the driver, so that simulation and test builds without the IAP ROM may supply their own */
+			#if defined(__INCLUDE_FROM_DEVICE_LPC13XX_C)
+				void USB_Device_GetSerialString(uint16_t* const UnicodeString) ATTR_WEAK ATTR_NON_NULL_PTR_ARG(1);
+			#else
+				void USB_Device_GetSerialString(uint16_t* const UnicodeString) ATTR_NON_NULL_PTR_ARG(1);
+			#endif
+		#endif
+
+		#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+		/* Macros: */
+			#define REMOTE_WAKEUP_SUSPEND_DELAY_MS 2
+
+		/* External Variables: */
+			extern volatile uint32_t USB_Device_SuspendTicks;
+			extern volatile bool     USB_Device_RemoteWakeupSent;
+
+		/* Function Prototypes: */
+			void USB_Device_DeliverWakeEvents(void);
+			void USB_Device_DiscardWakeEvents(void);
+		#endif
 	#endif
 
 #endif
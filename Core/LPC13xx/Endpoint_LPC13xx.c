@@ -35,6 +35,7 @@
 
 #include "../Endpoint.h"
 #include "../Events.h"
+#include "../USBInterrupt.h"
 
 #if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
 uint8_t USB_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
@@ -43,6 +44,18 @@ uint8_t USB_ControlEndpointSize = ENDPOINT_CONTROLEP_DEFAULT_SIZE;
 volatile uint32_t USB_SelectedEndpoint = ENDPOINT_CONTROLEP;
 volatile Endpoint_flags_t Endpoint_flags[USB_EP_NUM];
 
+static volatile bool Endpoint_PortLocked;
+
+/* Partially written IN packets, one per logical endpoint, held in RAM until the packet is complete */
+static uint32_t Endpoint_StagedData[USB_EP_NUM / 2][ENDPOINT_STAGING_BUFFER_SIZE / sizeof(uint32_t)];
+static uint16_t Endpoint_StagedLength[USB_EP_NUM / 2];
+
+#if defined(INTERRUPT_CONTROL_ENDPOINT)
+volatile Endpoint_ControlTransfer_t Endpoint_ControlTransfer;
+
+static uint32_t Endpoint_ControlWriteBuffer[INTERRUPT_CONTROL_BUFFER_SIZE / sizeof(uint32_t)];
+#endif
+
 
 void Endpoint_ClearEndpoints(void)
 {
@@ -63,7 +76,13 @@ void Endpoint_ClearStatusStage(void)
 		//	  return;
 		//}
 
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		/* The host's status packet is acknowledged from the endpoint interrupt once it arrives */
+		if (Endpoint_ControlTransfer.Stage == ENDPOINT_CONTROLSTAGE_Idle)
+		  Endpoint_ControlTransfer.Stage = ENDPOINT_CONTROLSTAGE_StatusOUT;
+		#else
 		Endpoint_ClearOUT();
+		#endif
 	}
 	else
 	{
@@ -77,6 +96,93 @@ void Endpoint_ClearStatusStage(void)
 	}
 }
 
+#if defined(INTERRUPT_CONTROL_ENDPOINT)
+void Endpoint_StartControlWrite(const void* const Buffer,
+                                uint16_t Length)
+{
+	if (Length > USB_ControlRequest.wLength)
+	  Length = USB_ControlRequest.wLength;
+
+	Endpoint_ControlTransfer.Buffer  = Buffer;
+	Endpoint_ControlTransfer.Length  = Length;
+	Endpoint_ControlTransfer.SendZLP = (Length < USB_ControlRequest.wLength);
+	Endpoint_ControlTransfer.Stage   = ENDPOINT_CONTROLSTAGE_DataIN;
+
+	Endpoint_ContinueControlWrite();
+}
+
+bool Endpoint_StartBufferedControlWrite(const void* const Buffer,
+                                        uint16_t Length)
+{
+	if (Length > USB_ControlRequest.wLength)
+	  Length = USB_ControlRequest.wLength;
+
+	/* A single packet data stage is sent in full before returning, leaving nothing to read from the buffer later */
+	if (Length <= USB_ControlEndpointSize)
+	{
+		Endpoint_StartControlWrite(Buffer, Length);
+		return true;
+	}
+
+	if (Length > sizeof(Endpoint_ControlWriteBuffer))
+	  return false;
+
+	memcpy(Endpoint_ControlWriteBuffer, Buffer, Length);
+	Endpoint_StartControlWrite(Endpoint_ControlWriteBuffer, Length);
+
+	return true;
+}
+
+void Endpoint_ContinueControlWrite(void)
+{
+	uint16_t PacketLength = MIN(Endpoint_ControlTransfer.Length, USB_ControlEndpointSize);
+
+	Endpoint_write_buf(Endpoint_ControlTransfer.Buffer, PacketLength);
+	Endpoint_ClearIN();
+
+	Endpoint_ControlTransfer.Buffer += PacketLength;
+	Endpoint_ControlTransfer.Length -= PacketLength;
+
+	/* The data stage ends on a short packet, or on a full packet when no terminating zero length packet is needed */
+	if ((PacketLength < USB_ControlEndpointSize) || (!(Endpoint_ControlTransfer.Length) && !(Endpoint_ControlTransfer.SendZLP)))
+	  Endpoint_ControlTransfer.Stage = ENDPOINT_CONTROLSTAGE_StatusOUT;
+}
+
+void Endpoint_PollControlEndpoint(void)
+{
+	uint32_t Status = (USB_DEVINTST & (EP0_INT | EP1_INT | DEV_STAT_INT));
+
+	if (!(Status))
+	  return;
+
+	USB_DEVINTCLR = Status;
+
+	/* Bus reset, disconnection and suspension are serviced here too, as the loop waiting on the control endpoint may
+	 * be running inside the USB interrupt; the resulting device state change or new SETUP packet then ends the wait
+	 */
+	if (Status & DEV_STAT_INT)
+	  USB_Device_ProcessDeviceStatus();
+
+	if (Status & EP0_INT)
+	{
+		WriteCommand(CMD_SEL_EP_CLRI(0));
+
+		if (ReadCommandData(DAT_SEL_EP_CLRI(0)) & EP_SEL_STP)
+		  Endpoint_flags[ENDPOINT_CONTROLEP].setup = 1;
+
+		Endpoint_flags[ENDPOINT_CONTROLEP].out = 1;
+	}
+
+	if (Status & EP1_INT)
+	{
+		WriteCommand(CMD_SEL_EP_CLRI(1));
+		ReadCommandData(DAT_SEL_EP_CLRI(1));
+
+		Endpoint_flags[ENDPOINT_CONTROLEP].in = 1;
+	}
+}
+#endif
+
 #if !defined(CONTROL_ONLY_DEVICE)
 uint8_t Endpoint_WaitUntilReady(void)
 {
@@ -122,14 +228,63 @@ uint8_t Endpoint_WaitUntilReady(void)
 	}
 }
 
-uint32_t Endpoint_Read_buf(uint8_t *buf, uint32_t size)
+/* The controller's single data port cannot be switched to another endpoint part way through a packet, as re-enabling
+ * it restarts the packet. Each packet is therefore moved through the port in one go with the USB interrupt held off,
+ * so that the endpoint handlers run from it can never pre-empt a transfer made from the main program, while the
+ * interrupt is never held off for longer than a single packet's FIFO access.
+ */
+static void Endpoint_LockPort(void)
+{
+	if (Endpoint_PortLocked)
+	  return;
+
+	NVIC_DisableIRQ(USB_IRQn);
+	#if !defined(LPC13XX_HOST_SIMULATION)
+	__asm volatile ("dsb" ::: "memory");
+	__asm volatile ("isb" ::: "memory");
+	#endif
+
+	Endpoint_PortLocked = true;
+}
+
+static void Endpoint_UnlockPort(void)
 {
-	if (!Endpoint_flags[USB_SelectedEndpoint].preparedRead){
-		Endpoint_prepare_read();
+	if (!(Endpoint_PortLocked))
+	  return;
+
+	Endpoint_PortLocked = false;
+
+	NVIC_EnableIRQ(USB_IRQn);
+}
+
+static void Endpoint_LoadPacket(const uint8_t* Buffer,
+                                const uint32_t Length)
+{
+	USB_CTRL = ((USB_SelectedEndpoint & 0x0F) << 2) | CTRL_WR_EN;
+	__asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop");
+	USB_TXPLEN = Length;
+
+	if (!(Length))
+	  USB_TXDATA = 0;
+
+	for (uint32_t n = 0; n < (Length + 3) / 4; n++)
+	{
+		USB_TXDATA = *((uint32_t __attribute__((packed)) *)Buffer);
+		Buffer += 4;
 	}
-	
+
+	USB_CTRL = 0;
+}
+
+uint32_t Endpoint_Read_buf(uint8_t *buf, uint32_t size)
+{
 	uint32_t cnt;
 
+	Endpoint_LockPort();
+
+	USB_CTRL = ((USB_SelectedEndpoint & 0x0F) << 2) | CTRL_RD_EN;
+	__asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop");
+
 	do 
 	{
 		cnt = USB_RXPLEN;
@@ -142,59 +297,82 @@ uint32_t Endpoint_Read_buf(uint8_t *buf, uint32_t size)
 		buf += 4;
 	}
 
-	return cnt;
-}
+	USB_CTRL = 0;
 
-void Endpoint_prepare_read(){
-	USB_CTRL = ((USB_SelectedEndpoint & 0x0F) << 2) | CTRL_RD_EN;
-	__asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop");
-	Endpoint_flags[USB_SelectedEndpoint].preparedRead = 1;
+	Endpoint_UnlockPort();
+
+	return cnt;
 }
 
-void Endpoint_complete_read(){
-	USB_CTRL = 0;
+void Endpoint_complete_read(void)
+{
+	Endpoint_LockPort();
 
 	if ((USB_SelectedEndpoint & 0x80) != 0x04) 
 	{   /* Iso endpoints are cleared on SOF */
 		WriteEndpointCommand(USB_SelectedEndpoint, CMD_CLR_BUF);
 	}
 	
-	Endpoint_flags[USB_SelectedEndpoint].preparedRead = 0;
-}
+	Endpoint_flags[USB_SelectedEndpoint].out = 0;
 
-void Endpoint_prepare_write(uint32_t size){
-	USB_CTRL = ((USB_SelectedEndpoint & 0x0F) << 2) | CTRL_WR_EN;
-	__asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop"); __asm("nop");
-	USB_TXPLEN = size;
-	Endpoint_flags[USB_SelectedEndpoint].preparedWrite = 1;
-	if (size == 0){
-		USB_TXDATA = 0;
-	}
+	Endpoint_UnlockPort();
 }
 
-void Endpoint_complete_write(){
-	USB_CTRL = 0;
+void Endpoint_complete_write(void)
+{
+	uint8_t EPNum = (USB_SelectedEndpoint & 0x0F);
+
+	Endpoint_LockPort();
+
+	/* A packet built up from partial writes is only moved into the endpoint FIFO now that it is complete */
+	if (!(Endpoint_flags[USB_SelectedEndpoint].loaded))
+	  Endpoint_LoadPacket((const uint8_t*)Endpoint_StagedData[EPNum], Endpoint_StagedLength[EPNum]);
+
 	WriteEndpointCommand(USB_SelectedEndpoint|0x80, CMD_VALID_BUF);
-	Endpoint_flags[USB_SelectedEndpoint].preparedWrite = 0;
+
+	Endpoint_StagedLength[EPNum]               = 0;
+	Endpoint_flags[USB_SelectedEndpoint].loaded = 0;
+	Endpoint_flags[USB_SelectedEndpoint].in     = 0;
+
+	Endpoint_UnlockPort();
 }
 
 uint32_t Endpoint_write_buf(const uint8_t *buf, uint32_t size) 
 {
-	if (!Endpoint_flags[USB_SelectedEndpoint].preparedWrite){
-		Endpoint_prepare_write(size);
-	}
-	uint32_t n;
+	/* Data following earlier partial writes must join them in the staged packet, as the FIFO cannot be appended to */
+	if (Endpoint_StagedLength[USB_SelectedEndpoint & 0x0F])
+	  return Endpoint_stage_buf(buf, size);
+
+	if (Endpoint_flags[USB_SelectedEndpoint].loaded)
+	  return 0;
+
+	Endpoint_LockPort();
+
+	Endpoint_LoadPacket(buf, size);
+	Endpoint_flags[USB_SelectedEndpoint].loaded = 1;
+
+	Endpoint_UnlockPort();
 
-	for (n = 0; n < (size + 3) / 4; n++) 
-	{
-		USB_TXDATA = *((uint32_t __attribute__((packed)) *)buf);
-		buf += 4;
-	}
-	
 	return size;
 }
 
-#endif
+uint32_t Endpoint_stage_buf(const uint8_t *buf, uint32_t size)
+{
+	uint8_t  EPNum  = (USB_SelectedEndpoint & 0x0F);
+	uint16_t Staged = Endpoint_StagedLength[EPNum];
+
+	if (Endpoint_flags[USB_SelectedEndpoint].loaded)
+	  return 0;
+
+	if (size > (ENDPOINT_STAGING_BUFFER_SIZE - Staged))
+	  size = (ENDPOINT_STAGING_BUFFER_SIZE - Staged);
+
+	memcpy((uint8_t*)Endpoint_StagedData[EPNum] + Staged, buf, size);
+	Endpoint_StagedLength[EPNum] = (Staged + size);
+
+	return size;
+}
 
 #endif
 
+#endif
@@ -98,8 +98,7 @@
 			bool setup: 1;
 			bool in: 1;
 			bool out: 1;
-			bool preparedRead: 1;
-			bool preparedWrite: 1;
+			bool loaded: 1;
 		} Endpoint_flags_t;
 		
 		
@@ -132,6 +131,8 @@
 			#define ENDPOINT_TOTAL_ENDPOINTS 7
 			
 			#define ENDPOINT_CONTROLEP_DEFAULT_SIZE     8
+
+			#define ENDPOINT_CONTROLEP_MAX_SIZE         64
 			
 			/** Endpoint data direction mask for \ref Endpoint_ConfigureEndpoint(). This indicates that the endpoint
 			 *  should be initialized in the OUT direction - i.e. data flows from host to device.
@@ -143,28 +144,78 @@
 			 */
 			#define ENDPOINT_DIR_IN  						1
 
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		/* Enums: */
+			enum Endpoint_ControlStages_t
+			{
+				ENDPOINT_CONTROLSTAGE_Idle      = 0, /* No stage of the control transfer is driven from the endpoint interrupt. */
+				ENDPOINT_CONTROLSTAGE_DataIN    = 1, /* IN data stage in progress, next packet sent when the last is acknowledged. */
+				ENDPOINT_CONTROLSTAGE_StatusOUT = 2, /* IN data stage complete, awaiting the host's status stage packet. */
+			};
+
+		/* Type Defines: */
+			typedef struct
+			{
+				const uint8_t* Buffer; /* Next byte of the IN data stage to send. */
+				uint16_t       Length; /* Bytes of the IN data stage remaining to be sent. */
+				bool           SendZLP; /* Whether a full final packet must be followed by a zero length packet. */
+				uint8_t        Stage; /* Current stage of the control transfer, a value from Endpoint_ControlStages_t. */
+			} Endpoint_ControlTransfer_t;
+		#endif
+
 		/* Function Prototypes: */
 			void Endpoint_ClearEndpoints(void);
 			bool Endpoint_ConfigureEndpoint_Prv(const uint8_t Number,
 			                                    const uint32_t UECFGXData);
+
+			#if defined(INTERRUPT_CONTROL_ENDPOINT)
+				void Endpoint_StartControlWrite(const void* const Buffer,
+				                                uint16_t Length);
+				bool Endpoint_StartBufferedControlWrite(const void* const Buffer,
+				                                        uint16_t Length);
+				void Endpoint_ContinueControlWrite(void);
+				void Endpoint_PollControlEndpoint(void);
+			#endif
 		
 		/* External Variables: */
 			extern volatile uint32_t USB_SelectedEndpoint;
 			extern volatile uint8_t* USB_EndpointFIFOPos[];
+
+			#if defined(INTERRUPT_CONTROL_ENDPOINT)
+				extern volatile Endpoint_ControlTransfer_t Endpoint_ControlTransfer;
+			#endif
 	#endif
 
 	/* Public Interface - May be used in end-application: */
 		/* Macros: */
+			#if !defined(INTERRUPT_CONTROL_BUFFER_SIZE) || defined(__DOXYGEN__)
+				/** Size in bytes of the driver owned buffer that IN data stages are copied into when the
+				 *  \c INTERRUPT_CONTROL_ENDPOINT token is defined, so that the remaining packets can be sent from the
+				 *  endpoint interrupt after the caller's buffer has gone out of scope. Longer data stages are sent
+				 *  directly from the caller's buffer before \ref Endpoint_Write_Control_Stream_LE() returns. This may
+				 *  be overridden by defining the token to a multiple of 4 via the -D switch.
+				 */
+				#define INTERRUPT_CONTROL_BUFFER_SIZE       (ENDPOINT_CONTROLEP_MAX_SIZE * 2)
+			#endif
+
+			#if !defined(ENDPOINT_STAGING_BUFFER_SIZE) || defined(__DOXYGEN__)
+				/** Size in bytes of the RAM buffer each endpoint's IN packet is built up in when it is written in several
+				 *  parts, such as through \ref Endpoint_Write_8() or the stream functions, as the controller's data port
+				 *  cannot be held open across calls. Packets written in a single call are loaded straight into the
+				 *  endpoint FIFO and never use the buffer. Writes beyond the buffer's size are discarded. This may be
+				 *  overridden by defining the token to a multiple of 4 via the -D switch.
+				 */
+				#define ENDPOINT_STAGING_BUFFER_SIZE        ENDPOINT_CONTROLEP_MAX_SIZE
+			#endif
 			
 
 		/* Inline Functions: */
-			void Endpoint_prepare_read();
-			void Endpoint_complete_read();
+			void Endpoint_complete_read(void);
 			uint32_t Endpoint_Read_buf(uint8_t *buf, uint32_t size);
 			
-			void Endpoint_prepare_write(uint32_t size);
-			void Endpoint_complete_write();
+			void Endpoint_complete_write(void);
 			uint32_t Endpoint_write_buf(const uint8_t *buf, uint32_t size);
+			uint32_t Endpoint_stage_buf(const uint8_t *buf, uint32_t size);
 		
 
 			/** Indicates the number of bytes currently stored in the current endpoint's selected bank.
@@ -339,8 +390,8 @@
 			static inline void Endpoint_ClearSETUP(void) ATTR_ALWAYS_INLINE;
 			static inline void Endpoint_ClearSETUP(void)
 			{
-				Endpoint_complete_read();
 				Endpoint_flags[USB_SelectedEndpoint].setup = 0;
+				Endpoint_complete_read();
 			}
 
 			/** Sends an IN packet to the host on the currently selected endpoint, freeing up the endpoint for the
@@ -351,11 +402,7 @@
 			static inline void Endpoint_ClearIN(void) ATTR_ALWAYS_INLINE;
 			static inline void Endpoint_ClearIN(void)
 			{
-				if (!Endpoint_flags[USB_SelectedEndpoint].preparedWrite){
-					Endpoint_prepare_write(0);
-				}
 				Endpoint_complete_write();
-				Endpoint_flags[USB_SelectedEndpoint].in = 0;
 			}
 
 			/** Acknowledges an OUT packet to the host on the currently selected endpoint, freeing up the endpoint
@@ -366,11 +413,7 @@
 			static inline void Endpoint_ClearOUT(void) ATTR_ALWAYS_INLINE;
 			static inline void Endpoint_ClearOUT(void)
 			{
-				if (!Endpoint_flags[USB_SelectedEndpoint].preparedRead){
-					Endpoint_prepare_read();
-				}
 				Endpoint_complete_read();
-				Endpoint_flags[USB_SelectedEndpoint].out = 0;
 			}
 
 			/** Stalls the current endpoint, indicating to the host that a logical problem occurred with the
@@ -461,8 +504,7 @@
 			static inline void Endpoint_Write_8(const uint8_t Data) ATTR_ALWAYS_INLINE;
 			static inline void Endpoint_Write_8(const uint8_t Data)
 			{
-				 Endpoint_prepare_write(1);
-				 Endpoint_write_buf(&Data, 1);
+				 Endpoint_stage_buf(&Data, 1);
 			}
 
 			/** Discards one byte from the currently selected endpoint's bank, for OUT direction endpoints.
@@ -519,8 +561,7 @@
 			static inline void Endpoint_Write_16_LE(const uint16_t Data) ATTR_ALWAYS_INLINE;
 			static inline void Endpoint_Write_16_LE(const uint16_t Data)
 			{	
-				Endpoint_prepare_write(2);
-				Endpoint_write_buf(&Data, 2);
+				Endpoint_stage_buf((const uint8_t*)&Data, 2);
 			}
 
 			/** Discards two bytes from the currently selected endpoint's bank, for OUT direction endpoints.
@@ -582,8 +623,7 @@
 			static inline void Endpoint_Write_32_LE(const uint32_t Data) ATTR_ALWAYS_INLINE;
 			static inline void Endpoint_Write_32_LE(const uint32_t Data)
 			{
-				Endpoint_prepare_write(4);
-				Endpoint_write_buf(&Data, 4);
+				Endpoint_stage_buf((const uint8_t*)&Data, 4);
 			}
 
 			/** Writes four bytes to the currently selected endpoint's bank in big endian format, for IN
@@ -0,0 +1,120 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for Descriptors.c.
+ */
+
+#ifndef _DESCRIPTORS_H_
+#define _DESCRIPTORS_H_
+
+	/* Includes: */
+		#include "../../../USB.h"
+		#include "../../../Class/CDC.h"
+
+	/* Macros: */
+		/** Size in bytes of the control endpoint, fixed at compile time when the \c FIXED_CONTROL_ENDPOINT_SIZE token is
+		 *  defined, so that the device descriptor always matches it.
+		 */
+		#if defined(FIXED_CONTROL_ENDPOINT_SIZE)
+			#define CONTROL_ENDPOINT_SIZE      FIXED_CONTROL_ENDPOINT_SIZE
+		#else
+			#define CONTROL_ENDPOINT_SIZE      64
+		#endif
+
+		/** Endpoint number of the CDC device-to-host notification IN endpoint. */
+		#define CDC_NOTIFICATION_EPNUM         1
+
+		/** Endpoint number of the CDC device-to-host data IN endpoint. */
+		#define CDC_TX_EPNUM                   2
+
+		/** Endpoint number of the CDC host-to-device data OUT endpoint. */
+		#define CDC_RX_EPNUM                   3
+
+		/** Size in bytes of the CDC device-to-host notification IN endpoint. */
+		#define CDC_NOTIFICATION_EPSIZE        8
+
+		/** Size in bytes of the CDC data IN and OUT endpoints. */
+		#define CDC_TXRX_EPSIZE                64
+
+		/** Number of unicode characters of the manufacturer string descriptor. */
+		#define MANUFACTURER_STRING_LENGTH     11
+
+		/** Number of unicode characters of the product string descriptor. */
+		#define PRODUCT_STRING_LENGTH          31
+
+	/* Enums: */
+		/** Enum for the string descriptor indexes of the device. */
+		enum StringDescriptors_t
+		{
+			STRING_ID_Language     = 0, /**< Supported languages string descriptor ID (must be zero) */
+			STRING_ID_Manufacturer = 1, /**< Manufacturer string ID */
+			STRING_ID_Product      = 2, /**< Product string ID */
+			TOTAL_STRINGS          = 3, /**< Total number of string descriptors, excluding the internal serial number */
+		};
+
+	/* Type Defines: */
+		/** Type define for the device configuration descriptor structure, of a CDC ACM virtual serial port. */
+		typedef struct
+		{
+			USB_Descriptor_Configuration_Header_t Config;
+
+			// CDC Command Interface
+			USB_Descriptor_Interface_t            CDC_CCI_Interface;
+			USB_CDC_Descriptor_FunctionalHeader_t CDC_Functional_Header;
+			USB_CDC_Descriptor_FunctionalACM_t    CDC_Functional_ACM;
+			USB_CDC_Descriptor_FunctionalUnion_t  CDC_Functional_Union;
+			USB_Descriptor_Endpoint_t             CDC_NotificationEndpoint;
+
+			// CDC Data Interface
+			USB_Descriptor_Interface_t            CDC_DCI_Interface;
+			USB_Descriptor_Endpoint_t             CDC_DataOutEndpoint;
+			USB_Descriptor_Endpoint_t             CDC_DataInEndpoint;
+		} USB_Descriptor_Configuration_t;
+
+	/* External Variables: */
+		extern const USB_Descriptor_Device_t        DeviceDescriptor;
+		extern const USB_Descriptor_Configuration_t ConfigurationDescriptor;
+		extern const USB_Descriptor_String_t        LanguageString;
+		extern const USB_Descriptor_String_t        ManufacturerString;
+		extern const USB_Descriptor_String_t        ProductString;
+
+		#if defined(USE_DESCRIPTOR_TABLE)
+		extern const USB_Descriptor_Table_t         DescriptorTable;
+		#endif
+
+	/* Function Prototypes: */
+		uint16_t CALLBACK_USB_GetDescriptor(const uint16_t wValue,
+		                                    const uint8_t wIndex,
+		                                    const void** const DescriptorAddress)
+		                                    ATTR_WARN_UNUSED_RESULT ATTR_NON_NULL_PTR_ARG(3);
+
+#endif
@@ -0,0 +1,437 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Host benchmark of device enumeration latency. The LPC13xx device driver is built for the host against a simulated
+ *  USB controller, which plays the part of a USB host enumerating a CDC ACM device: it resets the bus, reads the device
+ *  descriptor, sets the device address, reads the configuration and string descriptors, sets the configuration and then
+ *  makes the CDC class requests a host serial driver would. Each enumeration is checked against the device's
+ *  descriptors, and the \ref USB_Device_Profile of the library is printed per phase once all have completed.
+ *
+ *  The bench is built once for each of the default, \c USE_DESCRIPTOR_TABLE and \c FIXED_CONTROL_ENDPOINT_SIZE
+ *  configurations so that their profiles can be compared. Ticks are host nanoseconds and include the cost of the
+ *  simulated controller's registers, so the SIE command counts are the measure that carries over to the target.
+ */
+
+#define  __INCLUDE_FROM_ENUMERATION_BENCH_C
+#include "EnumerationBench.h"
+
+/** Type define for the device's internal serial number string descriptor, as returned by the library. */
+typedef struct
+{
+	USB_Descriptor_Header_t Header;
+	uint16_t                UnicodeString[INTERNAL_SERIAL_LENGTH_BITS / 4];
+} Bench_SerialString_t;
+
+/** Line encoding sent to the device by the simulated host's SET_LINE_CODING request. */
+static const CDC_LineEncoding_t HostLineEncoding =
+	{
+		.BaudRateBPS = 115200,
+		.CharFormat  = CDC_LINEENCODING_OneStopBit,
+		.ParityType  = CDC_PARITY_None,
+		.DataBits    = 8,
+	};
+
+/** Internal serial number string descriptor the device is expected to return. */
+static Bench_SerialString_t SerialString;
+
+/** Line encoding of the device's virtual serial port, as set by the host. */
+static CDC_LineEncoding_t LineEncoding;
+
+/** Handshake line states of the device's virtual serial port, as set by the host. */
+static uint16_t ControlLineStates;
+
+/** Last device descriptor read from the device, from which the host takes the control endpoint size. */
+static USB_Descriptor_Device_t ReadDeviceDescriptor;
+
+/** Enumeration script of the simulated host, modelled on that of a desktop operating system: the first device descriptor
+ *  read is made at the largest control endpoint size and followed by a second bus reset, and the configuration
+ *  descriptor is read first for its header and then in full.
+ */
+static const Bench_Step_t EnumerationSteps[] =
+	{
+		{
+			.Action  = BENCH_STEP_BusReset,
+			.Name    = "Bus reset",
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (device, 64 bytes)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor, (DTYPE_Device << 8), 0, 64},
+			.Data    = &DeviceDescriptor,
+			.Length  = sizeof(USB_Descriptor_Device_t),
+		},
+		{
+			.Action  = BENCH_STEP_SetControlEPSize,
+			.Name    = "Control endpoint size",
+		},
+		{
+			.Action  = BENCH_STEP_BusReset,
+			.Name    = "Bus reset",
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "SET_ADDRESS",
+			.Request = {(REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE), REQ_SetAddress, BENCH_DEVICE_ADDRESS, 0, 0},
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (device)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor, (DTYPE_Device << 8), 0,
+			            sizeof(USB_Descriptor_Device_t)},
+			.Data    = &DeviceDescriptor,
+			.Length  = sizeof(USB_Descriptor_Device_t),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (configuration header)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor, (DTYPE_Configuration << 8), 0,
+			            sizeof(USB_Descriptor_Configuration_Header_t)},
+			.Data    = &ConfigurationDescriptor,
+			.Length  = sizeof(USB_Descriptor_Configuration_Header_t),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (configuration)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor, (DTYPE_Configuration << 8), 0,
+			            BENCH_MAX_TRANSFER_SIZE},
+			.Data    = &ConfigurationDescriptor,
+			.Length  = sizeof(USB_Descriptor_Configuration_t),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (languages)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor, (DTYPE_String << 8), 0,
+			            BENCH_MAX_TRANSFER_SIZE},
+			.Data    = &LanguageString,
+			.Length  = USB_STRING_LEN(1),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (manufacturer)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+			            ((DTYPE_String << 8) | STRING_ID_Manufacturer), LANGUAGE_ID_ENG, BENCH_MAX_TRANSFER_SIZE},
+			.Data    = &ManufacturerString,
+			.Length  = USB_STRING_LEN(MANUFACTURER_STRING_LENGTH),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (product)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+			            ((DTYPE_String << 8) | STRING_ID_Product), LANGUAGE_ID_ENG, BENCH_MAX_TRANSFER_SIZE},
+			.Data    = &ProductString,
+			.Length  = USB_STRING_LEN(PRODUCT_STRING_LENGTH),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_DESCRIPTOR (serial number)",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetDescriptor,
+			            ((DTYPE_String << 8) | USE_INTERNAL_SERIAL), LANGUAGE_ID_ENG, BENCH_MAX_TRANSFER_SIZE},
+			.Data    = &SerialString,
+			.Length  = sizeof(Bench_SerialString_t),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "SET_CONFIGURATION",
+			.Request = {(REQDIR_HOSTTODEVICE | REQTYPE_STANDARD | REQREC_DEVICE), REQ_SetConfiguration, 1, 0, 0},
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_STATUS",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_STANDARD | REQREC_DEVICE), REQ_GetStatus, 0, 0, 2},
+			.Length  = 2,
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "SET_LINE_CODING",
+			.Request = {(REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE), CDC_REQ_SetLineEncoding, 0, 0,
+			            sizeof(CDC_LineEncoding_t)},
+			.Data    = &HostLineEncoding,
+			.Length  = sizeof(CDC_LineEncoding_t),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "GET_LINE_CODING",
+			.Request = {(REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE), CDC_REQ_GetLineEncoding, 0, 0,
+			            sizeof(CDC_LineEncoding_t)},
+			.Data    = &HostLineEncoding,
+			.Length  = sizeof(CDC_LineEncoding_t),
+		},
+		{
+			.Action  = BENCH_STEP_ControlRequest,
+			.Name    = "SET_CONTROL_LINE_STATE",
+			.Request = {(REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE), CDC_REQ_SetControlLineState,
+			            (CDC_CONTROL_LINE_OUT_DTR | CDC_CONTROL_LINE_OUT_RTS), 0, 0},
+		},
+	};
+
+/** Names of the profiled phases, indexed by a value from the \ref USB_Device_ProfilePhases_t enum. */
+static const char* const PhaseNames[USB_DEVICE_PROFILE_TOTAL_PHASES] =
+	{
+		[USB_DEVICE_PROFILE_InitDevice]           = "InitDevice",
+		[USB_DEVICE_PROFILE_ControlRequestEvent]  = "ControlRequestEvent",
+		[USB_DEVICE_PROFILE_SetAddress]           = "SetAddress",
+		[USB_DEVICE_PROFILE_GetDescriptor]        = "GetDescriptor",
+		[USB_DEVICE_PROFILE_SetConfiguration]     = "SetConfiguration",
+		[USB_DEVICE_PROFILE_OtherStandardRequest] = "OtherStandardRequest",
+	};
+
+/** Total of the profile's enumeration ticks over every enumeration, as the profile holds only the most recent. */
+static uint64_t TotalEnumerationTicks;
+
+/** Total SIE commands issued by the device, as counted by the simulated controller, over every enumeration. */
+static uint64_t TotalSIECommands;
+
+/** Total entries into the USB interrupt handler over every enumeration. */
+static uint64_t TotalInterrupts;
+
+int main(void)
+{
+	SerialString.Header.Size = sizeof(Bench_SerialString_t);
+	SerialString.Header.Type = DTYPE_String;
+	USB_Device_GetSerialString(SerialString.UnicodeString);
+
+	#if defined(USE_DESCRIPTOR_TABLE)
+	USB_Device_RegisterDescriptorTable(&DescriptorTable);
+	#endif
+
+	USB_Device_ResetProfile();
+
+	for (uint16_t Enumeration = 0; Enumeration < BENCH_ENUMERATIONS; Enumeration++)
+	{
+		if (!(Bench_Enumerate()))
+		{
+			printf("%s: enumeration %u failed\n", BENCH_BUILD_NAME, Enumeration);
+			return EXIT_FAILURE;
+		}
+	}
+
+	Bench_PrintProfile();
+
+	return EXIT_SUCCESS;
+}
+
+/** Supplies the device's serial number in place of the IAP ROM's unique ID, which is not present on the host. The digits
+ *  are fixed so that the serial number string descriptor returned can be checked.
+ *
+ *  \param[out] UnicodeString  Buffer where the serial number digits are to be stored.
+ */
+void USB_Device_GetSerialString(uint16_t* const UnicodeString)
+{
+	for (uint8_t DigitIndex = 0; DigitIndex < (INTERNAL_SERIAL_LENGTH_BITS / 4); DigitIndex++)
+	{
+		uint8_t Nibble = (DigitIndex & 0x0F);
+
+		UnicodeString[DigitIndex] = ((Nibble >= 10) ? ('A' - 10) : '0') + Nibble;
+	}
+}
+
+/** Event handler for the library USB Reset event. The control endpoint is configured here, as the driver polls it only
+ *  once it has been configured.
+ */
+void EVENT_USB_Device_Reset(void)
+{
+	/* The LPC13xx endpoints have a single fixed bank, so the bank count is not used */
+	Endpoint_ConfigureEndpoint(ENDPOINT_CONTROLEP, EP_TYPE_CONTROL, ENDPOINT_DIR_OUT, USB_ControlEndpointSize, 1);
+}
+
+/** Event handler for the library USB Configuration Changed event. */
+void EVENT_USB_Device_ConfigurationChanged(void)
+{
+	Endpoint_ConfigureEndpoint(CDC_NOTIFICATION_EPNUM, EP_TYPE_INTERRUPT, ENDPOINT_DIR_IN, CDC_NOTIFICATION_EPSIZE, 1);
+	Endpoint_ConfigureEndpoint(CDC_TX_EPNUM, EP_TYPE_BULK, ENDPOINT_DIR_IN, CDC_TXRX_EPSIZE, 1);
+	Endpoint_ConfigureEndpoint(CDC_RX_EPNUM, EP_TYPE_BULK, ENDPOINT_DIR_OUT, CDC_TXRX_EPSIZE, 1);
+}
+
+/** Event handler for the library USB Control Request reception event, handling the CDC class requests. */
+void EVENT_USB_Device_ControlRequest(void)
+{
+	switch (USB_ControlRequest.bRequest)
+	{
+		case CDC_REQ_GetLineEncoding:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_Write_Control_Stream_LE(&LineEncoding, sizeof(LineEncoding));
+				Endpoint_ClearOUT();
+			}
+
+			break;
+		case CDC_REQ_SetLineEncoding:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_Read_Control_Stream_LE(&LineEncoding, sizeof(LineEncoding));
+				Endpoint_ClearIN();
+			}
+
+			break;
+		case CDC_REQ_SetControlLineState:
+			if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE))
+			{
+				Endpoint_ClearSETUP();
+				Endpoint_ClearStatusStage();
+
+				ControlLineStates = USB_ControlRequest.wValue;
+			}
+
+			break;
+	}
+}
+
+/** Powers up the device and the simulated controller, then runs the simulated host's enumeration script against it.
+ *
+ *  \return Boolean \c true if the device enumerated correctly, \c false otherwise.
+ */
+static bool Bench_Enumerate(void)
+{
+	Host_ResetController();
+	Host_SetControlEndpointSize(64);
+
+	memset(&LineEncoding, 0x00, sizeof(LineEncoding));
+	ControlLineStates = 0;
+
+	USB_Init();
+	Host_ConnectVBUS();
+
+	for (uint8_t StepIndex = 0; StepIndex < (sizeof(EnumerationSteps) / sizeof(EnumerationSteps[0])); StepIndex++)
+	{
+		if (!(Bench_RunStep(&EnumerationSteps[StepIndex])))
+		  return false;
+	}
+
+	if (Host_GetDeviceAddress() != BENCH_DEVICE_ADDRESS)
+	{
+		printf("Device address %u set through the SIE, expected %u\n", Host_GetDeviceAddress(), BENCH_DEVICE_ADDRESS);
+		return false;
+	}
+
+	if (!(Host_IsDeviceConfigured()) || (USB_DeviceState != DEVICE_STATE_Configured))
+	{
+		printf("Device is not in the configured state\n");
+		return false;
+	}
+
+	if (ControlLineStates != (CDC_CONTROL_LINE_OUT_DTR | CDC_CONTROL_LINE_OUT_RTS))
+	{
+		printf("Control line states not set by SET_CONTROL_LINE_STATE\n");
+		return false;
+	}
+
+	TotalEnumerationTicks += USB_Device_Profile.EnumerationTicks;
+	TotalSIECommands      += Host_GetSIECommands();
+	TotalInterrupts       += Host_GetInterrupts();
+
+	return true;
+}
+
+/** Runs a single step of the simulated host's enumeration script, checking the data returned by the device.
+ *
+ *  \param[in] Step  Script step to run.
+ *
+ *  \return Boolean \c true if the step succeeded, \c false otherwise.
+ */
+static bool Bench_RunStep(const Bench_Step_t* const Step)
+{
+	uint8_t  Data[BENCH_MAX_TRANSFER_SIZE];
+	uint16_t TransferredLength;
+	uint8_t  Result;
+
+	switch (Step->Action)
+	{
+		case BENCH_STEP_BusReset:
+			Host_BusReset();
+			return true;
+		case BENCH_STEP_SetControlEPSize:
+			Host_SetControlEndpointSize(ReadDeviceDescriptor.Endpoint0Size);
+			return true;
+	}
+
+	memset(Data, 0x00, sizeof(Data));
+
+	if (!(Step->Request.bmRequestType & REQDIR_DEVICETOHOST) && Step->Data)
+	  memcpy(Data, Step->Data, Step->Length);
+
+	Result = Host_ControlTransfer(&Step->Request, Data, &TransferredLength);
+
+	if (Result != HOST_TRANSFER_Complete)
+	{
+		printf("%s: transfer failed with result %u\n", Step->Name, Result);
+		return false;
+	}
+
+	if (TransferredLength != Step->Length)
+	{
+		printf("%s: %u bytes transferred, expected %u\n", Step->Name, TransferredLength, Step->Length);
+		return false;
+	}
+
+	if ((Step->Request.bmRequestType & REQDIR_DEVICETOHOST) && Step->Data && memcmp(Data, Step->Data, Step->Length))
+	{
+		printf("%s: data returned differs from that expected\n", Step->Name);
+		return false;
+	}
+
+	if ((Step->Request.bRequest == REQ_GetDescriptor) && ((Step->Request.wValue >> 8) == DTYPE_Device))
+	  memcpy(&ReadDeviceDescriptor, Data, sizeof(USB_Descriptor_Device_t));
+
+	return true;
+}
+
+/** Prints the library's device profile, accumulated over every enumeration, along with the totals of the simulated
+ *  controller.
+ */
+static void Bench_PrintProfile(void)
+{
+	printf("Build: %s, %u enumerations, control endpoint %u bytes\n", BENCH_BUILD_NAME, BENCH_ENUMERATIONS,
+	       (unsigned)USB_ControlEndpointSize);
+	printf("  %-22s %8s %12s %12s %14s\n", "Phase", "Calls", "Avg ns", "Max ns", "SIE cmds/call");
+
+	for (uint8_t Phase = 0; Phase < USB_DEVICE_PROFILE_TOTAL_PHASES; Phase++)
+	{
+		const USB_Device_ProfilePhase_t* Profile = &USB_Device_Profile.Phases[Phase];
+
+		if (!(Profile->Calls))
+		{
+			printf("  %-22s %8u %12s %12s %14s\n", PhaseNames[Phase], 0, "-", "-", "-");
+			continue;
+		}
+
+		printf("  %-22s %8u %12.0f %12u %14.1f\n", PhaseNames[Phase], Profile->Calls,
+		       ((double)Profile->TotalTicks / Profile->Calls), Profile->MaxTicks,
+		       ((double)Profile->SIECommands / Profile->Calls));
+	}
+
+	printf("  Enumeration (bus reset to configured): %.0f ns average\n",
+	       ((double)TotalEnumerationTicks / BENCH_ENUMERATIONS));
+	printf("  SIE commands per enumeration:          %.1f\n", ((double)TotalSIECommands / BENCH_ENUMERATIONS));
+	printf("  USB interrupts per enumeration:        %.1f\n\n", ((double)TotalInterrupts / BENCH_ENUMERATIONS));
+}
@@ -0,0 +1,98 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for EnumerationBench.c.
+ */
+
+#ifndef _ENUMERATION_BENCH_H_
+#define _ENUMERATION_BENCH_H_
+
+	/* Includes: */
+		#include <stdio.h>
+		#include <stdlib.h>
+
+		#include "Descriptors.h"
+		#include "SimulatedController.h"
+
+		#include "../../../USB.h"
+
+	/* Macros: */
+		/** Number of times the device is enumerated by the simulated host, with the profile accumulated over all of them. */
+		#define BENCH_ENUMERATIONS           1000
+
+		/** Device address assigned to the device by the simulated host. */
+		#define BENCH_DEVICE_ADDRESS         5
+
+		/** Largest data stage of any request made by the simulated host, in bytes. */
+		#define BENCH_MAX_TRANSFER_SIZE      255
+
+		/** Name of the bench build, printed ahead of its profile so that the output of each build can be told apart. */
+		#if defined(USE_DESCRIPTOR_TABLE)
+			#define BENCH_BUILD_NAME         "USE_DESCRIPTOR_TABLE"
+		#elif defined(FIXED_CONTROL_ENDPOINT_SIZE)
+			#define BENCH_BUILD_NAME         "FIXED_CONTROL_ENDPOINT_SIZE"
+		#else
+			#define BENCH_BUILD_NAME         "default"
+		#endif
+
+	/* Enums: */
+		/** Enum for the actions of each step of the simulated host's enumeration script. */
+		enum Bench_StepActions_t
+		{
+			BENCH_STEP_BusReset            = 0, /**< Resets the bus. */
+			BENCH_STEP_ControlRequest      = 1, /**< Makes a control transfer to the device. */
+			BENCH_STEP_SetControlEPSize    = 2, /**< Adopts the control endpoint size of the device descriptor last read. */
+		};
+
+	/* Type Defines: */
+		/** Type define for a single step of the simulated host's enumeration script. */
+		typedef struct
+		{
+			uint8_t            Action; /**< Action of the step, a value from the \ref Bench_StepActions_t enum. */
+			const char*        Name; /**< Name of the step, printed if the step fails. */
+			Host_SetupPacket_t Request; /**< Control request made by a \ref BENCH_STEP_ControlRequest step. */
+			const void*        Data; /**< Data sent to the device, or expected back from it, or \c NULL if not checked. */
+			uint16_t           Length; /**< Length of the expected data stage, in bytes. */
+		} Bench_Step_t;
+
+	/* Function Prototypes: */
+		void EVENT_USB_Device_Reset(void);
+		void EVENT_USB_Device_ConfigurationChanged(void);
+		void EVENT_USB_Device_ControlRequest(void);
+
+		#if defined(__INCLUDE_FROM_ENUMERATION_BENCH_C)
+			static bool Bench_Enumerate(void);
+			static bool Bench_RunStep(const Bench_Step_t* const Step);
+			static void Bench_PrintProfile(void);
+		#endif
+
+#endif
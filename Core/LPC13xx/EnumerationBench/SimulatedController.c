@@ -0,0 +1,638 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Simulated LPC134x USB controller and USB host, against which the unmodified device mode driver is run on the host
+ *  computer. The driver's register accesses are routed here by the host register header; the controller's SIE
+ *  commands, endpoint buffers and device interrupt status are modelled closely enough for the driver to enumerate,
+ *  while the simulated host makes control transfers through the endpoint buffers as a real host would on the bus.
+ *
+ *  Bus activity is simulated whenever the device could observe it: when the device polls the interrupt status
+ *  outside of an SIE command, when it unmasks the USB interrupt, and on each pass of the device's main loop. The USB
+ *  interrupt handler is run in turn whenever an enabled interrupt is pending and the interrupt is unmasked, so that
+ *  the driver's interrupt locking is exercised as it would be on the target.
+ */
+
+#define  __INCLUDE_FROM_SIMULATED_CONTROLLER_C
+#include "SimulatedController.h"
+#include "../reg.h"
+
+/* Device side entry points run by the simulation, the USB interrupt vector and the device's main loop task */
+void USB_IRQHandler(void);
+void USB_USBTask(void);
+
+/* Code of an SIE command, and the phase mask of each of the three types of command code register write */
+#define HOST_COMMAND_CODE(Command)  (((Command) >> 16) & 0xFF)
+#define HOST_COMMAND_PHASE(Command) ((Command) & 0xFF00)
+#define HOST_PHASE_COMMAND          HOST_COMMAND_PHASE(CMD_SET_ADDR)
+#define HOST_PHASE_WRITE            HOST_COMMAND_PHASE(DAT_WR_BYTE(0))
+#define HOST_PHASE_READ             HOST_COMMAND_PHASE(DAT_RD_FRAME)
+
+/** Registers of the simulated controller, which are accessed directly rather than through the simulation. */
+volatile uint32_t USB_CTRL;
+volatile uint32_t USB_DEVINTEN;
+volatile uint32_t USB_TXPLEN;
+
+/** System control and pin function registers of the simulation; the USB PLL is always reported as locked. */
+volatile uint32_t SCB_SYSAHBCLKCTRL;
+volatile uint32_t SCB_PDRUNCFG = (SCB_PDSLEEPCFG_USBPAD_PD | SCB_PDSLEEPCFG_USBPLL_PD);
+volatile uint32_t SCB_USBPLLCLKSEL;
+volatile uint32_t SCB_USBPLLCLKUEN;
+volatile uint32_t SCB_USBPLLCTRL;
+volatile uint32_t SCB_USBPLLSTAT = SCB_USBPLLSTAT_LOCK;
+volatile uint32_t SCB_USBCLKSEL;
+volatile uint32_t IOCON_PIO0_1;
+volatile uint32_t IOCON_PIO0_3;
+volatile uint32_t IOCON_PIO0_6;
+
+/** State of the simulated controller. */
+static Host_Controller_t Controller;
+
+/** Control transfer being made by the simulated host. */
+static Host_Transfer_t Transfer;
+
+/** Maximum packet size of the device's control endpoint, as known to the simulated host. */
+static uint8_t ControlEndpointSize = 8;
+
+
+volatile uint32_t* Host_WriteRegister(const uint8_t Register)
+{
+	/* The value of any earlier write has now been stored, so it can be acted on before this one */
+	Host_FlushWrite();
+
+	Controller.WritePending      = true;
+	Controller.WriteRegister     = Register;
+	Controller.WriteValue        = 0;
+	Controller.WriteControl      = USB_CTRL;
+	Controller.WritePacketLength = USB_TXPLEN;
+
+	return (volatile uint32_t*)&Controller.WriteValue;
+}
+
+uint32_t Host_ReadRegister(const uint8_t Register)
+{
+	Host_EndpointBuffer_t* Buffer = &Controller.Endpoints[((USB_CTRL >> 2) & 0x0F) * 2];
+	uint32_t Value = 0;
+
+	Host_FlushWrite();
+
+	switch (Register)
+	{
+		case HOST_REGISTER_DEVINTST:
+			/* Status reads outside of an SIE command are the device waiting on the bus */
+			if (!(Controller.CommandIssued))
+			  Host_RunBus();
+
+			Controller.CommandIssued = false;
+			return Controller.PendingInterrupts;
+		case HOST_REGISTER_CMDDATA:
+			return Host_ReadCommandData();
+		case HOST_REGISTER_RXPLEN:
+			Buffer->DataIndex = 0;
+
+			if (!(USB_CTRL & CTRL_RD_EN) || !(Buffer->Full))
+			  return 0;
+
+			return (PKT_DV | Buffer->Length);
+		case HOST_REGISTER_RXDATA:
+			if ((Buffer->DataIndex + sizeof(uint32_t)) <= sizeof(Buffer->Data))
+			  memcpy(&Value, &Buffer->Data[Buffer->DataIndex], sizeof(uint32_t));
+
+			Buffer->DataIndex += sizeof(uint32_t);
+			return Value;
+	}
+
+	return 0;
+}
+
+uint32_t Host_ReadTicks(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return (uint32_t)(((uint64_t)Now.tv_sec * 1000000000ULL) + Now.tv_nsec);
+}
+
+void NVIC_EnableIRQ(const IRQn_Type IRQn)
+{
+	Host_FlushWrite();
+
+	Controller.IRQEnabled = true;
+
+	Host_RunBus();
+	Host_DeliverInterrupts();
+}
+
+void NVIC_DisableIRQ(const IRQn_Type IRQn)
+{
+	Host_FlushWrite();
+
+	Controller.IRQEnabled = false;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+	return Controller.PriMask;
+}
+
+void __set_PRIMASK(const uint32_t PriMask)
+{
+	Host_FlushWrite();
+
+	Controller.PriMask = (PriMask & 0x01);
+
+	if (!(Controller.PriMask))
+	{
+		Host_RunBus();
+		Host_DeliverInterrupts();
+	}
+}
+
+void __enable_irq(void)
+{
+	__set_PRIMASK(0);
+}
+
+void __disable_irq(void)
+{
+	__set_PRIMASK(1);
+}
+
+/** Resets the simulated controller and host to their power-on state, with the device disconnected. */
+void Host_ResetController(void)
+{
+	memset(&Controller, 0x00, sizeof(Controller));
+	memset(&Transfer, 0x00, sizeof(Transfer));
+}
+
+/** Sets the maximum packet size of the device's control endpoint, which the simulated host uses to find the end of
+ *  the data stage of IN control transfers.
+ *
+ *  \param[in] Size  Maximum packet size of the control endpoint, in bytes.
+ */
+void Host_SetControlEndpointSize(const uint8_t Size)
+{
+	ControlEndpointSize = Size;
+}
+
+/** Applies VBUS to the device, which reports a connect change to the device through its device status interrupt. */
+void Host_ConnectVBUS(void)
+{
+	Controller.StatusChanges     |= DEV_CON_CH;
+	Controller.PendingInterrupts |= DEV_STAT_INT;
+
+	Host_ServiceDevice();
+}
+
+/** Signals a bus reset to the device, clearing its address, configuration and endpoint buffers, and gives the device a
+ *  pass of its main loop to handle the reset.
+ */
+void Host_BusReset(void)
+{
+	memset(Controller.Endpoints, 0x00, sizeof(Controller.Endpoints));
+
+	Controller.Address            = 0;
+	Controller.Configured         = false;
+	Controller.StatusChanges     |= DEV_RST;
+	Controller.PendingInterrupts |= DEV_STAT_INT;
+
+	Transfer.Stage = HOST_STAGE_Idle;
+
+	Host_ServiceDevice();
+}
+
+/** Makes a control transfer to the device, running the device's main loop until the transfer's status stage has
+ *  completed or the device has stalled the request.
+ *
+ *  \param[in]     Request            SETUP packet of the transfer.
+ *  \param[in,out] Data               Data stage buffer, of at least \c wLength bytes.
+ *  \param[out]    TransferredLength  Number of data stage bytes sent or received.
+ *
+ *  \return A value from the \ref Host_TransferResults_t enum.
+ */
+uint8_t Host_ControlTransfer(const Host_SetupPacket_t* const Request,
+                             void* const Data,
+                             uint16_t* const TransferredLength)
+{
+	Host_EndpointBuffer_t* OUTBuffer = &Controller.Endpoints[0];
+	Host_EndpointBuffer_t* INBuffer  = &Controller.Endpoints[1];
+
+	Transfer.Request     = *Request;
+	Transfer.Data        = Data;
+	Transfer.Transferred = 0;
+	Transfer.Babble      = false;
+
+	if (!(Request->wLength))
+	  Transfer.Stage = HOST_STAGE_StatusIN;
+	else if (Request->bmRequestType & 0x80)
+	  Transfer.Stage = HOST_STAGE_DataIN;
+	else
+	  Transfer.Stage = HOST_STAGE_DataOUT;
+
+	/* A SETUP packet is always accepted, replacing any packet held, and ends any stall of the control endpoint */
+	memcpy(OUTBuffer->Data, Request, sizeof(Host_SetupPacket_t));
+	OUTBuffer->Full    = true;
+	OUTBuffer->Setup   = true;
+	OUTBuffer->Stalled = false;
+	OUTBuffer->Length  = sizeof(Host_SetupPacket_t);
+	INBuffer->Full     = false;
+	INBuffer->Stalled  = false;
+
+	Controller.PendingInterrupts |= EP0_INT;
+
+	for (uint16_t Pass = 0; (Transfer.Stage != HOST_STAGE_Complete) && (Transfer.Stage != HOST_STAGE_Stalled); Pass++)
+	{
+		if ((Pass == HOST_MAX_SERVICE_PASSES) || Controller.InterruptStuck)
+		{
+			Transfer.Stage = HOST_STAGE_Idle;
+			return HOST_TRANSFER_Timeout;
+		}
+
+		Host_ServiceDevice();
+	}
+
+	/* The device is given a further pass of its main loop, to take the interrupts of the transfer's final packet */
+	Host_ServiceDevice();
+
+	*TransferredLength = Transfer.Transferred;
+
+	if (Transfer.Stage == HOST_STAGE_Stalled)
+	  return HOST_TRANSFER_Stalled;
+	else if (Transfer.Babble)
+	  return HOST_TRANSFER_Babble;
+
+	return HOST_TRANSFER_Complete;
+}
+
+/** Retrieves the device address most recently set by the device through the SIE.
+ *
+ *  \return Device address of the simulated controller.
+ */
+uint8_t Host_GetDeviceAddress(void)
+{
+	return Controller.Address;
+}
+
+/** Determines if the device has set its configured state through the SIE.
+ *
+ *  \return Boolean \c true if the device is configured, \c false otherwise.
+ */
+bool Host_IsDeviceConfigured(void)
+{
+	return Controller.Configured;
+}
+
+/** Determines if the USB interrupt has been found to be stuck asserted, with an enabled interrupt source which the
+ *  interrupt handler does not clear.
+ *
+ *  \return Boolean \c true if the USB interrupt is stuck, \c false otherwise.
+ */
+bool Host_IsInterruptStuck(void)
+{
+	return Controller.InterruptStuck;
+}
+
+/** Retrieves the total number of SIE command, data and read phases issued by the device.
+ *
+ *  \return Total number of SIE command code register writes.
+ */
+uint32_t Host_GetSIECommands(void)
+{
+	return Controller.SIECommands;
+}
+
+/** Retrieves the total number of entries into the USB interrupt handler.
+ *
+ *  \return Total number of USB interrupts taken.
+ */
+uint32_t Host_GetInterrupts(void)
+{
+	return Controller.Interrupts;
+}
+
+/** Acts on the pending register write, once the device has stored its value. */
+static void Host_FlushWrite(void)
+{
+	if (!(Controller.WritePending))
+	  return;
+
+	Controller.WritePending = false;
+
+	switch (Controller.WriteRegister)
+	{
+		case HOST_REGISTER_CMDCODE:
+			Host_ProcessCommand(Controller.WriteValue);
+			break;
+		case HOST_REGISTER_DEVINTCLR:
+			Controller.PendingInterrupts &= ~(Controller.WriteValue);
+			break;
+		case HOST_REGISTER_TXDATA:
+			Host_LoadTXData();
+			break;
+	}
+}
+
+/** Acts on a write of the SIE command code register.
+ *
+ *  \param[in] Command  Value written to the command code register.
+ */
+static void Host_ProcessCommand(const uint32_t Command)
+{
+	uint8_t Code = HOST_COMMAND_CODE(Command);
+
+	Controller.SIECommands++;
+
+	switch (HOST_COMMAND_PHASE(Command))
+	{
+		case HOST_PHASE_COMMAND:
+			Controller.CommandCode   = Code;
+			Controller.DataReadIndex = 0;
+
+			if ((Code & 0xBF) < HOST_PHYSICAL_ENDPOINTS)
+			{
+				/* Select Endpoint, and Select Endpoint/Clear Interrupt or Set Endpoint Status */
+				Controller.SelectedEndpoint = (Code & 0x0F);
+			}
+			else if (Code == HOST_COMMAND_CODE(CMD_CLR_BUF))
+			{
+				Host_EndpointBuffer_t* Buffer = &Controller.Endpoints[Controller.SelectedEndpoint];
+
+				Buffer->Full  = false;
+				Buffer->Setup = false;
+			}
+			else if (Code == HOST_COMMAND_CODE(CMD_VALID_BUF))
+			{
+				Host_EndpointBuffer_t* Buffer = &Controller.Endpoints[Controller.SelectedEndpoint];
+
+				Buffer->Full    = true;
+				Buffer->Loading = false;
+			}
+
+			break;
+		case HOST_PHASE_WRITE:
+			Host_ProcessCommandData(Code);
+			break;
+		case HOST_PHASE_READ:
+			Controller.CommandCode = Code;
+			break;
+	}
+
+	Controller.PendingInterrupts |= (CCEMTY_INT | CDFULL_INT);
+	Controller.CommandIssued      = true;
+}
+
+/** Acts on the data phase of the current SIE command.
+ *
+ *  \param[in] Data  Data byte written to the SIE.
+ */
+static void Host_ProcessCommandData(const uint8_t Data)
+{
+	uint8_t Code = Controller.CommandCode;
+
+	if (Code == HOST_COMMAND_CODE(CMD_SET_ADDR))
+	{
+		Controller.Address = (Data & DEV_ADDR_MASK);
+	}
+	else if (Code == HOST_COMMAND_CODE(CMD_CFG_DEV))
+	{
+		Controller.Configured = (Data & CONF_DVICE);
+	}
+	else if (Code == HOST_COMMAND_CODE(CMD_SET_DEV_STAT))
+	{
+		Controller.Connected = (Data & DEV_CON);
+	}
+	else if ((Code & 0xF0) == HOST_COMMAND_CODE(CMD_SET_EP_STAT(0)))
+	{
+		uint8_t PhysicalEndpoint = (Code & 0x0F);
+
+		if (PhysicalEndpoint >= HOST_PHYSICAL_ENDPOINTS)
+		  return;
+
+		Controller.Endpoints[PhysicalEndpoint].Stalled = (Data & EP_STAT_ST);
+
+		/* A stall of either direction of the control endpoint ends the host's transfer */
+		if ((PhysicalEndpoint < 2) && (Data & EP_STAT_ST) &&
+		    (Transfer.Stage != HOST_STAGE_Idle) && (Transfer.Stage != HOST_STAGE_Complete))
+		{
+			Transfer.Stage = HOST_STAGE_Stalled;
+		}
+	}
+}
+
+/** Returns the next data byte of the current SIE command, for a read of the command data register.
+ *
+ *  \return Command data byte.
+ */
+static uint8_t Host_ReadCommandData(void)
+{
+	uint8_t Code = Controller.CommandCode;
+
+	if (Code == HOST_COMMAND_CODE(CMD_GET_DEV_STAT))
+	{
+		uint8_t Status = (Controller.StatusChanges | (Controller.Connected ? DEV_CON : 0));
+
+		/* The change bits are cleared by reading the device status */
+		Controller.StatusChanges = 0;
+		return Status;
+	}
+	else if (Code == HOST_COMMAND_CODE(CMD_RD_FRAME))
+	{
+		return (Controller.DataReadIndex++ ? (Controller.FrameNumber >> 8) : (Controller.FrameNumber & 0xFF));
+	}
+	else if ((Code & 0xBF) < HOST_PHYSICAL_ENDPOINTS)
+	{
+		Host_EndpointBuffer_t* Buffer = &Controller.Endpoints[Code & 0x0F];
+
+		return ((Buffer->Full ? EP_SEL_F : 0) | (Buffer->Setup ? EP_SEL_STP : 0) | (Buffer->Stalled ? EP_SEL_ST : 0));
+	}
+
+	return 0;
+}
+
+/** Stores a word written to the transmit data register into the IN endpoint buffer selected through \c USB_CTRL,
+ *  starting a new packet of the length set in \c USB_TXPLEN if none is being loaded.
+ */
+static void Host_LoadTXData(void)
+{
+	Host_EndpointBuffer_t* Buffer = &Controller.Endpoints[(((Controller.WriteControl >> 2) & 0x0F) * 2) + 1];
+
+	if (!(Controller.WriteControl & CTRL_WR_EN))
+	  return;
+
+	if (!(Buffer->Loading))
+	{
+		Buffer->Loading   = true;
+		Buffer->Full      = false;
+		Buffer->Length    = (Controller.WritePacketLength & PKT_LNGTH_MASK);
+		Buffer->DataIndex = 0;
+	}
+
+	if ((Buffer->DataIndex + sizeof(uint32_t)) <= sizeof(Buffer->Data))
+	  memcpy(&Buffer->Data[Buffer->DataIndex], &Controller.WriteValue, sizeof(uint32_t));
+
+	Buffer->DataIndex += sizeof(uint32_t);
+
+	if (Buffer->DataIndex >= Buffer->Length)
+	  Buffer->Loading = false;
+}
+
+/** Makes the next transaction of the host's control transfer, if the device is ready for it.
+ *
+ *  \return Boolean \c true if a transaction was made, \c false if the host is waiting on the device.
+ */
+static bool Host_RunTransaction(void)
+{
+	Host_EndpointBuffer_t* OUTBuffer = &Controller.Endpoints[0];
+	Host_EndpointBuffer_t* INBuffer  = &Controller.Endpoints[1];
+	uint16_t Remaining = (Transfer.Request.wLength - Transfer.Transferred);
+	uint16_t PacketLength;
+
+	switch (Transfer.Stage)
+	{
+		case HOST_STAGE_DataIN:
+			if (!(INBuffer->Full) || INBuffer->Loading)
+			  return false;
+
+			PacketLength = INBuffer->Length;
+
+			if (PacketLength > Remaining)
+			{
+				Transfer.Babble = true;
+				PacketLength    = Remaining;
+			}
+
+			memcpy(&Transfer.Data[Transfer.Transferred], INBuffer->Data, PacketLength);
+			Transfer.Transferred += PacketLength;
+
+			/* The data stage ends on a short packet, or once all of the requested data has been received */
+			if ((INBuffer->Length < ControlEndpointSize) || (Transfer.Transferred == Transfer.Request.wLength))
+			  Transfer.Stage = HOST_STAGE_StatusOUT;
+
+			INBuffer->Full = false;
+			Controller.PendingInterrupts |= EP1_INT;
+			return true;
+		case HOST_STAGE_DataOUT:
+			if (OUTBuffer->Full)
+			  return false;
+
+			PacketLength = ((Remaining < ControlEndpointSize) ? Remaining : ControlEndpointSize);
+
+			memcpy(OUTBuffer->Data, &Transfer.Data[Transfer.Transferred], PacketLength);
+			OUTBuffer->Full   = true;
+			OUTBuffer->Setup  = false;
+			OUTBuffer->Length = PacketLength;
+			Transfer.Transferred += PacketLength;
+
+			if (Transfer.Transferred == Transfer.Request.wLength)
+			  Transfer.Stage = HOST_STAGE_StatusIN;
+
+			Controller.PendingInterrupts |= EP0_INT;
+			return true;
+		case HOST_STAGE_StatusIN:
+			if (!(INBuffer->Full) || INBuffer->Loading)
+			  return false;
+
+			if (INBuffer->Length)
+			  Transfer.Babble = true;
+
+			Transfer.Stage = HOST_STAGE_Complete;
+
+			INBuffer->Full = false;
+			Controller.PendingInterrupts |= EP1_INT;
+			return true;
+		case HOST_STAGE_StatusOUT:
+			if (OUTBuffer->Full)
+			  return false;
+
+			/* The status stage completes as soon as the device's controller accepts the zero length packet */
+			OUTBuffer->Full   = true;
+			OUTBuffer->Setup  = false;
+			OUTBuffer->Length = 0;
+
+			Transfer.Stage = HOST_STAGE_Complete;
+
+			Controller.PendingInterrupts |= EP0_INT;
+			return true;
+	}
+
+	return false;
+}
+
+/** Simulates bus activity, making each transaction of the host's control transfer the device is ready for. */
+static void Host_RunBus(void)
+{
+	if (!(Controller.Connected))
+	  return;
+
+	while (Host_RunTransaction());
+}
+
+/** Runs the USB interrupt handler for as long as an enabled interrupt is pending and the interrupt is unmasked. The
+ *  handler is never re-entered, as on the target an interrupt cannot pre-empt itself.
+ */
+static void Host_DeliverInterrupts(void)
+{
+	uint8_t ChainedInterrupts = 0;
+
+	if (Controller.InInterrupt)
+	  return;
+
+	Controller.InInterrupt = true;
+
+	while (Controller.IRQEnabled && !(Controller.PriMask) && (Controller.PendingInterrupts & USB_DEVINTEN))
+	{
+		if (ChainedInterrupts++ == HOST_MAX_INTERRUPT_CHAIN)
+		{
+			Controller.InterruptStuck = true;
+			break;
+		}
+
+		Controller.Interrupts++;
+		USB_IRQHandler();
+	}
+
+	Controller.InInterrupt = false;
+}
+
+/** Runs one pass of the device: the bus advances by one frame, any pending USB interrupt is taken and the device's
+ *  main loop task is run.
+ */
+static void Host_ServiceDevice(void)
+{
+	Host_FlushWrite();
+
+	Controller.FrameNumber = ((Controller.FrameNumber + 1) & 0x07FF);
+
+	Host_RunBus();
+	Host_DeliverInterrupts();
+
+	USB_USBTask();
+}
@@ -0,0 +1,175 @@
+/*
+             LUFA Library
+     Copyright (C) Dean Camera, 2011.
+
+  dean [at] fourwalledcubicle [dot] com
+           www.lufa-lib.org
+*/
+
+/*
+  Copyright 2011  Dean Camera (dean [at] fourwalledcubicle [dot] com)
+
+  Permission to use, copy, modify, distribute, and sell this
+  software and its documentation for any purpose is hereby granted
+  without fee, provided that the above copyright notice appear in
+  all copies and that both that the copyright notice and this
+  permission notice and warranty disclaimer appear in supporting
+  documentation, and that the name of the author not be used in
+  advertising or publicity pertaining to distribution of the
+  software without specific, written prior permission.
+
+  The author disclaim all warranties with regard to this
+  software, including all implied warranties of merchantability
+  and fitness.  In no event shall the author be liable for any
+  special, indirect or consequential damages or any damages
+  whatsoever resulting from loss of use, data or profits, whether
+  in an action of contract, negligence or other tortious action,
+  arising out of or in connection with the use or performance of
+  this software.
+*/
+
+/** \file
+ *
+ *  Header file for SimulatedController.c.
+ */
+
+#ifndef _SIMULATED_CONTROLLER_H_
+#define _SIMULATED_CONTROLLER_H_
+
+	/* Includes: */
+		#include <stdint.h>
+		#include <stdbool.h>
+		#include <string.h>
+		#include <time.h>
+
+		#include "lpc134x.h"
+
+	/* Macros: */
+		/** Number of physical endpoints of the simulated controller, an OUT and an IN endpoint for each logical endpoint. */
+		#define HOST_PHYSICAL_ENDPOINTS    10
+
+		/** Largest packet held by each simulated endpoint buffer, in bytes. */
+		#define HOST_MAX_PACKET_SIZE       64
+
+		/** Number of passes of the device's main loop a control transfer may take before the transfer is failed. */
+		#define HOST_MAX_SERVICE_PASSES    1000
+
+		/** Number of times the USB interrupt may be entered back to back before the simulation fails the device, as an
+		 *  interrupt source the handler never clears would otherwise hang the bench.
+		 */
+		#define HOST_MAX_INTERRUPT_CHAIN   64
+
+	/* Enums: */
+		/** Enum for the stages of the control transfer being made by the simulated host. */
+		enum Host_TransferStages_t
+		{
+			HOST_STAGE_Idle      = 0, /**< No control transfer is in progress. */
+			HOST_STAGE_DataIN    = 1, /**< Waiting for the device to send the next IN packet of the data stage. */
+			HOST_STAGE_DataOUT   = 2, /**< Waiting for the device to free its OUT buffer for the next packet of the data stage. */
+			HOST_STAGE_StatusIN  = 3, /**< Waiting for the device to send the zero length status packet. */
+			HOST_STAGE_StatusOUT = 4, /**< Waiting for the device to free its OUT buffer for the zero length status packet. */
+			HOST_STAGE_Complete  = 5, /**< The transfer completed. */
+			HOST_STAGE_Stalled   = 6, /**< The device stalled the control endpoint. */
+		};
+
+		/** Enum for the possible results of \ref Host_ControlTransfer(). */
+		enum Host_TransferResults_t
+		{
+			HOST_TRANSFER_Complete = 0, /**< The transfer completed. */
+			HOST_TRANSFER_Stalled  = 1, /**< The device stalled the request. */
+			HOST_TRANSFER_Timeout  = 2, /**< The transfer did not complete within \ref HOST_MAX_SERVICE_PASSES passes. */
+			HOST_TRANSFER_Babble   = 3, /**< The device sent more data than requested, or a non-empty status packet. */
+		};
+
+	/* Type Defines: */
+		/** Type define for a control request SETUP packet sent by the simulated host. */
+		typedef struct
+		{
+			uint8_t  bmRequestType; /**< Type of the request. */
+			uint8_t  bRequest; /**< Request command code. */
+			uint16_t wValue; /**< Request value parameter. */
+			uint16_t wIndex; /**< Request index parameter. */
+			uint16_t wLength; /**< Length of the data stage, in bytes. */
+		} Host_SetupPacket_t;
+
+		/** Type define for the packet buffer of one physical endpoint of the simulated controller. */
+		typedef struct
+		{
+			bool     Full; /**< Indicates if the buffer holds a packet, received from the host or validated by the device. */
+			bool     Setup; /**< Indicates if the held packet is a SETUP packet. */
+			bool     Stalled; /**< Indicates if the device has stalled the endpoint. */
+			bool     Loading; /**< Indicates if the device is part way through writing a packet into the buffer. */
+			uint16_t Length; /**< Length of the held packet, in bytes. */
+			uint16_t DataIndex; /**< Offset of the next word read or written through the data port. */
+			uint8_t  Data[HOST_MAX_PACKET_SIZE]; /**< Packet data. */
+		} Host_EndpointBuffer_t;
+
+		/** Type define for the state of the simulated controller. */
+		typedef struct
+		{
+			bool     WritePending; /**< Indicates if a register write is waiting to be acted on. */
+			uint8_t  WriteRegister; /**< Register of the pending write, a value from the \ref Host_Registers_t enum. */
+			uint32_t WriteValue; /**< Value of the pending write. */
+			uint32_t WriteControl; /**< Value of \c USB_CTRL at the time of the pending write. */
+			uint32_t WritePacketLength; /**< Value of \c USB_TXPLEN at the time of the pending write. */
+
+			uint32_t PendingInterrupts; /**< Device interrupt status register. */
+			bool     CommandIssued; /**< Indicates if an SIE command has been issued since the interrupt status was last read. */
+			uint8_t  CommandCode; /**< Code of the current SIE command. */
+			uint8_t  DataReadIndex; /**< Index of the next byte returned by a multi-byte SIE command. */
+			uint8_t  SelectedEndpoint; /**< Physical endpoint selected by the last endpoint SIE command. */
+
+			bool     Connected; /**< Indicates if the device has connected its pull-up to the bus. */
+			uint8_t  StatusChanges; /**< Device status change bits not yet read by the device. */
+			uint8_t  Address; /**< Device address set by the device. */
+			bool     Configured; /**< Indicates if the device has set its configured state. */
+			uint16_t FrameNumber; /**< Current bus frame number. */
+
+			bool     IRQEnabled; /**< Indicates if the USB interrupt is enabled in the interrupt controller. */
+			uint32_t PriMask; /**< Core interrupt mask, set when all interrupts are masked. */
+			bool     InInterrupt; /**< Indicates if the USB interrupt handler is running. */
+			bool     InterruptStuck; /**< Indicates if the USB interrupt was found to be stuck asserted. */
+
+			uint32_t SIECommands; /**< Total SIE command, data and read phases issued by the device. */
+			uint32_t Interrupts; /**< Total entries into the USB interrupt handler. */
+
+			Host_EndpointBuffer_t Endpoints[HOST_PHYSICAL_ENDPOINTS]; /**< Physical endpoint buffers. */
+		} Host_Controller_t;
+
+		/** Type define for the control transfer being made by the simulated host. */
+		typedef struct
+		{
+			Host_SetupPacket_t Request; /**< SETUP packet of the transfer. */
+			uint8_t*           Data; /**< Data stage buffer, \ref Host_SetupPacket_t::wLength bytes long. */
+			uint16_t           Transferred; /**< Number of data stage bytes sent or received so far. */
+			uint8_t            Stage; /**< Current stage, a value from the \ref Host_TransferStages_t enum. */
+			bool               Babble; /**< Indicates if the device sent more data than was requested. */
+		} Host_Transfer_t;
+
+	/* Function Prototypes: */
+		void     Host_ResetController(void);
+		void     Host_SetControlEndpointSize(const uint8_t Size);
+		void     Host_ConnectVBUS(void);
+		void     Host_BusReset(void);
+		uint8_t  Host_ControlTransfer(const Host_SetupPacket_t* const Request,
+		                              void* const Data,
+		                              uint16_t* const TransferredLength);
+		uint8_t  Host_GetDeviceAddress(void);
+		bool     Host_IsDeviceConfigured(void);
+		bool     Host_IsInterruptStuck(void);
+		uint32_t Host_GetSIECommands(void);
+		uint32_t Host_GetInterrupts(void);
+
+		#if defined(__INCLUDE_FROM_SIMULATED_CONTROLLER_C)
+			static void Host_FlushWrite(void);
+			static void Host_ProcessCommand(const uint32_t Command);
+			static void Host_ProcessCommandData(const uint8_t Data);
+			static uint8_t Host_ReadCommandData(void);
+			static void Host_LoadTXData(void);
+			static bool Host_RunTransaction(void);
+			static void Host_RunBus(void);
+			static void Host_DeliverInterrupts(void);
+			static void Host_ServiceDevice(void);
+		#endif
+
+#endif
@@ -37,6 +37,10 @@ void USB_Init()
 {
 	USB_IsInitialized = true;
 
+	#if defined(USB_CAN_BE_DEVICE) && !defined(NO_INTERNAL_SERIAL)
+	USB_Device_LoadInternalSerial();
+	#endif
+
 	USB_ResetInterface();
 }
 
@@ -93,9 +97,20 @@ void USB_ResetInterface(void)
 #if defined(USB_CAN_BE_DEVICE)
 static void USB_Init_Device(void)
 {
+	#if defined(USB_DEVICE_PROFILE)
+	USB_DEVICE_PROFILE_INIT();
+	#endif
+
+	USB_DEVICE_PROFILE_DECLARE();
+	USB_DEVICE_PROFILE_START();
+
 	USB_DeviceState          = DEVICE_STATE_Unattached;
 	USB_ConfigurationNumber  = 0;
 
+	#if !defined(NO_DEVICE_REMOTE_WAKEUP) || defined(USB_SUSPEND_POWER_MANAGER)
+	USB_DEVICE_TICKS_INIT();
+	#endif
+
 	#if !defined(NO_DEVICE_REMOTE_WAKEUP)
 	USB_RemoteWakeupEnabled  = false;
 	#endif
@@ -107,7 +122,11 @@ static void USB_Init_Device(void)
 	#if !defined(FIXED_CONTROL_ENDPOINT_SIZE)
 	USB_Descriptor_Device_t* DeviceDescriptorPtr;
 
+	#if defined(USE_DESCRIPTOR_TABLE)
+	if (USB_Device_FindDescriptor((DTYPE_Device << 8), 0, (void*)&DeviceDescriptorPtr) != NO_DESCRIPTOR)
+	#else
 	if (CALLBACK_USB_GetDescriptor((DTYPE_Device << 8), 0, (void*)&DeviceDescriptorPtr) != NO_DESCRIPTOR)
+	#endif
 	  USB_ControlEndpointSize = DeviceDescriptorPtr->Endpoint0Size;
 	#endif
 	
@@ -119,6 +138,8 @@ static void USB_Init_Device(void)
 	
 	USB_DEVINTCLR = 0x000FFFFF;
 	USB_DEVINTEN  = DEV_STAT_INT | (0xFF<<1);
+
+	USB_DEVICE_PROFILE_STOP(USB_DEVICE_PROFILE_InitDevice);
 }
 #endif
 
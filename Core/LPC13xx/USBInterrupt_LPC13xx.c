@@ -42,19 +42,59 @@ void USB_INT_ClearAllInterrupts(void)
 	
 }
 
-void USB_IRQHandler (void)
+#if defined(INTERRUPT_CONTROL_ENDPOINT)
+static void USB_Device_ControlEndpointInterrupt(void)
 {
-  uint32_t status_reg, val, n, m;
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
 
-  status_reg = USB_DEVINTST;
-  USB_DEVINTCLR = status_reg;
+	Endpoint_SelectEndpoint(ENDPOINT_CONTROLEP);
+
+	if (Endpoint_IsSETUPReceived())
+	{
+		/* A new SETUP packet aborts any control transfer still in progress */
+		Endpoint_ControlTransfer.Stage = ENDPOINT_CONTROLSTAGE_Idle;
+		Endpoint_flags[ENDPOINT_CONTROLEP].out = 0;
+		Endpoint_flags[ENDPOINT_CONTROLEP].in  = 0;
+
+		USB_Device_ProcessControlRequest();
+	}
+	else if (Endpoint_ControlTransfer.Stage == ENDPOINT_CONTROLSTAGE_DataIN)
+	{
+		if (Endpoint_IsINReady())
+		  Endpoint_ContinueControlWrite();
+	}
+	else if (Endpoint_ControlTransfer.Stage == ENDPOINT_CONTROLSTAGE_StatusOUT)
+	{
+		if (Endpoint_IsOUTReceived())
+		{
+			Endpoint_ClearOUT();
+			Endpoint_ControlTransfer.Stage = ENDPOINT_CONTROLSTAGE_Idle;
+		}
+	}
+
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
+}
+#endif
+
+void USB_Device_ProcessDeviceStatus(void)
+{
+    uint32_t val;
 
-  /* Device Status Interrupt (Reset, Connect change, Suspend/Resume) */
-  if (status_reg & DEV_STAT_INT) 
-  {
     WriteCommand(CMD_GET_DEV_STAT);
     val = ReadCommandData(DAT_GET_DEV_STAT);
     if (val & DEV_RST) {                    /* Reset */
+		#if defined(USB_DEVICE_PROFILE)
+		USB_Device_Profile.BusResetTicks = USB_DEVICE_PROFILE_TICKS();
+		#endif
+
+		#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+		USB_Device_DiscardWakeEvents();
+		#endif
+
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		Endpoint_ControlTransfer.Stage = ENDPOINT_CONTROLSTAGE_Idle;
+		#endif
+
 		USB_DEVINTCLR = 0x000FFFFF;
 		USB_DEVINTEN  = DEV_STAT_INT | (0xFF<<1);
 		EVENT_USB_Device_Reset();
@@ -73,6 +113,10 @@ void USB_IRQHandler (void)
     }
     if (val & DEV_SUS_CH) {                 /* Suspend/Resume */
       if (val & DEV_SUS) {                  /* Suspend */
+		#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+		USB_Device_SuspendTicks = USB_DEVICE_TICKS();
+		#endif
+
 		USB_DeviceState = DEVICE_STATE_Suspended;
 		EVENT_USB_Device_Suspend();
       } else {                              /* Resume */
@@ -82,11 +126,32 @@ void USB_IRQHandler (void)
 		  USB_DeviceState = DEVICE_STATE_Powered; //(USB_Device_IsAddressSet()) ? DEVICE_STATE_Configured : DEVICE_STATE_Powered;
 
 		EVENT_USB_Device_WakeUp();
+
+		#if !defined(NO_DEVICE_REMOTE_WAKEUP)
+		USB_Device_DeliverWakeEvents();
+		#endif
       }
     }
+}
+
+void USB_IRQHandler (void)
+{
+  uint32_t status_reg, val, n, m;
+
+  status_reg = USB_DEVINTST;
+  USB_DEVINTCLR = status_reg;
+
+  /* Device Status Interrupt (Reset, Connect change, Suspend/Resume) */
+  if (status_reg & DEV_STAT_INT) 
+  {
+    USB_Device_ProcessDeviceStatus();
     return;
   }
-  
+
+	/* Endpoint events below may select other endpoints; the main program never has a packet part way through the data
+	 * port while this runs, as the port holds off this interrupt, so only its endpoint selection needs to be restored
+	 */
+	uint8_t PrevSelectedEndpoint = Endpoint_GetCurrentEndpoint();
   
 	#if !defined(NO_SOF_EVENTS)
 	if (status_reg & FRAME_INT)
@@ -126,12 +191,22 @@ void USB_IRQHandler (void)
             }
           }
           Endpoint_flags[m].out = 1;
+
+          if (m)
+            EVENT_USB_Device_EndpointOUTReceived(m);
         } else {                            /* IN Endpoint */
           Endpoint_flags[m].in = 1;
         }
+
+#if defined(INTERRUPT_CONTROL_ENDPOINT)
+        if (m == ENDPOINT_CONTROLEP)
+          USB_Device_ControlEndpointInterrupt();
+#endif
       }
     }
   }
+
+	Endpoint_SelectEndpoint(PrevSelectedEndpoint);
 }
 
 
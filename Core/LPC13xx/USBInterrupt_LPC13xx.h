@@ -60,6 +60,9 @@
 			#include "../Events.h"
 			#include "../USBController.h"
 
+		/* Function Prototypes: */
+			void USB_Device_ProcessDeviceStatus(void);
+
 	#endif
 
 	/* Public Interface - May be used in end-application: */
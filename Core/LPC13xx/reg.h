@@ -118,6 +118,15 @@
 
 #define USB_EP_NUM          10
 
+/* Cortex-M3 System Control and Debug Register Definitions */
+#define CM3_SCR             (*(volatile uint32_t*)0xE000ED10UL)
+#define CM3_SCR_SLEEPDEEP   (1UL << 2)
+#define CM3_DEMCR           (*(volatile uint32_t*)0xE000EDFCUL)
+#define CM3_DEMCR_TRCENA    (1UL << 24)
+#define CM3_DWT_CTRL        (*(volatile uint32_t*)0xE0001000UL)
+#define CM3_DWT_CTRL_CYCCNTENA (1UL << 0)
+#define CM3_DWT_CYCCNT      (*(volatile uint32_t*)0xE0001004UL)
+
 
 
 static inline uint32_t EndpointAddress (uint32_t EPNum) 
@@ -131,8 +140,15 @@ static inline uint32_t EndpointAddress (uint32_t EPNum)
   return (val);
 }
 
+#if defined(USB_DEVICE_PROFILE)
+extern volatile uint32_t USB_Device_SIECommands;
+#endif
+
 static inline void WriteCommand(uint32_t cmd) 
 {
+#if defined(USB_DEVICE_PROFILE)
+  USB_Device_SIECommands++;
+#endif
   USB_DEVINTCLR = CCEMTY_INT;
   USB_CMDCODE = cmd;
   while ((USB_DEVINTST & (CCEMTY_INT | DEV_STAT_INT)) == 0);
@@ -154,6 +170,9 @@ static inline void WriteEndpointCommand (uint32_t EPNum, uint32_t cmd)
 
 static inline uint32_t ReadCommandData (uint32_t cmd) 
 {
+#if defined(USB_DEVICE_PROFILE)
+  USB_Device_SIECommands++;
+#endif
   USB_DEVINTCLR = CCEMTY_INT | CDFULL_INT;
   USB_CMDCODE = cmd;
   while ((USB_DEVINTST & (CDFULL_INT | DEV_STAT_INT)) == 0);
@@ -8,6 +8,10 @@ uint8_t TEMPLATE_FUNC_NAME (void* const Buffer,
 
 	while (Length)
 	{
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		Endpoint_PollControlEndpoint();
+		#endif
+
 		uint8_t USB_DeviceState_LCL = USB_DeviceState;
 
 		if (USB_DeviceState_LCL == DEVICE_STATE_Unattached)
@@ -19,19 +23,32 @@ uint8_t TEMPLATE_FUNC_NAME (void* const Buffer,
 
 		if (Endpoint_IsOUTReceived())
 		{
-			while (Length && Endpoint_BytesInEndpoint())
+			/* Each packet is drained from the endpoint FIFO a word at a time, in a single prepare and commit pair */
+			uint32_t PacketBuffer[ENDPOINT_CONTROLEP_MAX_SIZE / sizeof(uint32_t)];
+			uint8_t* PacketData   = (uint8_t*)PacketBuffer;
+			uint16_t PacketLength = MIN(Endpoint_Read_buf((uint8_t*)PacketBuffer, sizeof(PacketBuffer)), sizeof(PacketBuffer));
+
+			Endpoint_ClearOUT();
+
+			if (PacketLength > Length)
+			  PacketLength = Length;
+
+			Length -= PacketLength;
+
+			while (PacketLength--)
 			{
-				TEMPLATE_TRANSFER_BYTE(DataStream);
+				TEMPLATE_TRANSFER_BYTE(DataStream, *(PacketData++));
 				TEMPLATE_BUFFER_MOVE(DataStream, 1);
-				Length--;
 			}
-
-			Endpoint_ClearOUT();
 		}
 	}
 
 	while (!(Endpoint_IsINReady()))
 	{
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		Endpoint_PollControlEndpoint();
+		#endif
+
 		uint8_t USB_DeviceState_LCL = USB_DeviceState;
 
 		if (USB_DeviceState_LCL == DEVICE_STATE_Unattached)
@@ -11,6 +11,10 @@ uint8_t TEMPLATE_FUNC_NAME (const void* const Buffer,
 
 	while (Length || LastPacketFull)
 	{
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		Endpoint_PollControlEndpoint();
+		#endif
+
 		uint8_t USB_DeviceState_LCL = USB_DeviceState;
 
 		if (USB_DeviceState_LCL == DEVICE_STATE_Unattached)
@@ -24,23 +28,37 @@ uint8_t TEMPLATE_FUNC_NAME (const void* const Buffer,
 
 		if (Endpoint_IsINReady())
 		{
-			uint16_t BytesInEndpoint = Endpoint_BytesInEndpoint();
+			uint16_t PacketLength = MIN(Length, USB_ControlEndpointSize);
+
+			/* Each packet is loaded into the endpoint FIFO a word at a time, in a single call */
+			#if defined(TEMPLATE_TRANSFER_PACKET)
+			TEMPLATE_TRANSFER_PACKET(DataStream, PacketLength);
+			TEMPLATE_BUFFER_MOVE(DataStream, PacketLength);
+			#else
+			uint32_t PacketBuffer[ENDPOINT_CONTROLEP_MAX_SIZE / sizeof(uint32_t)];
+			uint8_t* PacketData = (uint8_t*)PacketBuffer;
 
-			while (Length && (BytesInEndpoint < USB_ControlEndpointSize))
+			for (uint16_t BytesInPacket = 0; BytesInPacket < PacketLength; BytesInPacket++)
 			{
-				TEMPLATE_TRANSFER_BYTE(DataStream);
+				*(PacketData++) = TEMPLATE_TRANSFER_BYTE(DataStream);
 				TEMPLATE_BUFFER_MOVE(DataStream, 1);
-				Length--;
-				BytesInEndpoint++;
 			}
 
-			LastPacketFull = (BytesInEndpoint == USB_ControlEndpointSize);
+			Endpoint_write_buf((uint8_t*)PacketBuffer, PacketLength);
+			#endif
+
+			Length        -= PacketLength;
+			LastPacketFull = (PacketLength == USB_ControlEndpointSize);
 			Endpoint_ClearIN();
 		}
 	}
 
 	while (!(Endpoint_IsOUTReceived()))
 	{
+		#if defined(INTERRUPT_CONTROL_ENDPOINT)
+		Endpoint_PollControlEndpoint();
+		#endif
+
 		uint8_t USB_DeviceState_LCL = USB_DeviceState;
 
 		if (USB_DeviceState_LCL == DEVICE_STATE_Unattached)
@@ -56,3 +74,4 @@ uint8_t TEMPLATE_FUNC_NAME (const void* const Buffer,
 #undef TEMPLATE_BUFFER_MOVE
 #undef TEMPLATE_FUNC_NAME
 #undef TEMPLATE_TRANSFER_BYTE
+#undef TEMPLATE_TRANSFER_PACKET
@@ -62,6 +62,15 @@ void USB_USBTask(void)
 #if defined(USB_CAN_BE_DEVICE)
 static void USB_DeviceTask(void)
 {
+	#if defined(USB_SUSPEND_POWER_MANAGER)
+	if (USB_DeviceState == DEVICE_STATE_Suspended)
+	{
+		USB_Device_SuspendSleep();
+		return;
+	}
+	#endif
+
+	#if !defined(INTERRUPT_CONTROL_ENDPOINT)
 	if (USB_DeviceState != DEVICE_STATE_Unattached)
 	{
 		uint8_t PrevEndpoint = Endpoint_GetCurrentEndpoint();
@@ -73,6 +82,7 @@ static void USB_DeviceTask(void)
 
 		Endpoint_SelectEndpoint(PrevEndpoint);
 	}
+	#endif
 }
 #endif
 
@@ -167,7 +167,12 @@
 			 *      \ref EVENT_USB_Host_DeviceEnumerationFailed() events.
 			 *
 			 *  If in device mode (only), the control endpoint can instead be managed via interrupts entirely by the library
-			 *  by defining the INTERRUPT_CONTROL_ENDPOINT token and passing it to the compiler via the -D switch.
+			 *  by defining the INTERRUPT_CONTROL_ENDPOINT token and passing it to the compiler via the -D switch. SETUP
+			 *  packets are then dispatched from the USB interrupt, including to the \ref EVENT_USB_Device_ControlRequest()
+			 *  event and any class driver control request handlers linked to it, and multi-packet IN data stages and
+			 *  their status stages are advanced packet by packet from the control endpoint interrupt. Control stream
+			 *  transfers which must wait on the host from within the interrupt also service bus reset, disconnection and
+			 *  suspension events while waiting, and are aborted by them or by a new SETUP packet.
 			 *
 			 *  \see \ref Group_Events for more information on the USB events.
 
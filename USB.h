@@ -117,6 +117,11 @@
  *   <td bgcolor="#00EE00">Yes</td>
  *  </tr>
  *  <tr>
+ *   <td>NCM</td>
+ *   <td bgcolor="#00EE00">Yes</td>
+ *   <td bgcolor="#EE0000">No</td>
+ *  </tr>
+ *  <tr>
  *   <td>Printer</td>
  *   <td bgcolor="#EE0000">No</td>
 *    <td bgcolor="#00EE00">Yes</td>
@@ -395,6 +400,7 @@
 		#include "Class/HID.h"
 		#include "Class/MassStorage.h"
 		#include "Class/MIDI.h"
+		#include "Class/NCM.h"
 		#include "Class/Printer.h"
 		#include "Class/RNDIS.h"
 		#include "Class/StillImage.h"